@@ -99,10 +99,11 @@
     static bool toggle;
     toggle = !toggle;
 
+    int pair = BL_LED(id) | BL_LED(2+id%3);      // LED pair (one message)
     if (toggle)
-      return (bl_led(id,1), bl_led(2+id%3,0));    // flip LED pair
+      return bl_leds(pair,BL_LED(id));            // flip LED pair
     else
-      return (bl_led(id,0), bl_led(2+id%3,1));    // flip back LED pair
+      return bl_leds(pair,BL_LED(2+id%3));        // flip back LED pair
   }
 
 //==============================================================================
@@ -0,0 +1,226 @@
+//==============================================================================
+//  bl_bench.c
+//  microbenchmark harness (warmup, repeated sampling, min/median/p99)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include "bluccino.h"
+  #include "bl_bench.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO                     "bl_bench:"
+
+  #define LOG                     LOG_TEST
+  #define LOGO(lvl,col,o,val)     LOGO_TEST(lvl,col WHO,o,val)
+
+  static BL_bench *bench_list = NULL;  // registered cases
+  static BL_bench *bench_tail = NULL;  // last registered case
+
+//==============================================================================
+// register a benchmark case
+//==============================================================================
+
+  void bl_bench_add(BL_bench *b)
+  {
+    if (b->linked)
+      return;                          // already registered
+
+    b->next = NULL;
+    b->linked = true;
+    if (bench_tail)
+      bench_tail->next = b;
+    else
+      bench_list = b;
+    bench_tail = b;
+  }
+
+//==============================================================================
+// cycle counter frequency
+//==============================================================================
+
+  uint32_t bl_bench_hz(void)
+  {
+    static uint32_t hz = 0;
+    static bool known = false;
+
+    if (known)
+      return hz;
+    known = true;
+
+    #if (!CFG_BENCH_CYCLES)
+      hz = 1000000;                    // bl_us() based
+    #elif defined(__ZEPHYR__)
+      hz = sys_clock_hw_cycles_per_sec();
+    #elif defined(__aarch64__)
+      uint64_t frq;
+      __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(frq));
+      hz = (uint32_t)frq;
+    #elif defined(__x86_64__) || defined(__i386__)
+      BL_us t0 = bl_us(), dt = 0;      // calibrate TSC against bl_us()
+      uint32_t c0 = bl_bench_cyc(), dc = 0;
+      while (dt < CFG_BENCH_CALIB_MS*1000 && dc < 0x80000000u)
+      {
+        dt = bl_us() - t0;             // bounded: virtual time doesn't move
+        dc = bl_bench_cyc() - c0;
+      }
+      hz = dt ? (uint32_t)((uint64_t)dc * 1000000 / dt) : 0;
+    #else
+      hz = 1000000;                    // bl_us() based
+    #endif
+
+    return hz;
+  }
+
+//==============================================================================
+// helper: sort samples (insertion sort, samples are few and nearly sorted)
+//==============================================================================
+
+  static void bench_sort(uint32_t *a, int n)
+  {
+    for (int i=1; i < n; i++)
+    {
+      uint32_t x = a[i];
+      int j = i;
+      for (; j > 0 && a[j-1] > x; j--)
+        a[j] = a[j-1];
+      a[j] = x;
+    }
+  }
+
+//==============================================================================
+// measure a single case
+//==============================================================================
+
+  int bl_bench_case(BL_bench *b)
+  {
+    static uint32_t sample[CFG_BENCH_SAMPLES];
+    int n = CFG_BENCH_SAMPLES;
+
+    if (!b->run || b->loops <= 0)
+      return bl_err(-1,WHO" bad case");
+
+    bl_bench_hz();                     // calibrate outside of any sample
+
+    if (b->setup)
+      b->setup(b->ctx);
+
+    for (int i=0; i < CFG_BENCH_WARMUP; i++)
+      b->run(b->ctx,b->loops);         // warmup (discarded)
+
+    for (int i=0; i < n; i++)
+    {
+      uint32_t c0 = bl_bench_cyc();
+      b->run(b->ctx,b->loops);
+      sample[i] = bl_bench_cyc() - c0;
+    }
+
+    if (b->teardown)
+      b->teardown(b->ctx);
+
+    bench_sort(sample,n);
+    b->res.samples = n;
+    b->res.min = sample[0];
+    b->res.med = sample[n/2];
+    b->res.p99 = sample[(99*n + 99)/100 - 1];
+    b->res.max = sample[n-1];
+
+    LOG(3,"%s: %d samples of %d loops",b->name,n,b->loops);
+    return 0;
+  }
+
+//==============================================================================
+// helper: per loop value of a sample in 1/100 ns and 1/100 cycles
+//==============================================================================
+
+  static uint32_t bench_cns(BL_bench *b, uint32_t cyc)
+  {
+    uint32_t khz = bl_bench_hz() / 1000;
+    if (khz == 0)
+      return 0;
+    return (uint32_t)((uint64_t)cyc * 100000000 / ((uint64_t)khz * b->loops));
+  }
+
+  static uint32_t bench_ccyc(BL_bench *b, uint32_t cyc)
+  {
+    return (uint32_t)((uint64_t)cyc * 100 / b->loops);
+  }
+
+//==============================================================================
+// report result of a case
+//==============================================================================
+
+  void bl_bench_report(BL_bench *b, BL_benchfmt fmt)
+  {
+    BL_benchres *r = &b->res;
+    uint32_t ns[4] = { bench_cns(b,r->min), bench_cns(b,r->med),
+                       bench_cns(b,r->p99), bench_cns(b,r->max) };
+    uint32_t cy[4] = { bench_ccyc(b,r->min), bench_ccyc(b,r->med),
+                       bench_ccyc(b,r->p99), bench_ccyc(b,r->max) };
+
+    #define BL_X(v)  (unsigned)((v)/100), (unsigned)((v)%100)
+
+    switch (fmt)
+    {
+      case BL_BENCH_CSV:
+        bl_prt("%s,%d,%d,%u.%02u,%u.%02u,%u.%02u,%u.%02u,"
+               "%u.%02u,%u.%02u,%u.%02u,%u.%02u,%u\n",
+               b->name, b->loops, r->samples,
+               BL_X(ns[0]), BL_X(ns[1]), BL_X(ns[2]), BL_X(ns[3]),
+               BL_X(cy[0]), BL_X(cy[1]), BL_X(cy[2]), BL_X(cy[3]),
+               (unsigned)bl_bench_hz());
+        break;
+
+      case BL_BENCH_JSON:
+        bl_prt("{\"name\":\"%s\",\"loops\":%d,\"samples\":%d,"
+               "\"min_ns\":%u.%02u,\"med_ns\":%u.%02u,\"p99_ns\":%u.%02u,"
+               "\"max_ns\":%u.%02u,\"min_cyc\":%u.%02u,\"med_cyc\":%u.%02u,"
+               "\"p99_cyc\":%u.%02u,\"max_cyc\":%u.%02u,\"hz\":%u}\n",
+               b->name, b->loops, r->samples,
+               BL_X(ns[0]), BL_X(ns[1]), BL_X(ns[2]), BL_X(ns[3]),
+               BL_X(cy[0]), BL_X(cy[1]), BL_X(cy[2]), BL_X(cy[3]),
+               (unsigned)bl_bench_hz());
+        break;
+
+      default:
+        bl_prt("%-16s min %6u.%02u  med %6u.%02u  p99 %6u.%02u ns"
+               "  (med %u.%02u cyc, %d x %d loops)\n",
+               b->name, BL_X(ns[0]), BL_X(ns[1]), BL_X(ns[2]),
+               BL_X(cy[1]), r->samples, b->loops);
+        break;
+    }
+
+    #undef BL_X
+  }
+
+//==============================================================================
+// run and report all registered cases
+//==============================================================================
+
+  int bl_bench_run(BL_benchfmt fmt)
+  {
+    int n = 0;
+
+    if (fmt == BL_BENCH_CSV)
+      bl_prt("name,loops,samples,min_ns,med_ns,p99_ns,max_ns,"
+             "min_cyc,med_cyc,p99_cyc,max_cyc,hz\n");
+
+    for (BL_bench *b = bench_list; b; b = b->next)
+    {
+      if (bl_bench_case(b) == 0)
+      {
+        bl_bench_report(b,fmt);
+        n++;
+      }
+    }
+    return n;                          // number of cases run
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
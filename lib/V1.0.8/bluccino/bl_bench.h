@@ -0,0 +1,164 @@
+//==============================================================================
+//  bl_bench.h
+//  microbenchmark harness (warmup, repeated sampling, min/median/p99)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A benchmark case is a function which runs <n> loops of the code under test.
+// The harness calls it <loops> times per sample: first CFG_BENCH_WARMUP
+// samples which are discarded (caches, branch predictors, lazy init), then
+// CFG_BENCH_SAMPLES timed samples. Samples are taken with the cycle counter
+// where available (Zephyr: k_cycle_get_32, host: TSC or ARM virtual counter),
+// otherwise with bl_us(). Results are reported per loop as min, median, p99
+// and max in ns and cycles, as text, CSV or JSON lines over the log sink
+// (bl_prt), so numbers can be compared between releases.
+//
+// Example:
+//
+//   BL_BENCH(post,1000)                  // case post_bench, 1000 loops/sample
+//   {
+//     for (int i=0; i < n; i++)
+//       bl_post((app),BUTTON_PRESS_id_0_0, 1,NULL,0);
+//   }
+//
+//   bl_bench_add(&post_bench);           // register case
+//   bl_bench_run(BL_BENCH_CSV);          // run all cases, report as CSV
+//
+// Note: a sample must not take longer than the 32-bit cycle counter wraps
+// around (about 1.4 s at 3 GHz) - choose <loops> accordingly.
+//
+//==============================================================================
+
+#ifndef __BL_BENCH_H__
+#define __BL_BENCH_H__
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_BENCH_SAMPLES
+    #define CFG_BENCH_SAMPLES   100    // timed samples per case
+  #endif
+
+  #ifndef CFG_BENCH_WARMUP
+    #define CFG_BENCH_WARMUP      5    // discarded warmup samples per case
+  #endif
+
+  #ifndef CFG_BENCH_CYCLES
+    #define CFG_BENCH_CYCLES      1    // use cycle counter where available
+  #endif
+
+  #ifndef CFG_BENCH_CALIB_MS
+    #define CFG_BENCH_CALIB_MS   20    // cycle counter calibration time (ms)
+  #endif
+
+//==============================================================================
+// cycle counter (32 bit, wraps around)
+// - usage: cyc = bl_bench_cyc()       // differences are wrap around safe
+//==============================================================================
+
+  static inline uint32_t bl_bench_cyc(void)
+  {
+    #if (!CFG_BENCH_CYCLES)
+      return (uint32_t)bl_us();
+    #elif defined(__ZEPHYR__)
+      return k_cycle_get_32();
+    #elif defined(__x86_64__) || defined(__i386__)
+      return (uint32_t)__builtin_ia32_rdtsc();
+    #elif defined(__aarch64__)
+      uint64_t cnt;
+      __asm__ volatile("mrs %0, cntvct_el0" : "=r"(cnt));
+      return (uint32_t)cnt;
+    #else
+      return (uint32_t)bl_us();
+    #endif
+  }
+
+//==============================================================================
+// benchmark case
+//==============================================================================
+
+  typedef void (*BL_benchfn)(void *ctx, int n);  // run <n> loops of the case
+
+  typedef struct BL_benchres           // benchmark result (cycles per sample)
+          {
+            int samples;               // number of timed samples
+            uint32_t min;              // minimum sample
+            uint32_t med;              // median sample
+            uint32_t p99;              // 99th percentile sample
+            uint32_t max;              // maximum sample
+          } BL_benchres;
+
+  typedef struct BL_bench              // benchmark case
+          {
+            BL_txt name;               // case name
+            BL_benchfn run;            // run <n> loops of the case
+            void *ctx;                 // context passed to run/setup/teardown
+            int loops;                 // loops per sample
+            void (*setup)(void *ctx);  // called before warmup (NULL: none)
+            void (*teardown)(void *ctx);   // called after sampling (NULL: none)
+            BL_benchres res;           // result of last run
+            struct BL_bench *next;     // next registered case
+            bool linked;               // registered?
+          } BL_bench;
+
+//==============================================================================
+// define a benchmark case <name>_bench with <loops> loops per sample, the
+// body follows the macro and gets (void *ctx, int n)
+// - usage: BL_BENCH(post,1000) { for (int i=0; i < n; i++) ... }
+//==============================================================================
+
+  #define BL_BENCH(name,loops)                                              \
+          static void name##_run(void *ctx, int n);                         \
+          static BL_bench name##_bench =                                    \
+            {#name,name##_run,NULL,loops,NULL,NULL,{0},NULL,false};         \
+          static void name##_run(void *ctx, int n)
+
+//==============================================================================
+// report formats
+//==============================================================================
+
+  typedef enum BL_benchfmt
+          {
+            BL_BENCH_TEXT = 0,         // human readable, one line per case
+            BL_BENCH_CSV,              // CSV with header line
+            BL_BENCH_JSON,             // JSON lines, one object per case
+          } BL_benchfmt;
+
+//==============================================================================
+// register a benchmark case (cases run in order of registration)
+// - usage: bl_bench_add(&post_bench)
+//==============================================================================
+
+  void bl_bench_add(BL_bench *b);
+
+//==============================================================================
+// measure a single case (result in b->res), no report
+// - usage: err = bl_bench_case(&post_bench)  // -1: bad case
+//==============================================================================
+
+  int bl_bench_case(BL_bench *b);
+
+//==============================================================================
+// cycle counter frequency (calibrated against bl_us() at first call)
+// - usage: hz = bl_bench_hz()          // 0: unknown (clock does not advance)
+//==============================================================================
+
+  uint32_t bl_bench_hz(void);
+
+//==============================================================================
+// report result of a case over the log sink
+// - usage: bl_bench_report(&post_bench,BL_BENCH_JSON)
+//==============================================================================
+
+  void bl_bench_report(BL_bench *b, BL_benchfmt fmt);
+
+//==============================================================================
+// run and report all registered cases
+// - usage: n = bl_bench_run(BL_BENCH_CSV)   // number of cases run
+//==============================================================================
+
+  int bl_bench_run(BL_benchfmt fmt);
+
+#endif // __BL_BENCH_H__
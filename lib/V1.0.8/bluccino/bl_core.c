@@ -152,6 +152,7 @@
 //==============================================================================
 //
 // (H) := (BL_HW);  (W) := (BL_WL);  (D) := (BL_DOWN);  (U) := (BL_UP)
+// (Q) := (BL_SEQ)
 //
 //                  +--------------------+
 //                  |      BL_CORE       |
@@ -161,6 +162,7 @@
 //                  +--------------------+
 // (D)->          ->|        LED:        | LED input interface
 // (H)<-          <-|        LED:        | LED output interface
+// (Q)<-      SEQ <-|  @id,<BL_seq>,0    | LED pattern sequencer (bl_seq.h)
 //                  +--------------------+
 // (U)->          ->|       BUTTON:      | BUTTON input interface
 // (H)<-          <-|       BUTTON:      | BUTTON output interface
@@ -197,6 +199,11 @@
 //   bl_core's sub-modules !!!
 // - don't post up-stream messages to bl_core, as they have to go directly to
 //   bl_up()
+// - bl_core routes by class only (all opcodes of a class go to the same sub-
+//   module), thus it keeps its switch(o->cl) instead of a BL_DISPATCH table
+//   (bl_disp.h): the class tags are dense (jump table, no compare cascade on
+//   the [SYS:TICK] path), and an opcode table would have to list every
+//   opcode of every class, silently dropping opcodes added later
 //==============================================================================
 
   __weak int bl_core(BL_ob *o, int val)
@@ -224,6 +231,8 @@
         bl_hw(o,val);                  // forward to hardware core
         bl_wl(o,val);                  // forward to wireless core
 
+        if (bl_is(o,_SYS,INIT_))
+          bl_init((bl_seq),(bl_hw));   // LED sequencer outputs to HW core
         return 0;                      // OK
 
       case _SET:                       // SET interface
@@ -235,6 +244,10 @@
         return bl_wl(o,val);           // forward to wireless core
 
       case _LED:                       // LED interface
+        if (bl_op(o) == SEQ_)          // [LED:SEQ @id,<BL_seq>]
+          return bl_seq(o,val);        // run by LED pattern sequencer
+        return bl_hw(o,val);           // forward to hardware core
+
       case _BUTTON:                    // BUTTON interface
       case _SWITCH:                    // SWITCH interface
         return bl_hw(o,val);           // forward to hardware core
@@ -0,0 +1,131 @@
+//==============================================================================
+//  bl_dejavu.h
+//  replay cache (de-ja-vu) for transactional mesh SET messages
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A mesh client repeats a SET message with the same transaction ID (tid).
+// A server must process such a repetition only once, if it arrives from the
+// same source for the same destination within CFG_DEJAVU_MS (6 s). Each
+// server model owns its own replay cache, thus a tid sent to one model never
+// suppresses a message to another model (e.g. generic vs. vendor model).
+//
+// - fixed memory: CFG_DEJAVU_SLOTS entries, hashed by (src,dst) and probed
+//   within a window of CFG_DEJAVU_PROBE entries; if there is no entry for
+//   (src,dst) in the window, the oldest one (free entries have time 0) is
+//   recycled
+// - stale entries (older than CFG_DEJAVU_MS) are freed when they are looked
+//   up, thus an expired tid is never reported as a repetition
+//
+// Example:
+//
+//   static BL_DEJAVU(seen);           // replay cache of a server model
+//
+//   if (bl_dejavu(seen,src,dst,tid,now))
+//     return 0;                       // repetition: ignore
+//   ...                               // process message
+//   bl_dejavu_remember(seen,src,dst,tid,now);
+//
+//==============================================================================
+
+#ifndef __BL_DEJAVU_H__
+#define __BL_DEJAVU_H__
+
+  #include <stdbool.h>
+  #include <stdint.h>
+  #include <string.h>
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_DEJAVU_SLOTS
+    #define CFG_DEJAVU_SLOTS  16       // replay cache entries (power of 2)
+  #endif
+
+  #ifndef CFG_DEJAVU_PROBE
+    #define CFG_DEJAVU_PROBE  4        // probe window (<= CFG_DEJAVU_SLOTS)
+  #endif
+
+  #ifndef CFG_DEJAVU_MS
+    #define CFG_DEJAVU_MS     6000     // transaction window (ms)
+  #endif
+
+//==============================================================================
+// replay cache entry and replay cache definition
+// - usage: static BL_DEJAVU(seen);    // replay cache of a server model
+//==============================================================================
+
+  typedef struct BL_dejavu
+  {
+    uint8_t tid;                       // transaction ID of de-ja-vu
+    uint16_t src;                      // source address of de-ja-vu
+    uint16_t dst;                      // destination address of de-ja-vu
+    int64_t time;                      // time stamp of de-ja-vu (0: free)
+  } BL_dejavu;
+
+  #define BL_DEJAVU(name)  BL_dejavu name[CFG_DEJAVU_SLOTS]
+
+//==============================================================================
+// helper: i-th probe slot of (src,dst)
+//==============================================================================
+
+  static inline BL_dejavu *bl_dejavu_slot(BL_dejavu *cache, uint16_t src,
+                                          uint16_t dst, int i)
+  {
+    uint32_t h = (((uint32_t)src << 16) | dst) * 0x9E3779B1u;  // Fibonacci hash
+    return cache + (((h >> 16) + i) & (CFG_DEJAVU_SLOTS-1));
+  }
+
+//==============================================================================
+// has a message (src,dst,tid) been processed within the transaction window?
+// - usage: if (bl_dejavu(seen,src,dst,tid,now)) return 0;  // ignore repeat
+//==============================================================================
+
+  static inline bool bl_dejavu(BL_dejavu *cache, uint16_t src, uint16_t dst,
+                               uint8_t tid, int64_t now)
+  {
+    for (int i=0; i < CFG_DEJAVU_PROBE; i++)
+    {
+      BL_dejavu *p = bl_dejavu_slot(cache,src,dst,i);
+      if (p->time == 0 || p->src != src || p->dst != dst)
+        continue;
+
+      if (now - p->time > CFG_DEJAVU_MS)
+      {
+        memset(p,0,sizeof(*p));        // window expired: free entry
+        return false;
+      }
+      return (p->tid == tid);
+    }
+    return false;
+  }
+
+//==============================================================================
+// remember (src,dst,tid) of a processed message
+// - usage: bl_dejavu_remember(seen,src,dst,tid,now)
+//==============================================================================
+
+  static inline void bl_dejavu_remember(BL_dejavu *cache, uint16_t src,
+                                        uint16_t dst, uint8_t tid, int64_t now)
+  {
+    BL_dejavu *q = NULL;
+
+    for (int i=0; i < CFG_DEJAVU_PROBE; i++)
+    {
+      BL_dejavu *p = bl_dejavu_slot(cache,src,dst,i);
+      if (p->time && p->src == src && p->dst == dst)
+      {
+        q = p;                         // entry for (src,dst) found
+        break;
+      }
+      if (!q || p->time < q->time)
+        q = p;                         // oldest entry so far
+    }
+
+    q->tid = tid;  q->src = src;  q->dst = dst;
+    q->time = now ? now : 1;           // time 0 marks a free entry
+  }
+
+#endif // __BL_DEJAVU_H__
@@ -0,0 +1,38 @@
+//==============================================================================
+//  bl_disp.c
+//  compile time dispatch tables for OVAL module interfaces
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include "bluccino.h"
+
+//==============================================================================
+// introspection: supported message IDs of a dispatch table
+// - usage: n = bl_dispatch_ids(&table,ids,max) // store up to max IDs
+//          n = bl_dispatch_ids(&table,NULL,0)  // count supported messages
+//==============================================================================
+
+  int bl_dispatch_ids(const BL_dispatch *d, BL_id *ids, int max)
+  {
+    int n = 0;
+
+    for (int s=0; s < d->n; s++)
+    {
+      const BL_ops *r = d->row[s];
+      for (int op=0; r && op < r->n; op++)
+        if (r->fn[op])
+        {
+          if (ids && n < max)
+            ids[n] = BL_ID(r->cl,op);
+          n++;
+        }
+    }
+    return n;                          // number of supported messages
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
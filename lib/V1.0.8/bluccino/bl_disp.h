@@ -0,0 +1,149 @@
+//==============================================================================
+//  bl_disp.h
+//  compile time dispatch tables for OVAL module interfaces
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A dispatch table maps a message [CL:OP] to an OVAL worker by two array
+// lookups, replacing the cascade of compares a switch(bl_id(o)) over sparse
+// 32-bit message IDs compiles to. Level one is indexed by the (augmented)
+// class tag, level two by the opcode. Both levels are built with designated
+// initializers at compile time and are sized by the highest class/opcode in
+// use. Unsupported messages map to NULL (bl_dispatch() returns -1).
+//
+// Example:
+//
+//   BL_OPS(mod_sys,_SYS,                          // [SYS:...] opcode row
+//     BL_ON(SYS_INIT_0_cb_0, sys_init),
+//     BL_ON(SYS_TICK_id_BL_pace_cnt, sys_tick));
+//
+//   BL_OPS(mod_goocli,BL_AUG(_GOOCLI),            // [#GOOCLI:...] opcode row
+//     BL_ON(_GOOCLI_SET_id_BL_goo_onoff, out_down),
+//     BL_ON(_GOOCLI_LET_id_BL_goo_onoff, out_down));
+//
+//   BL_DISPATCH(bl_mod_ifc,                       // class table (exported)
+//     BL_ROW(mod_sys),
+//     BL_ROW(mod_goocli));
+//
+//   int bl_mod(BL_ob *o, int val)
+//   {
+//     return bl_dispatch(&bl_mod_ifc,o,val);      // -1 if not supported
+//   }
+//
+// All message IDs of a row must belong to the row's class (the opcode part of
+// the ID is the row index), which is checked at compile time: a BL_ON() entry
+// of another class fails with a negative array size. A row holds up to 12
+// BL_ON() entries. Row names are file scope statics, so prefix them with the
+// module name (the Bluccino core is a *.c file merge).
+//
+// Pure class routers, which forward all opcodes of a class to the same
+// module (e.g. bl_core), keep their switch(o->cl): dense class tags compile
+// to a jump table anyway.
+//
+//==============================================================================
+
+#ifndef __BL_DISP_H__
+#define __BL_DISP_H__
+
+//==============================================================================
+// dispatch table structures
+//==============================================================================
+
+  typedef struct BL_ops                // opcode row of one (augmented) class
+          {
+            const BL_oval *fn;         // workers, indexed by opcode
+            uint16_t n;                // row length (highest opcode + 1)
+            uint16_t cl;               // class tag (incl. aug bit)
+          } BL_ops;
+
+  typedef struct BL_dispatch           // class table
+          {
+            const BL_ops *const *row;  // rows, indexed by BL_DSLOT(class)
+            uint16_t n;                // table length (highest slot + 1)
+          } BL_dispatch;
+
+//==============================================================================
+// table construction
+// - usage: BL_OPS(row,cl, BL_ON(mid,fn), ...);  // define opcode row
+//          BL_DISPATCH(table, BL_ROW(row), ...);// define (exported) table
+//==============================================================================
+
+  #define BL_DSLOT(cl)  ((((uint32_t)(cl) & BL_AUGCLR) << 1) | \
+                         (((uint32_t)(cl) & BL_AUGBIT) ? 1 : 0))
+
+  #define BL_ON(mid,fn) (mid,fn)     // expanded by BL_OPS() (class check)
+
+  #define BL_OPS(name,cl,...)                                               \
+          enum { name##_slot = BL_DSLOT(cl) };                              \
+          static const BL_oval name##_fn[] =                                \
+            { BL_DISP_EACH(cl,__VA_ARGS__) };                               \
+          static const BL_ops name = { name##_fn, BL_LEN(name##_fn), (cl) }
+
+  #define BL_ROW(name)  [name##_slot] = &name
+
+  #define BL_DISPATCH(name,...)                                             \
+          static const BL_ops *const name##_row[] = { __VA_ARGS__ };        \
+          const BL_dispatch name = { name##_row, BL_LEN(name##_row) }
+
+//==============================================================================
+// helper: expand BL_ON() entries of a row of class cl into designated
+// initializers [op] = fn, with array size -1 if the class of mid is not cl
+//==============================================================================
+
+  #define BL_DISP_ON(cl,mid,fn)                                             \
+          [BL_OP(mid) + 0*sizeof(char[BL_CL(mid) == (cl) ? 1 : -1])] = (fn)
+
+  #define BL_DISP_E(cl,on)     BL_DISP_X(BL_DISP_ON,(cl,BL_DISP_U on))
+  #define BL_DISP_X(m,args)    m args
+  #define BL_DISP_U(mid,fn)    mid,fn
+
+  #define BL_DISP_1(cl,e)      BL_DISP_E(cl,e)
+  #define BL_DISP_2(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_1(cl,__VA_ARGS__)
+  #define BL_DISP_3(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_2(cl,__VA_ARGS__)
+  #define BL_DISP_4(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_3(cl,__VA_ARGS__)
+  #define BL_DISP_5(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_4(cl,__VA_ARGS__)
+  #define BL_DISP_6(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_5(cl,__VA_ARGS__)
+  #define BL_DISP_7(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_6(cl,__VA_ARGS__)
+  #define BL_DISP_8(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_7(cl,__VA_ARGS__)
+  #define BL_DISP_9(cl,e,...)  BL_DISP_E(cl,e), BL_DISP_8(cl,__VA_ARGS__)
+  #define BL_DISP_10(cl,e,...) BL_DISP_E(cl,e), BL_DISP_9(cl,__VA_ARGS__)
+  #define BL_DISP_11(cl,e,...) BL_DISP_E(cl,e), BL_DISP_10(cl,__VA_ARGS__)
+  #define BL_DISP_12(cl,e,...) BL_DISP_E(cl,e), BL_DISP_11(cl,__VA_ARGS__)
+
+  #define BL_DISP_N(_1,_2,_3,_4,_5,_6,_7,_8,_9,_10,_11,_12,n,...) BL_DISP_##n
+  #define BL_DISP_EACH(cl,...)                                              \
+          BL_DISP_N(__VA_ARGS__,12,11,10,9,8,7,6,5,4,3,2,1,0)(cl,__VA_ARGS__)
+
+//==============================================================================
+// lookup worker for a message (NULL if not supported)
+// - usage: fn = bl_handler(&table,o)
+//==============================================================================
+
+  static inline BL_oval bl_handler(const BL_dispatch *d, BL_ob *o)
+  {
+    uint32_t slot = BL_DSLOT(o->cl);
+    const BL_ops *r = (slot < d->n) ? d->row[slot] : NULL;
+    return (r && (uint32_t)o->op < r->n) ? r->fn[o->op] : NULL;
+  }
+
+//==============================================================================
+// dispatch message to its worker (return -1 if not supported)
+// - usage: return bl_dispatch(&table,o,val)
+//==============================================================================
+
+  static inline int bl_dispatch(const BL_dispatch *d, BL_ob *o, int val)
+  {
+    BL_oval fn = bl_handler(d,o);
+    return fn ? fn(o,val) : -1;
+  }
+
+//==============================================================================
+// introspection: supported message IDs of a dispatch table
+// - usage: n = bl_dispatch_ids(&table,ids,max) // store up to max IDs
+//          n = bl_dispatch_ids(&table,NULL,0)  // count supported messages
+//==============================================================================
+
+  int bl_dispatch_ids(const BL_dispatch *d, BL_id *ids, int max);
+
+#endif // __BL_DISP_H__
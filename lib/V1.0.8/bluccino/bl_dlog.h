@@ -0,0 +1,266 @@
+//==============================================================================
+//  bl_dlog.h
+//  deferred (binary) logging - record & frame format, format spec scanner
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// With CFG_RTL_DEFERRED a log call does not sprintf() into a text buffer.
+// Instead only the format string pointer and the raw argument values are
+// stored in a compact log record, which is formatted later in the RTL print
+// work horse (or, with CFG_RTL_BINARY, sent as binary frame to be decoded on
+// the host with host/bl_logdec).
+//
+// Restrictions:
+// - %s arguments are stored as pointers, i.e. strings must be persistent
+//   (string literals or static text), since they are read at format time
+// - no '*' width/precision and no long double (%Lf) conversions
+//
+// Binary frames (little endian, <ptr> has pointer size of the target):
+//
+//   session:  0xB0, <ptrsize>, <ptr:anchor>     (once, anchor text address)
+//   record:   0xB1, <flags>, <words>, <ptr:fmt>, <words> x <uint32_t>
+//
+// A header record (flags & BL_DLOG_HDR) has fmt == NULL and carries the
+// words {lev, us_lo, us_hi} which are formatted as "#lev[mmm:ss:mmm.uuu] ".
+//
+//==============================================================================
+
+#ifndef __BL_DLOG_H__
+#define __BL_DLOG_H__
+
+  #include <stdint.h>
+  #include <stdio.h>
+  #include <string.h>
+
+#ifndef CFG_RTL_WORDS
+  #define CFG_RTL_WORDS  12            // max 32-bit argument words per record
+#endif
+
+//==============================================================================
+// record flags & frame constants
+//==============================================================================
+
+  #define BL_DLOG_HDR     0x01         // time stamp header record
+  #define BL_DLOG_EOL     0x02         // append color reset (& LF if non-empty)
+  #define BL_DLOG_TRUNC   0x04         // argument words truncated
+
+  #define BL_DLOG_COLOR   0x30         // header color mask (0: default)
+  #define BL_DLOG_GREEN   0x10         // header color: attention
+  #define BL_DLOG_CYAN    0x20         // header color: provisioned
+
+  #define BL_DLOG_SESSION 0xB0         // session frame magic
+  #define BL_DLOG_RECORD  0xB1         // record frame magic
+
+  #define BL_DLOG_ANCHOR  "BL_DLOG_ANCHOR:V1"  // anchor text (load bias)
+
+//==============================================================================
+// deferred log record
+//==============================================================================
+
+  typedef struct BL_dlog               // deferred log record
+          {
+            const char *fmt;           // format string (NULL for header)
+            uint8_t flags;             // record flags
+            uint8_t words;             // number of used argument words
+            uint32_t arg[CFG_RTL_WORDS];  // raw argument words
+          } BL_dlog;
+
+//==============================================================================
+// argument types of conversion specs
+//==============================================================================
+
+  typedef enum BL_dlarg
+          {
+            BL_DLARG_NONE,             // no argument ("%%" or plain text)
+            BL_DLARG_INT,              // int (also char, short)
+            BL_DLARG_LONG,             // long, size_t, ptrdiff_t
+            BL_DLARG_LLONG,            // long long, intmax_t
+            BL_DLARG_PTR,              // pointer (%p, %s)
+            BL_DLARG_DBL,              // double
+            BL_DLARG_BAD,              // unsupported conversion spec
+          } BL_dlarg;
+
+//==============================================================================
+// scan a conversion spec
+// - usage: f = bl_dlog_spec(f,spec,sizeof(spec),&type)  // f points to '%'
+// - copies the spec (e.g. "%-5ld") to spec and returns pointer behind spec
+//==============================================================================
+
+  static inline const char *bl_dlog_spec(const char *f, char *spec, int size,
+                                         BL_dlarg *type)
+  {
+    const char *s = f++;               // skip '%'
+    int len = 0;                       // length modifier count of 'l'
+
+    while (*f && strchr("-+ #0",*f))   // flags
+      f++;
+    while (*f >= '0' && *f <= '9')     // width
+      f++;
+    if (*f == '.')                     // precision
+      for (f++; *f >= '0' && *f <= '9'; f++);
+
+    for (;; f++)                       // length modifiers
+    {
+      if (*f == 'l')
+        len++;
+      else if (*f == 'z' || *f == 't')
+        len = 1;
+      else if (*f == 'j')
+        len = 2;
+      else if (*f != 'h')
+        break;
+    }
+
+    switch (*f)
+    {
+      case '%':
+        *type = BL_DLARG_NONE;  break;
+      case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+        *type = len == 0 ? BL_DLARG_INT : len == 1 ? BL_DLARG_LONG
+                                                   : BL_DLARG_LLONG;
+        break;
+      case 's': case 'p':
+        *type = BL_DLARG_PTR;  break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+        *type = BL_DLARG_DBL;  break;
+      default:
+        *type = BL_DLARG_BAD;          // '*', 'L', 'n', or end of string
+        return f;
+    }
+
+    f++;                               // f points behind conversion char
+    int n = (int)(f - s);
+    n = (n < size) ? n : size-1;
+    memcpy(spec,s,n);  spec[n] = 0;
+    return f;
+  }
+
+//==============================================================================
+// size of an argument type in bytes
+// - usage: bytes = bl_dlog_size(type,ptrsize)  // ptrsize: 4 or 8
+// - note: long has pointer size (ILP32 and LP64 targets)
+//==============================================================================
+
+  static inline int bl_dlog_size(BL_dlarg type, int ptrsize)
+  {
+    switch (type)
+    {
+      case BL_DLARG_INT:   return 4;
+      case BL_DLARG_LONG:  return ptrsize;
+      case BL_DLARG_PTR:   return ptrsize;
+      case BL_DLARG_LLONG: return 8;
+      case BL_DLARG_DBL:   return 8;
+      default:             return 0;
+    }
+  }
+
+//==============================================================================
+// fetch argument value from record words
+//==============================================================================
+
+  static inline uint64_t bl_dlog_fetch(const BL_dlog *r, int *pw, int bytes)
+  {
+    uint64_t v = 0;
+    int n = (bytes+3)/4;               // number of words
+    if (*pw + n > r->words)
+      return 0;
+    memcpy(&v,r->arg + *pw,bytes);     // little endian
+    *pw += n;
+    return v;
+  }
+
+//==============================================================================
+// format a deferred log record
+// - usage: len = bl_dlog_format(buf,size,r,ptrsize,str)
+// - str() maps a target string address to a readable string (NULL: invalid)
+//==============================================================================
+
+  static inline int bl_dlog_format(char *buf, int size, const BL_dlog *r,
+                                   int ptrsize, const char *(*str)(uint64_t))
+  {
+    int len = 0;                       // length of formatted text
+    int w = 0;                         // word index
+    buf[0] = 0;
+
+    #define BL_DLOG_PUT(...) \
+            do { if (len < size) \
+                   len += snprintf(buf+len,size-len,__VA_ARGS__); } while(0)
+
+    if (r->flags & BL_DLOG_HDR)        // time stamp header?
+    {
+      int lev = (int)bl_dlog_fetch(r,&w,4);
+      uint64_t us = bl_dlog_fetch(r,&w,8);
+      const char *col = (r->flags & BL_DLOG_GREEN) ? "\x1b[32m"
+                      : (r->flags & BL_DLOG_CYAN) ? "\x1b[36m" : "";
+
+      BL_DLOG_PUT("%s#%d[%03d:%02d:%03d.%03d] \x1b[0m", col, lev,
+                  (int)(us/60000000), (int)(us/1000000 % 60),
+                  (int)(us/1000 % 1000), (int)(us % 1000));
+      for (int i=0; i < lev; i++)
+        BL_DLOG_PUT("  ");             // indentation
+      return len < size ? len : size-1;
+    }
+
+    for (const char *f = r->fmt; f && *f; )
+    {
+      if (*f != '%')
+      {
+        const char *p = strchr(f,'%');
+        int n = p ? (int)(p-f) : (int)strlen(f);
+        BL_DLOG_PUT("%.*s",n,f);       // plain text up to next '%'
+        f += n;
+        continue;
+      }
+
+      char spec[16];
+      BL_dlarg type;
+      const char *g = bl_dlog_spec(f,spec,sizeof(spec),&type);
+      int bytes = bl_dlog_size(type,ptrsize);
+
+      if (type == BL_DLARG_BAD || w + (bytes+3)/4 > r->words)
+      {
+        BL_DLOG_PUT("%s",(r->flags & BL_DLOG_TRUNC) ? "..." : f);
+        break;                         // unsupported spec or truncated args
+      }
+
+      uint64_t v = bl_dlog_fetch(r,&w,bytes);
+      double d;
+      const char *s;
+
+      switch (type)
+      {
+        case BL_DLARG_NONE:  BL_DLOG_PUT("%%");  break;
+        case BL_DLARG_INT:   BL_DLOG_PUT(spec,(int)v);  break;
+        case BL_DLARG_LLONG: BL_DLOG_PUT(spec,(long long)v);  break;
+        case BL_DLARG_LONG:            // widen 32-bit target long:
+          if (ptrsize == 4)            // zero extend u,x,X,o, sign extend d,i
+            v = strchr("uxXo",g[-1]) ? (uint64_t)(uint32_t)v
+                                     : (uint64_t)(int64_t)(int32_t)v;
+          BL_DLOG_PUT(spec,(long)v);
+          break;
+        case BL_DLARG_DBL:
+          memcpy(&d,&v,sizeof(d));
+          BL_DLOG_PUT(spec,d);
+          break;
+        default:                       // BL_DLARG_PTR
+          if (g[-1] == 'p')
+            BL_DLOG_PUT(spec,(void*)(uintptr_t)v);
+          else
+          {
+            s = str(v);
+            BL_DLOG_PUT(spec,s ? s : "<?>");
+          }
+          break;
+      }
+      f = g;
+    }
+
+    if (r->flags & BL_DLOG_EOL)        // like BL_LOG: color reset & LF
+      BL_DLOG_PUT("\x1b[0m%s",(r->fmt && *r->fmt) ? "\n" : "");
+
+    #undef BL_DLOG_PUT
+    return len < size ? len : size-1;
+  }
+
+#endif // __BL_DLOG_H__
@@ -32,13 +32,13 @@
     if (!to)                           // is a valid <out> callback provided?
       return 0;
 
-      // augmented class tag? (aug bit set) => need to duplicate object with
-      // de-augmented class tag before forwarding
+      // augmented class tag? (aug bit set) => forward an un-augmented view
+      // of the object (no copy, see bl_view())
 
     if ( !BL_ISAUG(o->cl) )            // easy for un-augmented class tags!
       return to(o,val);                // forward event message to subscriber
     else                               // forward with un-augmented class tag
-      return bl_msg((to), BL_UNAUG(o->cl),o->op, o->id,o->data,val);
+      return bl_view(o,val,(to),BL_UNAUG(o->cl));
   }
 
 //==============================================================================
@@ -53,13 +53,13 @@
     if (!to)                       // is a valid <out> callback provided?
       return 0;
 
-      // augmented class tag? (aug bit set) => need to duplicate object with
-      // de-augmented class tag before forwarding
+      // un-augmented class tag? (aug bit clear) => forward an augmented view
+      // of the object (no copy, see bl_view())
 
-    if ( BL_ISAUG(o->cl) )             // easy for un-augmented class tags!
+    if ( BL_ISAUG(o->cl) )             // easy for augmented class tags!
       return to(o,val);            // forward event message to subscriber
-    else                               // forward with un-augmented class tag
-      return bl_msg((to), BL_AUG(o->cl),o->op, o->id,o->data,val);
+    else                               // forward with augmented class tag
+      return bl_view(o,val,(to),BL_AUG(o->cl));
   }
 
 //==============================================================================
@@ -78,7 +78,13 @@
       return 0;
     }
 
-    return (O) ? (O)(o,val) : 0;
+    if (!O)
+      return 0;
+
+    BL_us tic = bl_acc_tic();          // account app's event handling
+    int err = (O)(o,val);
+    bl_acc_toc(BL_ACC_APP,o,tic);
+    return err;
   }
 
 //==============================================================================
@@ -96,7 +102,10 @@
     if ( !nolog )
       LOG0(3,"down:",o,val);           // not suppressed messages are logged
 
-    return bl_core(o,val);             // forward down to BL_CORE module
+    BL_us tic = bl_acc_tic();          // account down gear (incl. core)
+    int err = bl_core(o,val);          // forward down to BL_CORE module
+    bl_acc_toc(BL_ACC_DOWN,o,tic);
+    return err;
   }
 
 //==============================================================================
@@ -119,7 +128,12 @@
 			  return 0;
 
 			default:
-        return bl_out(o,val,(T));      // output to bl_top by default
+      {
+        BL_us tic = bl_acc_tic();      // account up gear
+        int err = bl_out(o,val,(T));   // output to bl_top by default
+        bl_acc_toc(BL_ACC_UP,o,tic);
+        return err;
+      }
 		}
   }
 
@@ -149,8 +163,11 @@
 
   __weak int bl_top(BL_ob *o, int val)
   {
+    BL_us tic = bl_acc_tic();          // account top gear
     bl_deco(o,val);                    // handle [MESH:ATT]/[MESH:PRV] events
-    return bl_emit(o,val);             // emit all messages except [SYS:] msg's
+    int err = bl_emit(o,val);          // emit all messages except [SYS:] msg's
+    bl_acc_toc(BL_ACC_TOP,o,tic);
+    return err;
   }
 
 //==============================================================================
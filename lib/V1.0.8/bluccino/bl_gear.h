@@ -14,11 +14,13 @@
 // - [SYS:INIT cb] inits module, stores output callback
 // - [SYS:TICK @id,cnt] ticks module (@id: tick ID, cnt: tick counter)
 // - [SYS:TOCK @id,cnt] tocks module (@id: tock ID, cnt: tock counter)
+// - [SYS:LOG @id,lvl] sets log filter level (@id: filter ID, see bl_logfilt)
 //==============================================================================
 
   #define SYS_INIT_0_cb_0   BL_ID(_SYS,INIT_) // [SYS:INIT cb] init module
   #define SYS_TICK_id_BL_pace_cnt BL_ID(_SYS,TICK_) // [SYS:TICK @id,cnt] tick module
   #define SYS_TOCK_id_BL_pace_cnt BL_ID(_SYS,TOCK_) // [SYS:TOCK @id,cnt] tock module
+  #define SYS_LOG_id_0_lvl  BL_ID(_SYS,LOG_)  // [SYS:LOG @id,lvl] log filter
 
     // augmented messages
 
@@ -26,6 +28,38 @@
   #define _SYS_TICK_id_BL_pace_cnt _BL_ID(_SYS,TICK_) // [#SYS:TICK @id,cnt] tick mod.
   #define _SYS_TOCK_id_BL_pace_cnt _BL_ID(_SYS,TOCK_) // [#SYS:TOCK @id,cnt] tock mod.
 
+//==============================================================================
+// class tag view
+// - CFG_GEAR_INPLACE 0: a copy with changed class tag is posted (default)
+// - CFG_GEAR_INPLACE 1 (experimental): bl_out()/_bl_out()/_bl_fwd() flip the
+//   AUG bit of the caller's object in place for the duration of the call and
+//   restore it afterwards. Only safe if the object is writable and used by a
+//   single context at a time; a class tag change of the receiver is lost.
+//==============================================================================
+
+  #ifndef CFG_GEAR_INPLACE
+    #define CFG_GEAR_INPLACE  0        // post a copy with changed class tag
+  #endif
+
+//==============================================================================
+// forward message with a given view of the class tag (e.g. (un-)augmented)
+// - usage: bl_view(o,val,(to),BL_UNAUG(o->cl))  // un-augmented view
+//==============================================================================
+
+  static inline int bl_view(BL_ob *o, int val, BL_oval to, BL_cl cl)
+  {
+    #if (CFG_GEAR_INPLACE)
+      BL_cl old = o->cl;               // caller's class tag
+      o->cl = cl;                      // flip view in place (no copy)
+      int err = to(o,val);
+      o->cl = old;                     // restore caller's view
+      return err;
+    #else
+      BL_ob oo = {cl,o->op,o->id,o->data};
+      return to(&oo,val);              // post copy with changed class tag
+    #endif
+  }
+
 //==============================================================================
 // event message output (message emission of a module)
 // - usage: bl_out(o,val,(to))  // output to given module
@@ -0,0 +1,215 @@
+//==============================================================================
+//  bl_gesture.c
+//  button gesture engine (multi-click, hold with repeat, hold+click combos)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include "bluccino.h"
+  #include "bl_gesture.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO                     "bl_gesture:"
+
+  #define LOG                     LOG_BUTTON
+  #define LOGO(lvl,col,o,val)     LOGO_BUTTON(lvl,col WHO,o,val)
+
+  static BL_gesture *gestures = NULL;  // registered gestures
+
+  static void gest_timeouts(struct k_work *work);
+  K_WORK_DEFINE(gest_work, gest_timeouts);   // processes due gestures
+
+  static void gest_expired(struct k_timer *timer)
+  {
+    k_work_submit(&gest_work);         // ISR context: continue in work queue
+  }
+
+  K_TIMER_DEFINE(gest_timer, gest_expired, NULL);   // THE gesture timer
+
+//==============================================================================
+// helper: arm gesture timer for the earliest timeout of all gestures
+//==============================================================================
+
+  static void gest_arm(void)
+  {
+    BL_ms next = 0;
+    for (BL_gesture *g = gestures; g; g = g->next)
+      if (g->due && (!next || g->due < next))
+        next = g->due;
+
+    if (!next)
+    {
+      k_timer_stop(&gest_timer);       // nothing pending
+      return;
+    }
+
+    BL_ms now = bl_ms();
+    k_timer_start(&gest_timer,K_MSEC(next > now ? next - now : 0),K_NO_WAIT);
+  }
+
+//==============================================================================
+// helper: ID of another button which is currently held (0: none)
+//==============================================================================
+
+  static int gest_holder(BL_gesture *g)
+  {
+    for (BL_gesture *h = gestures; h; h = h->next)
+      if (h != g && h->state == BL_GS_HELD)
+        return h->id;
+    return 0;
+  }
+
+//==============================================================================
+// helper: post a recognized gesture [#BUTTON:op @id,val] to output
+//==============================================================================
+
+  static void gest_post(BL_gesture *g, BL_id mid, int val)
+  {
+    if (g->out)
+      bl_post((g->out), mid, g->id,NULL,val);
+  }
+
+//==============================================================================
+// helper: post the clicks of a sequence (as combo, if a button was held)
+//==============================================================================
+
+  static void gest_clicks(BL_gesture *g)
+  {
+    if (g->clicks && g->holder)
+    {
+      LOG(4,BL_B "button @%d combo: %d clicks, @%d held",
+                 g->id,g->clicks,g->holder);
+      gest_post(g,_BUTTON_COMBO_id_0_cnt,g->clicks + 256*g->holder);
+    }
+    else if (g->clicks)
+    {
+      LOG(4,BL_B "button @%d clicked %d times",g->id,g->clicks);
+      gest_post(g,_BUTTON_CLICK_id_0_cnt,g->clicks);
+    }
+    g->clicks = 0;
+  }
+
+//==============================================================================
+// helper: timeout of a gesture (hold begin, hold repeat, end of sequence)
+//==============================================================================
+
+  static void gest_timeout(BL_gesture *g, BL_ms now)
+  {
+    switch (g->state)
+    {
+      case BL_GS_DOWN:                 // pressed longer than hold time
+        gest_clicks(g);                // clicks before the hold come first
+        g->state = BL_GS_HELD;
+        g->due = g->repeat ? g->due + g->repeat : 0;
+        LOG(4,BL_Y "button @%d hold (begin)",g->id);
+        gest_post(g,_BUTTON_HOLD_id_0_ms,0);
+        break;
+
+      case BL_GS_HELD:                 // hold repeat
+        g->due += g->repeat;
+        gest_post(g,_BUTTON_HOLD_id_0_ms,(int)(now - g->press));
+        break;
+
+      case BL_GS_GAP:                  // no further click: sequence complete
+        g->state = BL_GS_IDLE;
+        g->due = 0;
+        gest_clicks(g);
+        break;
+
+      default:
+        g->due = 0;
+        break;
+    }
+  }
+
+//==============================================================================
+// work horse: process all due gestures, then re-arm gesture timer
+//==============================================================================
+
+  static void gest_timeouts(struct k_work *work)
+  {
+    BL_ms now = bl_ms();
+    for (BL_gesture *g = gestures; g; g = g->next)
+      if (g->due && g->due <= now)
+        gest_timeout(g,now);
+    gest_arm();
+  }
+
+//==============================================================================
+// feed a button edge into a gesture
+//==============================================================================
+
+  int bl_gesture(BL_gesture *g, BL_ob *o, int val)
+  {
+    BL_ms now = bl_ms();
+
+    if (!g->linked)                    // register at first edge
+    {
+      g->next = gestures;
+      g->linked = true;
+      gestures = g;
+    }
+
+    switch (bl_id(o))
+    {
+      case _BUTTON_PRESS_id_0_0:
+        if (g->state == BL_GS_DOWN || g->state == BL_GS_HELD)
+          return 0;                    // ignore duplicate press
+        if (g->state == BL_GS_IDLE)
+        {
+          g->clicks = 0;               // begin of a new sequence
+          g->holder = 0;
+        }
+        g->state = BL_GS_DOWN;
+        g->press = now;
+        g->due = now + g->hold;        // hold detection
+        break;
+
+      case _BUTTON_RELEASE_id_0_ms:
+        if (g->state == BL_GS_DOWN)    // click
+        {
+          g->clicks++;
+          if (!g->holder)
+            g->holder = gest_holder(g);   // other button held: combo
+        }
+        else if (g->state == BL_GS_HELD)
+        {
+          gest_post(g,_BUTTON_HOLD_id_0_ms,(int)(now - g->press));
+          g->clicks = 0;               // clicks may follow: one-button combo
+          g->holder = g->id;
+        }
+        else
+          return 0;                    // ignore release without press
+
+        g->state = BL_GS_GAP;
+        g->due = now + g->gap;         // end of sequence detection
+        break;
+
+      default:
+        return -1;                     // bad input
+    }
+
+    gest_arm();
+    return 0;
+  }
+
+//==============================================================================
+// cancel a pending gesture sequence
+//==============================================================================
+
+  void bl_gesture_reset(BL_gesture *g)
+  {
+    g->state = BL_GS_IDLE;
+    g->clicks = g->holder = 0;
+    g->due = 0;
+    gest_arm();
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
@@ -0,0 +1,110 @@
+//==============================================================================
+//  bl_gesture.h
+//  button gesture engine (multi-click, hold with repeat, hold+click combos)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A button driver feeds the debounced edges of a button as [#BUTTON:PRESS]
+// and [#BUTTON:RELEASE] into the gesture of the button. The engine posts
+// the recognized gestures to the gesture's output:
+//
+//   [#BUTTON:CLICK @id,n]       n clicks, each press shorter than <hold> ms
+//                               and pauses shorter than <gap> ms
+//   [#BUTTON:HOLD @id,0]        button held for <hold> ms (hold begin),
+//                               preceded by the CLICK/COMBO of any clicks
+//                               of the sequence before the hold
+//   [#BUTTON:HOLD @id,ms]       every <repeat> ms while held, and on release
+//   [#BUTTON:COMBO @id,n+256*h] n clicks of button @id while button @h is
+//                               held, or n clicks right after button @id
+//                               itself was held (h = id, one-button combo)
+//
+// The engine is event driven: all gestures share one k_timer, which is
+// armed for the earliest timeout and processes the due gestures in a work
+// item. Gestures never need [SYS:TICK] messages. Edges and timeouts are both
+// processed in the system work queue (no locking).
+//
+// Example:
+//
+//   static BL_GESTURE(gest,1,gesture_out);   // gesture of button @1
+//
+//   bl_gesture(&gest,o,val);  // feed [#BUTTON:PRESS/RELEASE @1] (worker)
+//
+//==============================================================================
+
+#ifndef __BL_GESTURE_H__
+#define __BL_GESTURE_H__
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_GESTURE_HOLD
+    #define CFG_GESTURE_HOLD     350   // click/hold discrimination time (ms)
+  #endif
+
+  #ifndef CFG_GESTURE_GAP
+    #define CFG_GESTURE_GAP      250   // max pause between clicks (ms)
+  #endif
+
+  #ifndef CFG_GESTURE_REPEAT
+    #define CFG_GESTURE_REPEAT   500   // HOLD repeat period (ms), 0: off
+  #endif
+
+//==============================================================================
+// gesture of a button
+//==============================================================================
+
+  typedef enum BL_gstate               // gesture state
+          {
+            BL_GS_IDLE = 0,            // released, no sequence pending
+            BL_GS_DOWN,                // pressed, shorter than hold time
+            BL_GS_HELD,                // pressed, longer than hold time
+            BL_GS_GAP,                 // released, waiting for next click
+          } BL_gstate;
+
+  typedef struct BL_gesture            // gesture of a button
+          {
+            int id;                    // button ID
+            BL_oval out;               // output of recognized gestures
+            int hold;                  // click/hold discrimination time (ms)
+            int gap;                   // max pause between clicks (ms)
+            int repeat;                // HOLD repeat period (ms), 0: off
+            BL_gstate state;           // gesture state
+            int clicks;                // clicks of current sequence
+            int holder;                // ID of held button (combo), 0: none
+            BL_ms press;               // time stamp of last press
+            BL_ms due;                 // time of next timeout (0: none)
+            struct BL_gesture *next;   // next registered gesture
+            bool linked;               // registered?
+          } BL_gesture;
+
+//==============================================================================
+// define a gesture <name> of button @id with output <out> (default timing)
+// - usage: static BL_GESTURE(gest,1,out)
+//          static BL_gesture gest[2] = {BL_GESTURE_INIT(1,out),
+//                                       BL_GESTURE_INIT(2,out)};
+//==============================================================================
+
+  #define BL_GESTURE_INIT(id,out)                                           \
+          {id,out,CFG_GESTURE_HOLD,CFG_GESTURE_GAP,CFG_GESTURE_REPEAT,      \
+           BL_GS_IDLE,0,0,0,0,NULL,false}
+
+  #define BL_GESTURE(name,id,out)                                           \
+          BL_gesture name = BL_GESTURE_INIT(id,out)
+
+//==============================================================================
+// feed a button edge into a gesture (registers the gesture at first call)
+// - usage: err = bl_gesture(&gest,o,val)  // [#BUTTON:PRESS/RELEASE @id]
+//==============================================================================
+
+  int bl_gesture(BL_gesture *g, BL_ob *o, int val);
+
+//==============================================================================
+// cancel a pending gesture sequence (e.g. when events are disabled)
+// - usage: bl_gesture_reset(&gest)
+//==============================================================================
+
+  void bl_gesture_reset(BL_gesture *g);
+
+#endif // __BL_GESTURE_H__
@@ -67,11 +67,6 @@
 
         BL_goo goo;               // generic on/off data structure
 
-        uint8_t last_tid;
-        uint16_t last_src_addr;
-        uint16_t last_dst_addr;
-        int64_t last_msg_timestamp;
-
         int32_t tt_delta;
 
         BL_transition *transition;
@@ -18,6 +18,7 @@
 //     bl_cfg(bl_hw,_BUTTON,BL_SWITCH)         // enable [BUTTON:SWITCH]
 //     bl_cfg(bl_hw,_BUTTON,BL_CLICK)          // enable [BUTTON:CLICK]
 //     bl_cfg(bl_hw,_BUTTON,BL_HOLD)           // enable [BUTTON:HOLD]
+//     bl_cfg(bl_hw,_BUTTON,BL_COMBO)          // enable [BUTTON:COMBO]
 //
 //     bl_cfg(bl_hw,_BUTTON,0xffff)            // enable all [BUTTON:] events
 //     bl_cfg(bl_hw,_BUTTON,0x0000)            // disable all [BUTTON:] events
@@ -34,6 +35,7 @@
   #define BL_CLICK   0x0008  // mask for [BUTTON:CLICK] events
   #define BL_HOLD    0x0010  // mask for [BUTTON:HOLD] events
   #define BL_MULTI   0x0018  // mask for [BUTTON:CLICK],[BUTTON:HOLD]
+  #define BL_COMBO   0x0020  // mask for [BUTTON:COMBO] (else: CLICK)
   #define BL_ALL     0xFFFF  // mask for all [BUTTON:] events
   #define BL_NONE    0x0000  // mask for no [BUTTON:] events
 
@@ -52,15 +54,28 @@
 // [LED:op] message definition
 // - [LED:SET @id,onoff] set LED @id on/off (i=0..4)
 // - [LED:TOGGLE @id] toggle LED @id (i=0..4)
+// - [LED:MASK @mask,bits] set all LEDs @i with bit i of mask to bit i of bits
+//   at once (bits=-1: toggle all LEDs @i with bit i of mask)
+// - [LED:SEQ @id,<BL_seq>] run blink pattern <BL_seq> on LED @id (bl_seq.h),
+//   <NULL> stops the pattern
 //==============================================================================
 
   #define LED_SET_id_0_onoff      BL_ID(_LED,SET_)
   #define LED_TOGGLE_id_0_0       BL_ID(_LED,TOGGLE_)
+  #define LED_MASK_mask_0_bits    BL_ID(_LED,MASK_)
+  #define LED_SEQ_id_BL_seq_0     BL_ID(_LED,SEQ_)
 
     // augmented messages
 
   #define _LED_SET_id_0_onoff     _BL_ID(_LED,SET_)
   #define _LED_TOGGLE_id_0_0      _BL_ID(_LED,TOGGLE_)
+  #define _LED_MASK_mask_0_bits   _BL_ID(_LED,MASK_)
+  #define _LED_SEQ_id_BL_seq_0    _BL_ID(_LED,SEQ_)
+
+    // LED masks for [LED:MASK @mask,bits]
+
+  #define BL_LED(id)              (1 << (id))   // mask bit of LED @id
+  #define BL_RGB                  0x001C        // RGB LEDs @2,@3,@4
 
 //==============================================================================
 // [BUTTON:op] message definition
@@ -68,6 +83,7 @@
 // - [BUTTON:RELEASE @id,ms] button @id released after ms-time
 // - [BUTTON:CLICK @id,cnt] button @id clicked (cnt: number of clicks)
 // - [BUTTON:HOLD @id,ms] button @id held (ms: hold ms-time)
+// - [BUTTON:COMBO @id,cnt] cnt%256 clicks of @id while button cnt/256 held
 // - [BUTTON:CFG mask] config button module
 // - [BUTTON:CFG mask] set click/hold discrimination time
 //==============================================================================
@@ -76,6 +92,7 @@
   #define BUTTON_RELEASE_id_0_ms  BL_ID(_BUTTON,RELEASE_)
   #define BUTTON_CLICK_id_0_cnt   BL_ID(_BUTTON,CLICK_)
   #define BUTTON_HOLD_id_0_ms     BL_ID(_BUTTON,HOLD_)
+  #define BUTTON_COMBO_id_0_cnt   BL_ID(_BUTTON,COMBO_)
   #define BUTTON_CFG_0_0_mask     BL_ID(_BUTTON,CFG_)
   #define BUTTON_MS_0_0_ms        BL_ID(_BUTTON,MS_)
 
@@ -85,6 +102,7 @@
   #define _BUTTON_RELEASE_id_0_ms _BL_ID(_BUTTON,RELEASE_)
   #define _BUTTON_CLICK_id_0_cnt  _BL_ID(_BUTTON,CLICK_)
   #define _BUTTON_HOLD_id_0_ms    _BL_ID(_BUTTON,HOLD_)
+  #define _BUTTON_COMBO_id_0_cnt  _BL_ID(_BUTTON,COMBO_)
   #define _BUTTON_CFG_0_0_mask    _BL_ID(_BUTTON,CFG_)
   #define _BUTTON_MS_0_0_ms       _BL_ID(_BUTTON,MS_)
 
@@ -182,5 +200,6 @@
 //==============================================================================
 
   int bl_hw(BL_ob *o, int val);        // HW core module interface
+  extern const BL_dispatch bl_hw_ifc;  // dispatch table (introspection)
 
 #endif // __BL_HW_H__
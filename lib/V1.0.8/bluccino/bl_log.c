@@ -8,8 +8,11 @@
 
 #include <stdarg.h>
 #include <stdint.h>
-#include <usb/usb_device.h>
-#include <drivers/uart.h>
+#include <stddef.h>
+#ifdef __ZEPHYR__
+  #include <usb/usb_device.h>
+  #include <drivers/uart.h>
+#endif
 
 #include "bluccino.h"
 
@@ -18,7 +21,7 @@
 #endif
 
   static BL_txt color = "";            // text color for time header
-  static int debug = 4;                // debug level
+  static int debug = CFG_LOG_VERBOSE;  // debug level
 
 //==============================================================================
 // include Bluccino RTL stuff if activated
@@ -26,146 +29,491 @@
 //==============================================================================
 
 #if (CFG_BLUCCINO_RTL)
+#if (!CFG_RTL_DEFERRED)
   static void now(int *pmin, int *psec, int *pms, int *pus);  // split us time
+#endif
 
-  
-  BL_rtl bl_rtl, bl_rtl_prt;
 //==============================================================================
-// log fifo
+// log ring (lock-free MPSC ring of log records, see bl_ring.h)
+// - text mode: records are zero terminated text lines
+// - deferred mode: records are BL_dlog records (used argument words only)
+// - producers (ISRs, work queues, main loop) never mask interrupts
 //==============================================================================
 
-  #define NLFIFO 50                              // number of logs in fifo
+  BL_RING(lring,CFG_RTL_RING);               // THE log ring
+  BL_RING(pring,CFG_RTL_PRIO_RING);          // priority lane (errors)
 
-  typedef struct FA_lfifo                        // log fifo
-          {
-            BL_rtl fifo[NLFIFO];                 // to store log data
-            uint8_t len;                         // fifo length
-            uint8_t gdx;                         // get index
-            uint8_t pdx;                         // put index
-            volatile uint8_t free;               // number of free fifo items
-          } FA_lfifo;                            // log fifo
+  static void workhorse(struct k_work *work);
+  K_WORK_DEFINE(print_work, workhorse);      // assign work buffer with workhorse
 
-    // THE log fifo
+  static bool putr(BL_ring *ring, const void *head, int hlen,
+                   const void *body, int blen)   // put header & body record
+  {
+    uint8_t *p = bl_ring_reserve(ring,hlen+blen);
+    if (!p)
+      return false;                          // dropped (counted by ring)
+
+    memcpy(p,head,hlen);
+    if (blen)
+      memcpy(p+hlen,body,blen);
+    bl_ring_commit(ring,p);
+    k_work_submit(&print_work);              // continue at workhorse()
+    return true;
+  }
 
-  static FA_lfifo lfifo = { len: NLFIFO, gdx:0, pdx:0, free: NLFIFO };
-  static int drops = 0;                         // drop counter for log messages
+  static void put(const void *data, int len) // put record into log ring
+  {
+    putr(&lring,data,len,NULL,0);
+  }
 
 //==============================================================================
-// get FA_rtl data from log fifo
-// - usage: err = fc_lfifo_get(p)      // return 0:OK, -1:error
+// storm protection: fold identical consecutive lines, per area rate limit
+// - all state is updated with atomics, producers never mask interrupts
 //==============================================================================
 
-  int fc_lfifo_get(BL_rtl *p)
+  #if (CFG_RTL_FOLD)
+    static uint32_t folded = 0;              // pending repeat count
+    static uint32_t fold_hash = 0;           // hash of last line put
+
+    static void fold_expired(struct k_timer *timer)
+    {
+      k_work_submit(&print_work);            // workhorse flushes repeat count
+    }
+
+    K_TIMER_DEFINE(fold_timer, fold_expired, NULL);   // repeat count flush
+  #endif
+  static uint32_t limited = 0;               // lines suppressed by rate limit
+
+  #if (CFG_RTL_RATE > 0)
+    static struct { uint32_t stamp, tokens; } bucket[BL_AREAS] =
+      { [0 ... BL_AREAS-1] = {0,CFG_RTL_BURST} };   // token bucket per area
+  #endif
+
+  static uint32_t fnv(uint32_t h, const void *data, int len)   // FNV-1a hash
+  {
+    const uint8_t *p = data;
+    for (int i=0; i < len; i++)
+      h = (h ^ p[i]) * 16777619u;
+    return h;
+  }
+
+  #if (CFG_RTL_FOLD)
+    static void repeated(uint32_t n);        // put repeat notification
+  #endif
+
+  static bool admit(int area)                // take a token from area bucket
+  {
+  #if (CFG_RTL_RATE > 0)
+    if (area < 0 || area >= BL_AREAS)
+      area = BL_AREA_ANY;
+
+    uint32_t *pt = &bucket[area].tokens;
+    uint32_t ms = (uint32_t)bl_ms();
+    uint32_t stamp = __atomic_load_n(&bucket[area].stamp,__ATOMIC_RELAXED);
+    uint32_t dt = ms - stamp;                // refill by elapsed time
+    uint32_t add = (dt >= 1000*CFG_RTL_BURST/CFG_RTL_RATE) ? CFG_RTL_BURST
+                                                          : dt*CFG_RTL_RATE/1000;
+    uint32_t next = (add == CFG_RTL_BURST) ? ms
+                                           : stamp + add*1000/CFG_RTL_RATE;
+
+    if (add && __atomic_compare_exchange_n(&bucket[area].stamp,&stamp,next,
+                              false,__ATOMIC_RELAXED,__ATOMIC_RELAXED))
+    {
+      uint32_t t = __atomic_load_n(pt,__ATOMIC_RELAXED);
+      while (!__atomic_compare_exchange_n(pt,&t,
+                 t+add < CFG_RTL_BURST ? t+add : CFG_RTL_BURST,
+                 false,__ATOMIC_RELAXED,__ATOMIC_RELAXED))
+        ;                                    // refill, clipped to burst
+    }
+
+    uint32_t t = __atomic_load_n(pt,__ATOMIC_RELAXED);
+    while (t > 0)
+      if (__atomic_compare_exchange_n(pt,&t,t-1,
+                                      false,__ATOMIC_RELAXED,__ATOMIC_RELAXED))
+        return true;
+    return false;                            // bucket empty
+  #else
+    return true;
+  #endif
+  }
+
+  static bool storm(int area, uint32_t hash) // true: don't put line
   {
-//    if (fl_dbg(6))
-//      bl_prt(BL_C"lfifo: get(%d)\n",lfifo.len-lfifo.free);
+  #if (CFG_RTL_FOLD)
+    hash = hash ? hash : 1;                  // 0 means 'no last line'
+    if (__atomic_exchange_n(&fold_hash,hash,__ATOMIC_RELAXED) == hash)
+    {
+      if (__atomic_add_fetch(&folded,1,__ATOMIC_RELAXED) == 1)
+        k_timer_start(&fold_timer,K_MSEC(CFG_RTL_FOLD_FLUSH),K_NO_WAIT);
+      return true;                           // same as last line: fold
+    }
 
-    if (lfifo.free == lfifo.len)
-      return -1;                            // no more log data in fifo
+    uint32_t n = __atomic_exchange_n(&folded,0,__ATOMIC_RELAXED);
+    if (n)
+      repeated(n);                           // flush repeat count first
+  #endif
 
-    BL_rtl *q = lfifo.fifo + lfifo.gdx;
-    lfifo.gdx = (lfifo.gdx + 1) % lfifo.len;// cyclic increment of get index
+    if (admit(area))
+      return false;
 
-    memcpy(p,q,sizeof(BL_rtl));             // copy log data from fifo
-    lfifo.free++;                           // another one fifo cell went free
-    return 0;                               // OK
+    __atomic_add_fetch(&limited,1,__ATOMIC_RELAXED);
+  #if (CFG_RTL_FOLD)                         // never fold onto a dropped line
+    __atomic_compare_exchange_n(&fold_hash,&hash,0,
+                                false,__ATOMIC_RELAXED,__ATOMIC_RELAXED);
+  #endif
+    return true;
   }
 
 //==============================================================================
-// put FA_rtl data to log fifo
-// - usage: err = fc_lfifo_put(p)      // return 0:OK, -1:error
+// emit log records
 //==============================================================================
+#if (CFG_RTL_DEFERRED)
+
+  static int hue = 0;                          // header color code
+
+  #if (CFG_RTL_BINARY)
+
+    __weak void bl_rtl_write(const void *data, int len)   // raw output
+    {
+      const uint8_t *p = data;
+      for (int i=0; i < len; i++)
+        printk("%c",p[i]);
+    }
+
+    static void emit(BL_dlog *r)               // emit binary record frame
+    {
+      static const char *anchor = BL_DLOG_ANCHOR;
+      static bool session = false;
+      uint8_t frame[2+2*sizeof(void*) + 3 + 4*CFG_RTL_WORDS];
+      int len = 0;
+
+        // a frame is written with one bl_rtl_write() call, so that it cannot
+        // be split by printk() output of other threads
+
+      if (!session)                            // session frame sent once
+      {
+        frame[len++] = BL_DLOG_SESSION;
+        frame[len++] = sizeof(void*);
+        memcpy(frame+len,&anchor,sizeof(anchor));  len += sizeof(anchor);
+        session = true;
+      }
+
+      frame[len++] = BL_DLOG_RECORD;
+      frame[len++] = r->flags;
+      frame[len++] = r->words;
+      memcpy(frame+len,&r->fmt,sizeof(r->fmt));  len += sizeof(r->fmt);
+      memcpy(frame+len,r->arg,r->words*sizeof(uint32_t));
+      len += r->words*sizeof(uint32_t);
+
+      bl_rtl_write(frame,len);
+    }
+
+  #else
+
+    static const char *strmap(uint64_t addr)   // target string address
+    {
+      return (const char*)(uintptr_t)addr;     // strings are in our memory
+    }
 
-  int fc_lfifo_put(BL_rtl *p)
+    static void emit(BL_dlog *r)               // format & print log record
+    {
+      static char buf[CFG_RTL_LINE];
+      bl_dlog_format(buf,sizeof(buf),r,sizeof(void*),strmap);
+      bl_prt("%s",buf);
+    }
+
+  #endif
+
+  static void dropped(int drops)               // emit drop notification
   {
-//    if (fl_dbg(6))
-//      bl_prt(BL_C"lfifo: put(%d)\n",lfifo.len-lfifo.free+1);
+    BL_dlog r = {BL_R"*** %d messages dropped",BL_DLOG_EOL,1,{drops}};
+    emit(&r);
+  }
 
-    if (lfifo.free == 0)
-      return -1;                            // log fifo full
+  static void suppressed(int lines)            // emit rate limit notification
+  {
+    BL_dlog r = {BL_Y"*** %d lines suppressed (rate limit)",BL_DLOG_EOL,1,
+                 {lines}};
+    emit(&r);
+  }
 
-    BL_rtl *q = lfifo.fifo + lfifo.pdx;     // pointer to free fifo cell
-    lfifo.pdx = (lfifo.pdx + 1) % NLFIFO;   // cyclic increment of put index
+#if (CFG_RTL_FOLD)
+  static void repeated(uint32_t n)             // put repeat notification
+  {
+    BL_dlog r = {BL_Y"*** last message repeated %d times",BL_DLOG_EOL,1,{n}};
+    put(&r,offsetof(BL_dlog,arg) + r.words*sizeof(uint32_t));
+  }
+#endif
 
-    memcpy(q,p,sizeof(BL_rtl));             // copy log data into fifo
-    lfifo.free--;
-    return 0;
+  static void entry(uint8_t *p, int len)       // emit all records of an entry
+  {
+    for (int i=0; i < len; )
+    {
+      BL_dlog r;                               // aligned copy of the record
+      memcpy(&r,p+i,offsetof(BL_dlog,arg));
+      int n = offsetof(BL_dlog,arg) + r.words*sizeof(uint32_t);
+      memcpy(&r,p+i,n);
+      emit(&r);
+      i += n;
+    }
   }
 
-//==============================================================================
-// how many <FA_rtl> data entries are in fifo?
-// - usage: n = fc_lfifo_avail()            // return number of available
-//==============================================================================
+#else
 
-  int fc_lfifo_avail(void)
+  static void emit(char *text)                 // print text record
   {
-    return (lfifo.len - lfifo.free);
+    bl_prt("%s",text);
   }
 
-//==============================================================================
-// is fifo full?
-// - usage: full = fc_lfifo_full()            // return true if fifo is full
-//==============================================================================
+  static void dropped(int drops)               // print drop notification
+  {
+    bl_prt(BL_R"*** %d messages dropped\n"BL_0,drops);
+  }
 
-  bool fc_lfifo_full(void)
+  static void suppressed(int lines)            // print rate limit notification
   {
-    return (lfifo.free == 0);
+    bl_prt(BL_Y"*** %d lines suppressed (rate limit)\n"BL_0,lines);
   }
 
+#if (CFG_RTL_FOLD)
+  static void repeated(uint32_t n)             // put repeat notification
+  {
+    char buf[64];
+    int len = snprintf(buf,sizeof(buf),
+                       BL_Y"*** last message repeated %u times\n"BL_0,n);
+    put(buf,len+1);
+  }
+#endif
+
+  static void entry(uint8_t *p, int len)       // print text entry
+  {
+    emit((char*)p);
+  }
+
+#endif
 //==============================================================================
-// increase the log drop counter
-// - usage: drops = fc_lfifo_drop(0)     // read number of drops and clear drops
-//          fc_lfifo_drop(1)             // increment drops counter
+// print work horse - send log records of log ring to bl_prt (single consumer)
+// - K_WORK_DEFINE(print_work,workhorse); // assign print work with work horse
 //==============================================================================
 
-  int fc_lfifo_drop(int mode)
+  static void drain(BL_ring *ring)            // emit all entries of a ring
   {
-    if(!mode)                           // read number of drops and clear drops
+    void *p;
+    int len;
+    while ((p = bl_ring_peek(ring,&len)))
     {
-      int drop_cnt = drops;
-      drops = 0;
-      return drop_cnt;
+      entry(p,len);
+      bl_ring_free(ring);
     }
-    else                                // increment drops counter
+  }
+
+  static void workhorse(struct k_work *work)
+  {
+    bl_ring_drops(&pring,true);               // printed directly if lane full
+    int drops = bl_ring_drops(&lring,true);   // read and clear drop counter
+    if (drops)
+      dropped(drops);
+
+    int lines = __atomic_exchange_n(&limited,0,__ATOMIC_RELAXED);
+    if (lines)
+      suppressed(lines);
+
+    drain(&pring);                            // priority lane first
+
+    void *p;
+    int len;
+    for (;;)
     {
-        drops++;
-        return drops;
+      while ((p = bl_ring_peek(&lring,&len))) // next committed log record
+      {
+        entry(p,len);
+        bl_ring_free(&lring);
+        drain(&pring);                        // errors overtake pending lines
+      }
+
+    #if (CFG_RTL_FOLD)                        // ring idle: flush repeat count
+      uint32_t n = __atomic_exchange_n(&folded,0,__ATOMIC_RELAXED);
+      if (n)
+      {
+        repeated(n);                          // puts a line into the ring
+        continue;
+      }
+    #endif
+      break;
     }
   }
+
 //==============================================================================
-// print work horse - send fifo logs data bl_prt
-// - K_WORK_DEFINE(print_work,workhorse); // assign print work with work horse
+// RTL log: store a log record in the log ring (no interrupt masking)
+// - usage: bl_rtl_log(BL_DLOG_EOL,"%d",val)    // flags & printf arguments
 //==============================================================================
+#if (CFG_RTL_DEFERRED)
 
-  static void workhorse(struct k_work *work)
+  static void capture(BL_dlog *r, int flags, const char *fmt, va_list ap)
+  {
+    r->fmt = fmt;  r->flags = flags;  r->words = 0;
+
+    for (const char *f = fmt; *f; )
+    {
+      if (*f != '%')
+      {
+        f++;
+        continue;
+      }
+
+      char spec[16];
+      BL_dlarg type;
+      f = bl_dlog_spec(f,spec,sizeof(spec),&type);
+
+      union { int i; long l; long long ll; void *p; double d; } v;
+
+      switch (type)
+      {
+        case BL_DLARG_NONE:  continue;
+        case BL_DLARG_INT:   v.i = va_arg(ap,int);  break;
+        case BL_DLARG_LONG:  v.l = va_arg(ap,long);  break;
+        case BL_DLARG_LLONG: v.ll = va_arg(ap,long long);  break;
+        case BL_DLARG_PTR:   v.p = va_arg(ap,void*);  break;
+        case BL_DLARG_DBL:   v.d = va_arg(ap,double);  break;
+        default:             return;  // unsupported spec: stop capturing
+      }
+
+      int bytes = bl_dlog_size(type,sizeof(void*));
+      int n = (bytes+3)/4;
+      if (r->words + n > CFG_RTL_WORDS)
+      {
+        r->flags |= BL_DLOG_TRUNC;     // no more room for args
+        return;
+      }
+      memcpy(r->arg + r->words,&v,bytes);
+      r->words += n;
+    }
+  }
+
+  void bl_rtl_log(int flags, const char *fmt, ...)
+  {
+    BL_dlog r;                         // compact record on the stack
+    va_list ap;
+    va_start(ap,fmt);
+    capture(&r,flags,fmt,ap);
+    va_end(ap);
+
+    put(&r,offsetof(BL_dlog,arg) + r.words*sizeof(uint32_t));
+  }
+
+  static int header(BL_dlog *h, int lev)     // header record, return length
   {
-    int drops = fc_lfifo_drop(0);       // read number of drops and clear drops
-    if(drops)
-      bl_prt(BL_R"*** %d messages dropped\n",drops);
+    BL_us us = bl_us();                // raw us-time stamp, formatted later
+    *h = (BL_dlog){NULL, BL_DLOG_HDR | hue, 3,
+                   {(uint32_t)lev, (uint32_t)us, (uint32_t)(us >> 32)}};
+    return offsetof(BL_dlog,arg) + h->words*sizeof(uint32_t);
+  }
+
+  static void line(BL_ring *ring, int area, int lev, int flags,
+                   const char *fmt, va_list ap)   // header & body as one entry
+  {
+    BL_dlog h, r;
+    int hlen = header(&h,lev);
+    capture(&r,flags,fmt,ap);
+    int blen = offsetof(BL_dlog,arg) + r.words*sizeof(uint32_t);
+
+    if (ring == &lring)                // storm protection (not for errors)
+    {
+      uint32_t hash = fnv(2166136261u,&r.fmt,sizeof(r.fmt));
+      hash = fnv(hash,r.arg,r.words*sizeof(uint32_t));
+      hash = fnv(hash,(uint8_t[]){r.flags,lev,area},3);
+      if (storm(area,hash))
+        return;
+    }
 
-    while(fc_lfifo_avail())           // number of available log messages in fifo
+    if (!putr(ring,&h,hlen,&r,blen) && ring == &pring)
     {
-      bl_rtl_get(&bl_rtl_prt);
-      bl_prt("%s",bl_rtl_prt.buf);
+      emit(&h);  emit(&r);             // priority lane full: print directly
     }
   }
 
-  K_WORK_DEFINE(print_work, workhorse);    // assign work buffer with workhorse
+#else
+
+  static int body(char *buf, int size, int flags, const char *fmt, va_list ap)
+  {
+    int len = vsnprintf(buf,size,fmt,ap);
+
+    len = (len < size) ? len : size-1;
+    if (len >= 0 && (flags & BL_DLOG_EOL))  // like BL_LOG: color reset & LF
+      len += snprintf(buf+len,size-len,BL_0"%s",*fmt ? "\n" : "");
+
+    return (len < size) ? len : size-1;
+  }
+
+  void bl_rtl_log(int flags, const char *fmt, ...)
+  {
+    char buf[CFG_RTL_LINE];            // text line on the stack
+    va_list ap;
+    va_start(ap,fmt);
+    int len = body(buf,sizeof(buf),flags,fmt,ap);
+    va_end(ap);
+
+    if (len >= 0)
+      put(buf,len+1);                  // including terminating zero
+  }
+
+  static int header(char *buf, int size, int lev)  // return header length
+  {
+    int min, sec, ms, us;
+    now(&min,&sec,&ms,&us);
+
+      // print header in green if in attention mode,
+      // yellow if node is provisioned, otherwise white by default
+
+    int len = snprintf(buf,size,"%s#%d[%03d:%02d:%03d.%03d] " BL_0,
+                       color,lev, min,sec,ms,us);
 
-  void bl_rtl_put(BL_rtl *p)
+    for (int i=0; i < lev && len+2 < size; i++, len += 2)
+      strcpy(buf+len,"  ");            // indentation
+
+    return len;
+  }
+
+  static void line(BL_ring *ring, int area, int lev, int flags,
+                   const char *fmt, va_list ap)   // header & body as one line
   {
-    if(fc_lfifo_full())                 // cannot put message in the fifo?
-      fc_lfifo_drop(1);                 // increment drops counter
-    else
+    char buf[CFG_RTL_LINE];            // text line on the stack
+    int hlen = header(buf,sizeof(buf),lev);
+    int blen = body(buf+hlen,sizeof(buf)-hlen,flags,fmt,ap);
+    if (blen < 0)
+      return;
+
+    if (ring == &lring)                // storm protection (not for errors)
     {
-      fc_lfifo_put(p);
-      k_work_submit(&print_work);     // continue at button_workhorse()
+      uint32_t hash = fnv(2166136261u,buf+hlen,blen);
+      hash = fnv(hash,(uint8_t[]){lev,area},2);
+      if (storm(area,hash))
+        return;
     }
+
+    if (!putr(ring,buf,hlen+blen+1,NULL,0) && ring == &pring)
+      emit(buf);                       // priority lane full: print directly
   }
 
-  void bl_rtl_get(BL_rtl *p)
+#endif
+
+  void bl_rtl_line(int area, int lev, int flags, const char *fmt, ...)
   {
-    fc_lfifo_get(p);
+    if (lev > debug)
+      return;
+
+    va_list ap;
+    va_start(ap,fmt);
+    line(&lring,area,lev,flags,fmt,ap);
+    va_end(ap);
+  }
+
+  static void prio(int lev, const char *fmt, ...)  // line in priority lane
+  {
+    va_list ap;
+    va_start(ap,fmt);
+    line(&pring,BL_AREA_ANY,lev,0,fmt,ap);
+    va_end(ap);
   }
 
 //==============================================================================
@@ -174,6 +522,7 @@
 
   void bl_rtl_init(void)
   {
+  #ifdef __ZEPHYR__
     const struct device *dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_console));
     uint32_t dtr = 0;
 
@@ -187,6 +536,7 @@
       // give CPU resources to low priority threads.
       bl_sleep(100);
     }
+  #endif
     k_work_init(&print_work, workhorse);
   }
 #endif // CFG_BLUCCINO_RTL
@@ -232,12 +582,58 @@
   void bl_decorate(bool attention, bool provision)
   {
     color = attention ? BL_G : (provision ? BL_C : "");
+    #if (CFG_BLUCCINO_RTL && CFG_RTL_DEFERRED)
+      hue = attention ? BL_DLOG_GREEN : (provision ? BL_DLOG_CYAN : 0);
+    #endif
+  }
+
+//==============================================================================
+// runtime log filter
+// - bl_logmax[] caches min(area level, verbose level) for a single compare
+//==============================================================================
+
+  int8_t bl_logmax[BL_AREAS] = { [0 ... BL_AREAS-1] = CFG_LOG_VERBOSE };
+  int8_t bl_clmax[CFG_LOG_CLASSES] = { [0 ... CFG_LOG_CLASSES-1] = BL_LOGANY };
+
+  static int8_t areamax[BL_AREAS] = { [0 ... BL_AREAS-1] = BL_LOGANY };
+
+  static int8_t level8(int level)          // clip level to filter range
+  {
+    return level < BL_LOGOFF ? BL_LOGOFF : (level > BL_LOGANY ? BL_LOGANY : level);
+  }
+
+  static void logmax_update(void)          // recompute cached area levels
+  {
+    int8_t verbose = level8(debug);
+    for (int i=0; i < BL_AREAS; i++)
+      bl_logmax[i] = areamax[i] < verbose ? areamax[i] : verbose;
+  }
+
+  int bl_logfilt(int id, int level)        // set filter level, return old one
+  {
+    int old = -2;                          // -2: bad filter ID
+
+    if (id == BL_LOGALL)
+      return bl_verbose(level);
+    else if ((id & BL_LOGCL(0)) && (id & 0xFF) < CFG_LOG_CLASSES)
+    {
+      old = bl_clmax[id & 0xFF];
+      bl_clmax[id & 0xFF] = level8(level);
+    }
+    else if (id >= 0 && id < BL_AREAS)
+    {
+      old = areamax[id];
+      areamax[id] = level8(level);
+      logmax_update();
+    }
+    return old;
   }
 
   int bl_verbose(int verbose)              // set verbose level
   {
     int old = debug;
     debug = verbose;
+    logmax_update();
     return old;
   }
 
@@ -262,10 +658,14 @@
 
   int bl_err(int err, BL_txt msg)
   {
-    if (err)
+    if (err && debug >= 1)                      // errors come @ verbose level 1
     {
-      if (bl_dbg(1))                            // errors come @ verbose level 1
-        bl_prt(BL_R "error %d: %s\n" BL_0,err,msg);  // in RED text!
+      #if (CFG_BLUCCINO_RTL)                    // priority lane, never folded
+        prio(1,BL_R "error %d: %s\n" BL_0,err,msg);  // or rate limited
+      #else
+        if (bl_dbg(1))
+          bl_prt(BL_R "error %d: %s\n" BL_0,err,msg);  // in RED text!
+      #endif
     }
     return err;
   }
@@ -273,28 +673,18 @@
 //==============================================================================
 // get clock time as minutes, seconds, milliseconds
 //==============================================================================
+#if (!CFG_BLUCCINO_RTL || !CFG_RTL_DEFERRED)
 
   static void now(int *pmin, int *psec, int *pms, int *pus)  // split us time
   {
-    static int min = 0;
-    static int sec = 0;
-    static BL_ms offset = 0;
-    BL_us us = bl_us();                    // clock time now in us
-
-    *pus = us % 1000;                      // map us to range 0 .. 999
-    *pms = us/1000 - offset;
-
-      // calculate trace time tick
-
-    for (; *pms >= 1000; offset += 1000, sec++)
-      *pms -= 1000;
-
-    for (; sec >= 60; min++)
-      sec -= 60;
+    static BL_hms t;                       // incremental split (bl_time.h)
+    bl_hms(&t,bl_us());                    // clock time now in us
 
-    *pmin = min;  *psec = sec;
+    *pmin = t.min;  *psec = t.sec;
+    *pms = t.ms;    *pus = t.us;
   }
 
+#endif
 //==============================================================================
 // debug tracing
 // - this is the standard Bluccino bl_dbg() function which is used if Bluccino
@@ -323,27 +713,29 @@
     return true;
   }
 
-#else
+#elif (CFG_RTL_DEFERRED)
 
   bool bl_dbg(int lev)
   {
     if (lev > debug)
       return false;
 
-    int min, sec, ms, us;
-    now(&min,&sec,&ms,&us);
+      // header record with level and raw us-time stamp, formatted later
 
-      // print header in green if in attention mode,
-      // yellow if node is provisioned, otherwise white by default
-    bl_irq(0);
-    sprintf(bl_rtl.buf, "%s#%d[%03d:%02d:%03d.%03d] " BL_0, color,lev, min,sec,ms,us);
+    BL_dlog r;
+    put(&r,header(&r,lev));
+    return true;
+  }
 
-    for (int i=0; i < lev; i++)
-      strcat(bl_rtl.buf,"  ");                   // indentation
+#else
 
-    bl_rtl_put(&bl_rtl);
-    bl_irq(1);
+  bool bl_dbg(int lev)
+  {
+    if (lev > debug)
+      return false;
 
+    char buf[CFG_RTL_LINE];
+    put(buf,header(buf,sizeof(buf),lev)+1);
     return true;
   }
 #endif
@@ -362,7 +754,7 @@
   {
     static BL_txt text[] = BL_OP_TEXT;
     op = (op < 0) ? -op : op;
-    return (op < BL_LENGTH(text)) ? text[op] : "???";
+    return (op < (int)BL_LENGTH(text)) ? text[op] : "???";
   }
 
 #endif
@@ -370,22 +762,41 @@
 // log messages
 //==============================================================================
 
+  #if (CFG_BLUCCINO_RTL)
+    #define LOGO_PRT(...)  bl_rtl_line(area,lev,0,__VA_ARGS__)  // log line
+  #else
+    #define LOGO_PRT(...)  bl_prt(__VA_ARGS__)
+  #endif
+
   void bl_logo(int lev, BL_txt msg, BL_ob *o, int value) // log event message
   {
-    if ( !bl_dbg(lev) )
-     return;
+    bl_logoa(BL_AREA_ANY,lev,msg,o,value);
+  }
 
-    BL_txt aug = BL_ISAUG(o->cl) ? "#" : "";
+  void bl_logoa(int area, int lev, BL_txt msg, BL_ob *o, int value)
+  {
     BL_cl cl = BL_UNAUG(o->cl);
+    area = (area >= 0 && area < BL_AREAS) ? area : BL_AREA_ANY;
+    if (lev > bl_logmax[area])
+      return;                          // above level of log area
+    if (cl < CFG_LOG_CLASSES && lev > bl_clmax[cl])
+      return;                          // message class filtered
+
+    #if (!CFG_BLUCCINO_RTL)            // RTL: header is part of the log line
+      if ( !bl_dbg(lev) )
+       return;
+    #endif
+
+    BL_txt aug = BL_ISAUG(o->cl) ? "#" : "";
 
     BL_txt col = (msg[0] != '@') ? "" : (value ? BL_G : BL_M);
     msg = (msg[0] == '@') ? msg+1 : msg;
 
     #if CFG_PRETTY_LOGGING             // pretty text for class tag & opcode
-      bl_prt("%s%s [%s%s:%s @%d,%d]\n"BL_0, col,msg,
-             aug,cltext(cl), optext(o->op), o->id,value);
+      LOGO_PRT("%s%s [%s%s:%s @%d,%d]\n"BL_0, col,msg,
+               aug,cltext(cl), optext(o->op), o->id,value);
     #else
-      bl_prt("%s%s [%s%d:%d @%d,%d]\n"BL_0,col,msg,
-             aug,cl, o->op, o->id,value);
+      LOGO_PRT("%s%s [%s%d:%d @%d,%d]\n"BL_0,col,msg,
+               aug,cl, o->op, o->id,value);
     #endif
   }
@@ -26,6 +26,68 @@
   #define LOG0(lvl,col,o,val)     LOGO_XYZ(lvl,col,o,val)
 
 #endif
+//==============================================================================
+// runtime log filter (per log area and per message class)
+// - each log area (LOG_GEAR, LOG_NVM, ...) has a max level in bl_logmax[],
+//   which is min(area level, verbose level): a filtered log line costs one
+//   compare, no time formatting and no printing
+// - bl_logo() additionally checks the max level of the message class
+// - levels above CFG_LOG_MAXLEVEL are removed at compile time (log line and
+//   format string), e.g. CFG_LOG_MAXLEVEL=1 for production builds
+// - usage: bl_logfilt(BL_AREA_GEAR,1)        // GEAR logging up to level 1
+//          bl_logfilt(BL_LOGCL(_BUTTON),-1)  // mute [BUTTON:] messages
+//          bl_logfilt(BL_LOGALL,3)           // same as bl_verbose(3)
+//          bl_msg((bluccino),_SYS,LOG_, BL_AREA_NVM,NULL,-1) // [SYS:LOG]
+//==============================================================================
+
+  #ifndef CFG_LOG_MAXLEVEL
+    #define CFG_LOG_MAXLEVEL    9      // higher levels compile to nothing
+  #endif
+
+  #ifndef CFG_LOG_VERBOSE
+    #define CFG_LOG_VERBOSE     4      // initial verbose level
+  #endif
+
+  #ifndef CFG_LOG_CLASSES
+    #define CFG_LOG_CLASSES    32      // message classes with own filter
+  #endif
+
+  typedef enum BL_area                 // log areas
+          {
+            BL_AREA_ANY = 0,           // BL_LOG, bl_log (verbose level only)
+            BL_AREA_APP,
+            BL_AREA_BUTTON,
+            BL_AREA_CORE,
+            BL_AREA_GEAR,
+            BL_AREA_GPIO,
+            BL_AREA_LED,
+            BL_AREA_MAIN,
+            BL_AREA_MESH,
+            BL_AREA_NVM,
+            BL_AREA_TEST,
+            BL_AREA_TIME,
+            BL_AREA_RUN,
+            BL_AREA_RESET,
+            BL_AREA_NODE,
+            BL_AREA_MPUB,
+            BL_AREAS                   // number of log areas
+          } BL_area;
+
+  #define BL_LOGCL(cl)    (0x100 | (cl))   // filter ID of a message class
+  #define BL_LOGALL       (-1)         // filter ID of the verbose level
+  #define BL_LOGOFF       (-1)         // filter level: mute
+  #define BL_LOGANY       127          // filter level: no limit
+
+  extern int8_t bl_logmax[BL_AREAS];   // max level per area (incl. verbose)
+  extern int8_t bl_clmax[CFG_LOG_CLASSES];  // max level per message class
+
+  static inline bool bl_logon(int area, int lev)
+  {
+    return lev <= CFG_LOG_MAXLEVEL && lev <= bl_logmax[area];
+  }
+
+  int bl_logfilt(int id, int level);   // set filter level, return old level
+
 //==============================================================================
 // generic log function
 // - the whole macro is a weird construction, but it fulfills what expected!
@@ -35,106 +97,147 @@
 #if (CFG_BLUCCINO_RTL)
 
     //==============================================================================
-    // BL_rtl (real time log)
+    // RTL config defaults
+    // - CFG_RTL_DEFERRED: log ring stores format pointer & raw args (BL_dlog)
+    //   records, which are formatted later by the RTL print work horse
+    // - CFG_RTL_BINARY: deferred records are output as binary frames, to be
+    //   decoded on the host (host/bl_logdec)
+    // - CFG_RTL_RING: size of the lock-free log ring (power of 2)
+    // - CFG_RTL_LINE: max length of a text log line (incl. terminating zero)
     //==============================================================================
 
-    typedef struct BL_rtl
-    {
-        char buf[200];          // log buffer
-        volatile bool busy;
-        volatile int len;
-    } BL_rtl;
+    #ifndef CFG_RTL_DEFERRED
+      #define CFG_RTL_DEFERRED  0      // deferred (binary) logging off
+    #endif
 
-    extern BL_rtl bl_rtl;
+    #ifndef CFG_RTL_BINARY
+      #define CFG_RTL_BINARY    0      // output formatted text by default
+    #endif
 
-    void bl_rtl_get(BL_rtl *p);
-    void bl_rtl_put(BL_rtl *p);
-    //==============================================================================
-    // debug tracing
-    //==============================================================================
+    #if (CFG_RTL_BINARY && !CFG_RTL_DEFERRED)
+      #error "CFG_RTL_BINARY requires CFG_RTL_DEFERRED"
+    #endif
 
-    // bool bl_dbg(int lev);
+    #ifndef CFG_RTL_RING
+      #define CFG_RTL_RING      4096   // log ring size in bytes (power of 2)
+    #endif
+
+    #ifndef CFG_RTL_LINE
+      #define CFG_RTL_LINE      200    // max text log line length
+    #endif
 
     //==============================================================================
-    // generic log function
-    // - the whole macro is a weird construction, but it fulfills what expected!
-    // - the outer do {..} while(0) construct seems weird, but it allows a syntax:
-    // - if (condition) BL_LOG(1,"..."); else BL_LOG(1,"...");
+    // RTL storm protection (log lines of BL_LOGA/LOG_<X> and bl_logo)
+    // - CFG_RTL_FOLD: identical consecutive lines (same area, level, format
+    //   and arguments) are folded into a "last message repeated N times" line
+    // - CFG_RTL_RATE/CFG_RTL_BURST: per log area token bucket, lines beyond
+    //   the rate are suppressed and reported as "N lines suppressed"
+    // - CFG_RTL_PRIO_RING: errors (bl_err) take a priority lane, which is
+    //   neither folded nor rate limited and is printed first (if the lane is
+    //   full, the error is printed directly, so errors are never dropped)
     //==============================================================================
 
-        #define BL_LOG(lvl,fmt,...)                  \
-            do                                      \
-            {                                       \
-                if (bl_dbg(lvl))                     \
-                {                                    \
-                bl_irq(0);                         \
-                bl_rtl.len = sprintf(bl_rtl.buf, fmt BL_0, ##__VA_ARGS__); \
-                if (*fmt) sprintf(bl_rtl.buf+bl_rtl.len, "\n");  \
-                bl_rtl_put(&bl_rtl);          \
-                bl_irq(1);                         \
-                }                                    \
-            } while(0)
+    #ifndef CFG_RTL_FOLD
+      #define CFG_RTL_FOLD      1      // fold identical consecutive lines
+    #endif
 
-        #define bl_log(l,f,...)  BL_LOG(l,f,##__VA_ARGS__)  // always enabled
+    #ifndef CFG_RTL_FOLD_FLUSH
+      #define CFG_RTL_FOLD_FLUSH 100   // max delay of a repeat count (ms)
+    #endif
+
+    #ifndef CFG_RTL_RATE
+      #define CFG_RTL_RATE      50     // lines per second per area (0: off)
+    #endif
+
+    #ifndef CFG_RTL_BURST
+      #define CFG_RTL_BURST     20     // max burst of lines per area
+    #endif
+
+    #ifndef CFG_RTL_PRIO_RING
+      #define CFG_RTL_PRIO_RING 1024   // priority lane size (power of 2)
+    #endif
+
+    #include "bl_dlog.h"
+    #include "bl_ring.h"
 
     //==============================================================================
-    // bl_rtl_init: initializes real time logging.
+    // debug tracing
     //==============================================================================
 
-    void bl_rtl_init(void);
+    // bool bl_dbg(int lev);
 
-    
     //==============================================================================
-    // get BL_rtl data from log fifo
-    // - usage: err = fc_bfifo_get(p)      // return 0:OK, -1:error
+    // RTL log: store a log record (text line or deferred record) in the
+    // lock-free log ring, to be printed by the RTL print work horse
+    // - usage: bl_rtl_log(BL_DLOG_EOL,"%d",val)    // flags & printf arguments
     //==============================================================================
 
-    int fc_lfifo_get(BL_rtl *p);
+    void bl_rtl_log(int flags, const char *fmt, ...);
 
     //==============================================================================
-    // put BL_rtl data to log fifo
-    // - usage: err = fc_bfifo_put(p)      // return 0:OK, -1:error
+    // RTL log line: time stamp header and text as one record of a log area,
+    // subject to level check and storm protection
+    // - usage: bl_rtl_line(BL_AREA_GEAR,lev,BL_DLOG_EOL,"%d",val)
     //==============================================================================
 
-    int fc_lfifo_put(BL_rtl *p);
+    void bl_rtl_line(int area, int lev, int flags, const char *fmt, ...);
 
     //==============================================================================
-    // how many <BL_rtl> data entries are in fifo?
-    // - usage: n = fc_bfifo_avail()            // return number of available
+    // raw output of binary log frames (CFG_RTL_BINARY, weak default: printk)
+    // - usage: bl_rtl_write(data,len)
     //==============================================================================
 
-    int fc_lfifo_avail(void);            // return number of available <BL_rtl>
+    void bl_rtl_write(const void *data, int len);
 
     //==============================================================================
-    // is fifo full?
-    // - usage: full = fc_lfifo_full()            // return true if fifo is full
+    // generic log function
+    // - the whole macro is a weird construction, but it fulfills what expected!
+    // - the outer do {..} while(0) construct seems weird, but it allows a syntax:
+    // - if (condition) BL_LOG(1,"..."); else BL_LOG(1,"...");
     //==============================================================================
 
-    bool fc_lfifo_full(void);
+        #define BL_LOGA(area,lvl,fmt,...)            \
+            do                                      \
+            {                                       \
+                if (bl_logon(area,lvl))              \
+                    bl_rtl_line(area,lvl,BL_DLOG_EOL, fmt, ##__VA_ARGS__); \
+            } while(0)
+
+        #define BL_LOG(lvl,fmt,...)  BL_LOGA(BL_AREA_ANY,lvl,fmt,##__VA_ARGS__)
+
+        #define bl_log(l,f,...)  BL_LOG(l,f,##__VA_ARGS__)  // always enabled
 
     //==============================================================================
-    // increase the log drop counter
-    // - usage: drops = fc_lfifo_drop(0)     // read number of drops and clear drops
-    //          fc_lfifo_drop(1)             // increment drops counter
+    // bl_rtl_init: initializes real time logging.
     //==============================================================================
 
-    int fc_lfifo_drop(int mode);
+    void bl_rtl_init(void);
 
 #else                                  // standard log macro version
 
-        #define BL_LOG(lvl,fmt,...)                  \
+        #define BL_LOGA(area,lvl,fmt,...)            \
             do                                      \
             {                                       \
-                if (bl_dbg(lvl))                     \
+                if (bl_logon(area,lvl) && bl_dbg(lvl)) \
                 {                                    \
                     bl_prt(fmt BL_0, ##__VA_ARGS__); \
                     if (*fmt) bl_prt("\n");          \
                 }                                    \
             } while(0)
 
+        #define BL_LOG(lvl,fmt,...)  BL_LOGA(BL_AREA_ANY,lvl,fmt,##__VA_ARGS__)
+
         #define bl_log(l,f,...)  BL_LOG(l,f,##__VA_ARGS__)  // always enabled
 
 #endif // CFG_BLUCCINO_RTL
+
+        #define BL_LOGO(area,lvl,f,o,v)              \
+            do                                      \
+            {                                       \
+                if (bl_logon(area,lvl))              \
+                    bl_logoa(area,lvl,f,o,v);        \
+            } while(0)
+
 //==============================================================================
 // APP Logging
 //==============================================================================
@@ -144,8 +247,8 @@
 #endif
 
 #if (CFG_LOG_APP)
-    #define LOG_APP(l,f,...)    BL_LOG(CFG_LOG_APP-1+l,f,##__VA_ARGS__)
-    #define LOGO_APP(l,f,o,v)   bl_logo(CFG_LOG_APP-1+l,f,o,v)
+    #define LOG_APP(l,f,...)    BL_LOGA(BL_AREA_APP,CFG_LOG_APP-1+l,f,##__VA_ARGS__)
+    #define LOGO_APP(l,f,o,v)   BL_LOGO(BL_AREA_APP,CFG_LOG_APP-1+l,f,o,v)
 #else
     #define LOG_APP(l,f,...)    {}     // empty
     #define LOGO_APP(l,f,o,v)   {}     // empty
@@ -160,8 +263,8 @@
 #endif
 
 #if (CFG_LOG_BUTTON)
-    #define LOG_BUTTON(l,f,...)    BL_LOG(CFG_LOG_BUTTON-1+l,f,##__VA_ARGS__)
-    #define LOGO_BUTTON(l,f,o,v)   bl_logo(CFG_LOG_BUTTON-1+l,f,o,v)
+    #define LOG_BUTTON(l,f,...)    BL_LOGA(BL_AREA_BUTTON,CFG_LOG_BUTTON-1+l,f,##__VA_ARGS__)
+    #define LOGO_BUTTON(l,f,o,v)   BL_LOGO(BL_AREA_BUTTON,CFG_LOG_BUTTON-1+l,f,o,v)
 #else
     #define LOG_BUTTON(l,f,...)    {}     // empty
     #define LOGO_BUTTON(l,f,o,v)   {}     // empty
@@ -176,8 +279,8 @@
 #endif
 
 #if (CFG_LOG_CORE)
-    #define LOG_CORE(l,f,...)    BL_LOG(CFG_LOG_CORE-1+l,f,##__VA_ARGS__)
-    #define LOGO_CORE(l,f,o,v)   bl_logo(CFG_LOG_CORE-1+l,f,o,v)
+    #define LOG_CORE(l,f,...)    BL_LOGA(BL_AREA_CORE,CFG_LOG_CORE-1+l,f,##__VA_ARGS__)
+    #define LOGO_CORE(l,f,o,v)   BL_LOGO(BL_AREA_CORE,CFG_LOG_CORE-1+l,f,o,v)
 #else
     #define LOG_CORE(l,f,...)    {}     // empty
     #define LOGO_CORE(l,f,o,v)   {}     // empty
@@ -192,8 +295,8 @@
 #endif
 
 #if (CFG_LOG_GEAR)
-    #define LOG_GEAR(l,f,...)    BL_LOG(CFG_LOG_GEAR-1+l,f,##__VA_ARGS__)
-    #define LOGO_GEAR(l,f,o,v)   bl_logo(CFG_LOG_GEAR-1+l,f,o,v)
+    #define LOG_GEAR(l,f,...)    BL_LOGA(BL_AREA_GEAR,CFG_LOG_GEAR-1+l,f,##__VA_ARGS__)
+    #define LOGO_GEAR(l,f,o,v)   BL_LOGO(BL_AREA_GEAR,CFG_LOG_GEAR-1+l,f,o,v)
 #else
     #define LOG_GEAR(l,f,...)    {}     // empty
     #define LOGO_GEAR(l,f,o,v)   {}     // empty
@@ -208,8 +311,8 @@
 #endif
 
 #if (CFG_LOG_GPIO)
-    #define LOG_GPIO(l,f,...)    BL_LOG(CFG_LOG_GPIO-1+l,f,##__VA_ARGS__)
-    #define LOGO_GPIO(l,f,o,v)   bl_logo(CFG_LOG_GPIO-1+l,f,o,v)
+    #define LOG_GPIO(l,f,...)    BL_LOGA(BL_AREA_GPIO,CFG_LOG_GPIO-1+l,f,##__VA_ARGS__)
+    #define LOGO_GPIO(l,f,o,v)   BL_LOGO(BL_AREA_GPIO,CFG_LOG_GPIO-1+l,f,o,v)
 #else
     #define LOG_GPIO(l,f,...)    {}     // empty
     #define LOGO_GPIO(l,f,o,v)   {}     // empty
@@ -224,8 +327,8 @@
 #endif
 
 #if (CFG_LOG_LED)
-    #define LOG_LED(l,f,...)    BL_LOG(CFG_LOG_LED-1+l,f,##__VA_ARGS__)
-    #define LOGO_LED(l,f,o,v)   bl_logo(CFG_LOG_LED-1+l,f,o,v)
+    #define LOG_LED(l,f,...)    BL_LOGA(BL_AREA_LED,CFG_LOG_LED-1+l,f,##__VA_ARGS__)
+    #define LOGO_LED(l,f,o,v)   BL_LOGO(BL_AREA_LED,CFG_LOG_LED-1+l,f,o,v)
 #else
     #define LOG_LED(l,f,...)    {}     // empty
     #define LOGO_LED(l,f,o,v)   {}     // empty
@@ -240,8 +343,8 @@
 #endif
 
 #if (CFG_LOG_MAIN)
-    #define LOG_MAIN(l,f,...)    BL_LOG(CFG_LOG_MAIN-1+l,f,##__VA_ARGS__)
-    #define LOGO_MAIN(l,f,o,v)   bl_logo(CFG_LOG_MAIN-1+l,f,o,v)
+    #define LOG_MAIN(l,f,...)    BL_LOGA(BL_AREA_MAIN,CFG_LOG_MAIN-1+l,f,##__VA_ARGS__)
+    #define LOGO_MAIN(l,f,o,v)   BL_LOGO(BL_AREA_MAIN,CFG_LOG_MAIN-1+l,f,o,v)
 #else
     #define LOG_MAIN(l,f,...)    {}     // empty
     #define LOGO_MAIN(l,f,o,v)   {}     // empty
@@ -256,8 +359,8 @@
 #endif
 
 #if (CFG_LOG_MESH)
-    #define LOG_MESH(l,f,...)    BL_LOG(CFG_LOG_MESH-1+l,f,##__VA_ARGS__)
-    #define LOGO_MESH(l,f,o,v)   bl_logo(CFG_LOG_MESH-1+l,f,o,v)
+    #define LOG_MESH(l,f,...)    BL_LOGA(BL_AREA_MESH,CFG_LOG_MESH-1+l,f,##__VA_ARGS__)
+    #define LOGO_MESH(l,f,o,v)   BL_LOGO(BL_AREA_MESH,CFG_LOG_MESH-1+l,f,o,v)
 #else
     #define LOG_MESH(l,f,...)    {}    // empty
     #define LOGO_MESH(l,f,o,v)   {}    // empty
@@ -272,8 +375,8 @@
 #endif
 
 #if (CFG_LOG_NVM)
-    #define LOG_NVM(l,f,...)    BL_LOG(CFG_LOG_NVM-1+l,f,##__VA_ARGS__)
-    #define LOGO_NVM(l,f,o,v)   bl_logo(CFG_LOG_NVM-1+l,f,o,v)
+    #define LOG_NVM(l,f,...)    BL_LOGA(BL_AREA_NVM,CFG_LOG_NVM-1+l,f,##__VA_ARGS__)
+    #define LOGO_NVM(l,f,o,v)   BL_LOGO(BL_AREA_NVM,CFG_LOG_NVM-1+l,f,o,v)
 #else
     #define LOG_NVM(l,f,...)    {}     // empty
     #define LOGO_NVM(l,f,o,v)   {}     // empty
@@ -288,8 +391,8 @@
 #endif
 
 #if (CFG_LOG_TEST)
-    #define LOG_TEST(l,f,...)    BL_LOG(CFG_LOG_TEST-1+l,f,##__VA_ARGS__)
-    #define LOGO_TEST(l,f,o,v)   bl_logo(CFG_LOG_TEST-1+l,f,o,v)
+    #define LOG_TEST(l,f,...)    BL_LOGA(BL_AREA_TEST,CFG_LOG_TEST-1+l,f,##__VA_ARGS__)
+    #define LOGO_TEST(l,f,o,v)   BL_LOGO(BL_AREA_TEST,CFG_LOG_TEST-1+l,f,o,v)
 #else
     #define LOG_TEST(l,f,...)    {}     // empty
     #define LOGO_TEST(l,f,o,v)   {}     // empty
@@ -304,8 +407,8 @@
 #endif
 
 #if (CFG_LOG_TIME)
-    #define LOG_TIME(l,f,...)    BL_LOG(CFG_LOG_TIME-1+l,f,##__VA_ARGS__)
-    #define LOGO_TIME(l,f,o,v)   bl_logo(CFG_LOG_TIME-1+l,f,o,v)
+    #define LOG_TIME(l,f,...)    BL_LOGA(BL_AREA_TIME,CFG_LOG_TIME-1+l,f,##__VA_ARGS__)
+    #define LOGO_TIME(l,f,o,v)   BL_LOGO(BL_AREA_TIME,CFG_LOG_TIME-1+l,f,o,v)
 #else
     #define LOG_TIME(l,f,...)    {}     // empty
     #define LOGO_TIME(l,f,o,v)   {}     // empty
@@ -338,6 +441,7 @@
 //void bl_log1(int lev, BL_txt msg, int value);
 //void bl_log2(int lev, BL_txt msg, int id, int value);
   void bl_logo(int lev, BL_txt msg, BL_ob *o, int value);
+  void bl_logoa(int area, int lev, BL_txt msg, BL_ob *o, int value);
 
   void bl_decorate(bool attention, bool provisioned);
   int bl_verbose(int verbose);        // set verbose level
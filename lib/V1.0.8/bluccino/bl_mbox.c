@@ -0,0 +1,183 @@
+//==============================================================================
+//  bl_mbox.c
+//  asynchronous message posting via per-module mailboxes
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Each mailbox is a MPSC record ring. A record holds a copy of the BL_ob, the
+// value and optionally a copy of the <data> payload. Mailboxes link themselves
+// lock-free into a chain on their first post, the single consumer (engine or
+// work item) walks the chain and delivers at most the messages which were
+// pending when draining started, so a module which re-posts to its own
+// mailbox cannot starve the engine.
+//
+//==============================================================================
+
+  #include <string.h>
+  #include "bluccino.h"
+  #include "bl_mbox.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO "bl_mbox:"               // who is logging?
+
+  #define LOG                     LOG_RUN
+  #define LOGO(lvl,col,o,val)     LOGO_RUN(lvl,col WHO,o,val)
+
+//==============================================================================
+// atomics (GCC __atomic builtins, see bl_ring.c)
+//==============================================================================
+
+  #define LOAD(p)           __atomic_load_n(p,__ATOMIC_ACQUIRE)
+  #define STORE(p,v)        __atomic_store_n(p,v,__ATOMIC_RELEASE)
+  #define INC(p)            __atomic_add_fetch(p,1,__ATOMIC_ACQ_REL)
+  #define CAS(p,pold,new)   __atomic_compare_exchange_n(p,pold,new,false, \
+                                  __ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE)
+
+  typedef struct MSG                   // mailbox record (<data> copy follows)
+          {
+            BL_ob oo;                  // message object
+            int val;                   // message value
+          } MSG;
+
+  static BL_mbox *chain = NULL;        // chain of (used) mailboxes
+
+//==============================================================================
+// mailbox work item (CFG_MBOX_WORKQ mode)
+//==============================================================================
+#if (CFG_MBOX_WORKQ)
+
+  static void mbox_worker(struct k_work *work)
+  {
+    bl_mbox_drain();
+  }
+
+  K_WORK_DEFINE(mbox_work,mbox_worker);
+
+#endif
+//==============================================================================
+// helper: link mailbox into chain (once, any context)
+//==============================================================================
+
+  static void mbox_attach(BL_mbox *mb)
+  {
+    uint32_t no = 0;
+    if (!CAS(&mb->linked,&no,1))
+      return;                          // already linked (by other context)
+
+    BL_mbox *head = LOAD(&chain);
+    do
+      mb->next = head;
+    while (!CAS(&chain,&head,mb));     // on failure head is reloaded
+  }
+
+//==============================================================================
+// helper: post message to mailbox (copy <len> bytes of <data> if len > 0)
+//==============================================================================
+
+  static int mbox_post(BL_mbox *mb, BL_id mid, int id, BL_data data, int len,
+                       int val)
+  {
+    if (!LOAD(&mb->linked))
+      mbox_attach(mb);
+
+    MSG *m = bl_ring_reserve(&mb->ring,sizeof(MSG)+len);
+    if (!m)
+      return -1;                       // mailbox full (drop counted by ring)
+
+    if (len > 0)
+      memcpy(m+1,data,len);            // payload follows record (8 aligned)
+
+    m->oo = (BL_ob){BL_CL(mid),BL_OP(mid),id,len > 0 ? (void*)(m+1) : data};
+    m->val = val;
+    bl_ring_commit(&mb->ring,m);
+
+      // update pending peak (lock free max)
+
+    uint32_t pending = INC(&mb->posts) - LOAD(&mb->done);
+    uint32_t peak = LOAD(&mb->peak);
+    while (pending > peak && !CAS(&mb->peak,&peak,pending))
+      ;                                // on failure peak is reloaded
+
+    #if (CFG_MBOX_WORKQ)
+      k_work_submit(&mbox_work);       // continue at mbox_worker()
+    #elif (CFG_RUN_TICKLESS)
+      k_sem_give(&run_alarm);          // wake up sleeping engine
+    #endif
+    return 0;                          // OK
+  }
+
+//==============================================================================
+// post message asynchronously (<data> by reference)
+//==============================================================================
+
+  int bl_post_async(BL_mbox *mb, BL_id mid, int id, BL_data data, int val)
+  {
+    return mbox_post(mb,mid,id,data,0,val);
+  }
+
+//==============================================================================
+// post message asynchronously (<data> copied into mailbox)
+//==============================================================================
+
+  int bl_post_copy(BL_mbox *mb, BL_id mid, int id, BL_data data, int len,
+                   int val)
+  {
+    return mbox_post(mb,mid,id,data,data ? len : 0,val);
+  }
+
+//==============================================================================
+// deliver pending messages of all mailboxes (single consumer, not nestable)
+//==============================================================================
+
+  int bl_mbox_drain(void)
+  {
+    static volatile uint32_t busy = 0;
+    int n = 0;
+
+    if (__atomic_exchange_n(&busy,1,__ATOMIC_ACQUIRE))
+      return 0;                        // called by a delivered message
+
+    for (BL_mbox *mb = LOAD(&chain); mb; mb = mb->next)
+    {
+      uint32_t count = LOAD(&mb->posts) - mb->done;
+      MSG *m;
+
+      for (; count && (m = bl_ring_peek(&mb->ring,NULL)); count--, n++)
+      {
+        LOGO(4,"deliver:",&m->oo,m->val);
+        mb->module(&m->oo,m->val);     // deliver from flat stack
+        bl_ring_free(&mb->ring);
+        INC(&mb->done);
+      }
+    }
+
+    STORE(&busy,0);
+    return n;                          // number of delivered messages
+  }
+
+//==============================================================================
+// log mailbox statistics
+//==============================================================================
+
+  void bl_mbox_log(void)
+  {
+    for (BL_mbox *mb = LOAD(&chain); mb; mb = mb->next)
+      LOG(1,BL_C "mailbox %-12s posts: %d, pending: %d, peak: %d, drops: %d",
+          mb->name, (int)mb->posts, (int)(mb->posts - mb->done),
+          (int)mb->peak, bl_ring_drops(&mb->ring,false));
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #undef LOAD
+  #undef STORE
+  #undef INC
+  #undef CAS
+
+  #include "bl_clean.h"
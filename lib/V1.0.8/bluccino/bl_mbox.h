@@ -0,0 +1,114 @@
+//==============================================================================
+//  bl_mbox.h
+//  asynchronous message posting via per-module mailboxes
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// bl_post() is a nested function call: the message is processed on the stack
+// and in the context of the poster. bl_post_async() instead copies the message
+// [CL:OP @id,<data>,val] into a bounded lock-free mailbox (MPSC record ring,
+// see bl_ring.h) owned by the target module and returns immediately. ISRs,
+// work queues and mesh callbacks can post without masking interrupts and
+// without entering the target module.
+//
+// Mailboxes are drained by the bl_run() engine, once per engine cycle before
+// the ticks are posted, so messages are delivered from the engine's top level
+// with a flat stack (in tickless mode a post wakes up the engine). With
+// CFG_MBOX_WORKQ 1 they are drained by a work item of the system work queue
+// right after posting instead (lower latency, but the target module runs in
+// the work queue thread).
+//
+// Example:
+//
+//   BL_MBOX(app_mbox,app,512);                // 512 byte mailbox for app()
+//
+//   void button_isr(...)                      // any context
+//   {
+//     bl_post_async(&app_mbox,BUTTON_PRESS_id_0_0, 1,NULL,1);
+//   }
+//
+//   static const BL_goo goo = {...};          // <data> by reference
+//   bl_post_async(&app_mbox,GOOCLI_SET_id_BL_goo_onoff, 1,&goo,1);
+//
+//   BL_goo tmp = {...};                       // <data> copied into mailbox
+//   bl_post_copy(&app_mbox,GOOCLI_SET_id_BL_goo_onoff, 1,&tmp,sizeof(tmp),1);
+//
+// A message costs sizeof(BL_ob)+sizeof(int)+8 bytes of mailbox space (24
+// bytes on a 32-bit MCU) plus the 8 byte aligned size of copied data. If a
+// mailbox is full the message is dropped and counted (overflow statistics).
+//
+//==============================================================================
+
+#ifndef __BL_MBOX_H__
+#define __BL_MBOX_H__
+
+  #include "bl_ring.h"
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_MBOX_WORKQ
+    #define CFG_MBOX_WORKQ     0       // 0: drained by bl_run(), 1: work queue
+  #endif
+
+//==============================================================================
+// mailbox structure
+//==============================================================================
+
+  typedef struct BL_mbox               // per-module mailbox
+          {
+            BL_ring ring;              // MPSC record ring
+            BL_oval module;            // owner (target) module
+            BL_txt name;               // mailbox name (statistics)
+            volatile uint32_t posts;   // number of posted messages
+            volatile uint32_t done;    // number of delivered messages
+            volatile uint32_t peak;    // max number of pending messages
+            volatile uint32_t linked;  // linked into mailbox chain?
+            struct BL_mbox *next;      // next mailbox in chain
+          } BL_mbox;
+
+//==============================================================================
+// define a mailbox for a module with given size (power of 2, multiple of 8)
+// - usage: BL_MBOX(app_mbox,app,512);  // static 512 byte mailbox for app()
+//==============================================================================
+
+  #define BL_MBOX(name,mod,bytes)                                           \
+          static uint64_t name##_buf[(bytes)/8];                            \
+          static BL_mbox name = { { (uint8_t*)name##_buf, (bytes), 0,0,0 }, \
+                                  (mod), #name, 0,0,0,0,NULL }
+
+//==============================================================================
+// post message [CL:OP @id,<data>,val] asynchronously to a mailbox (any
+// context); <data> is passed by reference and must stay valid until delivery
+// - usage: err = bl_post_async(&mbox,mid,id,data,val) // -1: mailbox full
+//==============================================================================
+
+  int bl_post_async(BL_mbox *mb, BL_id mid, int id, BL_data data, int val);
+
+//==============================================================================
+// post message [CL:OP @id,<data>,val] asynchronously to a mailbox (any
+// context); <len> bytes of <data> are copied into the mailbox
+// - usage: err = bl_post_copy(&mbox,mid,id,data,len,val) // -1: mailbox full
+//==============================================================================
+
+  int bl_post_copy(BL_mbox *mb, BL_id mid, int id, BL_data data, int len,
+                   int val);
+
+//==============================================================================
+// deliver pending messages of all mailboxes (single consumer, called by the
+// bl_run() engine or the mailbox work item); returns number of deliveries
+// - usage: n = bl_mbox_drain()
+//==============================================================================
+
+  int bl_mbox_drain(void);
+
+//==============================================================================
+// log mailbox statistics (posts, deliveries, pending peak, drops)
+// - usage: bl_mbox_log()
+//==============================================================================
+
+  void bl_mbox_log(void);
+
+#endif // __BL_MBOX_H__
@@ -142,18 +142,6 @@
     typedef struct bt_mesh_elem      BL_element;      // mesh element
     typedef struct bt_mesh_comp      BL_comp;         // device composition
 
-//==============================================================================
-// data structure for de-ja-vu
-//==============================================================================
-
-    typedef struct BL_dejavu
-    {
-        uint8_t tid;               // transaction ID of de-ja-vu
-        uint16_t src;              // source address of de-ja-vu
-        uint16_t dst;              // destination address of de-ja-vu
-        BL_ms time;             // time stamp of de-ja-vu
-    } BL_dejavu;
-
 //==============================================================================
 // short hand for Zephyr structure types
 //==============================================================================
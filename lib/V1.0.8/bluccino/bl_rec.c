@@ -0,0 +1,332 @@
+//==============================================================================
+//  bl_rec.c
+//  message flow recorder and replayer
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include <string.h>
+  #include "bluccino.h"
+  #include "bl_gonoff.h"
+  #include "bl_rec.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO                     "bl_rec:"
+
+  #define LOG                     LOG_GEAR
+  #define LOGO(lvl,col,o,val)     LOGO_GEAR(lvl,col WHO,o,val)
+
+  #if (CFG_REC_PAYLOAD > 180)
+    #error "CFG_REC_PAYLOAD too big (record size is limited to 255 bytes)"
+  #endif
+
+  BL_RING(rec_ring,CFG_REC_RING);      // RAM ring of default recorder
+  BL_rec bl_recs = {&rec_ring,NULL,NULL,NULL,false,0};
+
+//==============================================================================
+// helper: little endian serialization
+//==============================================================================
+
+  static uint8_t *put16(uint8_t *p, uint32_t x)
+  {
+    p[0] = (uint8_t)x;  p[1] = (uint8_t)(x >> 8);
+    return p + 2;
+  }
+
+  static uint8_t *put32(uint8_t *p, uint32_t x)
+  {
+    return put16(put16(p,x),x >> 16);
+  }
+
+  static uint8_t *put64(uint8_t *p, uint64_t x)
+  {
+    return put32(put32(p,(uint32_t)x),(uint32_t)(x >> 32));
+  }
+
+  static uint32_t get16(const uint8_t *p)
+  {
+    return p[0] | ((uint32_t)p[1] << 8);
+  }
+
+  static uint32_t get32(const uint8_t *p)
+  {
+    return get16(p) | (get16(p+2) << 16);
+  }
+
+  static uint64_t get64(const uint8_t *p)
+  {
+    return get32(p) | ((uint64_t)get32(p+4) << 32);
+  }
+
+//==============================================================================
+// helper: payload type of a message
+//==============================================================================
+
+  static BL_rectype rec_type(BL_ob *o)
+  {
+    if (!o->data)
+      return BL_REC_NONE;
+
+    switch (BL_ID(BL_UNAUG(o->cl),o->op))
+    {
+      case SYS_TICK_id_BL_pace_cnt:
+      case SYS_TOCK_id_BL_pace_cnt:
+        return BL_REC_PACE;
+
+      case GOOCLI_SET_id_BL_goo_onoff:
+      case GOOCLI_LET_id_BL_goo_onoff:
+      case GOOSRV_STS_id_BL_goo_sts:
+        return BL_REC_GOO;
+
+      case NVM_LOAD_0_BL_dac_0:
+      case NVM_SAVE_0_BL_dac_0:
+        return BL_REC_DAC;
+
+      default:
+        return BL_REC_NONE;
+    }
+  }
+
+//==============================================================================
+// helper: serialize payload, return end of payload
+//==============================================================================
+
+  static uint8_t *rec_payload(uint8_t *p, BL_rectype type, const void *data)
+  {
+    switch (type)
+    {
+      case BL_REC_PACE:
+      {
+        const BL_pace *q = data;
+        p = put64(p,q->period);
+        return put64(p,q->time);
+      }
+
+      case BL_REC_GOO:
+      {
+        const BL_goo *q = data;
+        p = put32(p,q->trans.target);  p = put32(p,q->trans.basis);
+        p = put64(p,q->trans.begin);   p = put32(p,q->trans.tt);
+        p = put32(p,q->delay);         p = put32(p,q->tt);
+        *p++ = q->tid;
+        return put32(p,q->remain);
+      }
+
+      case BL_REC_DAC:
+      {
+        const BL_dac *q = data;
+        int klen = q->key ? strlen(q->key) : 0;
+        int dlen = q->data ? (int)q->size : 0;
+        klen = klen > 32 ? 32 : klen;
+        dlen = dlen > CFG_REC_PAYLOAD ? CFG_REC_PAYLOAD : dlen;
+
+        *p++ = (uint8_t)klen;
+        if (klen)
+          memcpy(p,q->key,klen);
+        p += klen;
+        p = put16(p,q->size);          // original size
+        *p++ = (uint8_t)dlen;
+        if (dlen)
+          memcpy(p,q->data,dlen);
+        return p + dlen;
+      }
+
+      default:
+        return p;
+    }
+  }
+
+//==============================================================================
+// record a message
+//==============================================================================
+
+  int bl_rec_put(BL_rec *r, BL_ob *o, int val)
+  {
+    uint8_t buf[BL_REC_HEADER + 40 + 32 + CFG_REC_PAYLOAD];
+    BL_rectype type = rec_type(o);
+
+    uint8_t *p = buf + 1;
+    *p++ = (uint8_t)type;
+    p = put16(p,o->cl);  p = put16(p,o->op);
+    p = put32(p,o->id);  p = put32(p,val);
+    p = put32(p,(uint32_t)bl_us());
+    p = rec_payload(p,type,o->data);
+
+    int len = (int)(p - buf);
+    buf[0] = (uint8_t)len;             // record length (<= BL_REC_MAX)
+
+    if (r->write)
+      r->write(r->ctx,buf,len);        // stream writer (e.g. host file)
+
+    int err = 0;
+    if (r->ring)
+    {
+      void *q = bl_ring_reserve(r->ring,len);
+      if (q)
+      {
+        memcpy(q,buf,len);
+        bl_ring_commit(r->ring,q);
+      }
+      else
+        err = -1;                      // RAM ring full (drop counted by ring)
+    }
+
+    if (!err)                          // count stored records only
+      __atomic_add_fetch(&r->records,1,__ATOMIC_RELAXED);
+    return err;
+  }
+
+//==============================================================================
+// recorder module worker
+//==============================================================================
+
+  int bl_rec_module(BL_rec *r, BL_ob *o, int val)
+  {
+    if (bl_is(o,_SYS,INIT_))
+    {
+      r->out = bl_cb(o,(r->out),WHO"(out)");
+      return 0;
+    }
+
+    if (r->sys || BL_UNAUG(o->cl) != _SYS)
+      bl_rec_put(r,o,val);
+
+    return r->out ? bl_fwd(o,val,(r->out)) : 0;
+  }
+
+//==============================================================================
+// default recorder module interface
+//==============================================================================
+
+  int bl_rec(BL_ob *o, int val)
+  {
+    return bl_rec_module(&bl_recs,o,val);
+  }
+
+//==============================================================================
+// move records from RAM ring into a stream buffer
+//==============================================================================
+
+  int bl_rec_read(BL_rec *r, void *buf, int size)
+  {
+    uint8_t *p = buf;
+    int len, n = 0;
+    void *q;
+
+    while (r->ring && (q = bl_ring_peek(r->ring,&len)) && n + len <= size)
+    {
+      memcpy(p+n,q,len);
+      n += len;
+      bl_ring_free(r->ring);
+    }
+    return n;                          // stream length
+  }
+
+//==============================================================================
+// helper: wait until us-time (sleep for the coarse part, then spin)
+//==============================================================================
+
+  static void rec_wait(BL_us due)
+  {
+    BL_us now = bl_us();
+    if (due - now > 2000)
+      bl_sleep((due - now - 1000) / 1000);
+    while (bl_us() < due)
+      ;                                // spin for the fine part
+  }
+
+//==============================================================================
+// replay a recorded stream into a module
+//==============================================================================
+
+  int bl_replay(const void *buf, int len, BL_oval to, bool paced)
+  {
+    const uint8_t *p = buf, *end = p + len;
+    uint32_t last = 0;                 // time stamp of previous record
+    BL_us due = bl_us();               // replay time of current record
+    int n = 0;
+
+    union                              // deserialized payload
+    {
+      BL_pace pace;
+      BL_goo goo;
+      BL_dac dac;
+    } pay;
+    char key[32+1];
+    uint8_t data[CFG_REC_PAYLOAD];
+
+    for (; p + BL_REC_HEADER <= end; p += p[0], n++)
+    {
+      if (p[0] < BL_REC_HEADER || p + p[0] > end)
+        return bl_err(-1,"bl_replay: corrupted stream");
+
+      BL_ob oo = {(BL_cl)get16(p+2),(BL_op)get16(p+4),(int)get32(p+6),NULL};
+      int val = (int)get32(p+10);
+      uint32_t us = get32(p+14);
+      const uint8_t *q = p + BL_REC_HEADER;
+
+      int room = p[0] - BL_REC_HEADER; // payload bytes of record
+
+      switch (p[1])                    // payload type
+      {
+        case BL_REC_PACE:
+          if (room < 16)
+            return bl_err(-1,"bl_replay: corrupted stream");
+          pay.pace.period = (BL_ms)get64(q);
+          pay.pace.time = (BL_ms)get64(q+8);
+          oo.data = &pay.pace;
+          break;
+
+        case BL_REC_GOO:
+          if (room < 33)
+            return bl_err(-1,"bl_replay: corrupted stream");
+          pay.goo.trans.target = get32(q);  pay.goo.trans.basis = get32(q+4);
+          pay.goo.trans.begin = get64(q+8); pay.goo.trans.tt = get32(q+16);
+          pay.goo.delay = get32(q+20);      pay.goo.tt = get32(q+24);
+          pay.goo.tid = q[28];              pay.goo.remain = get32(q+29);
+          oo.data = &pay.goo;
+          break;
+
+        case BL_REC_DAC:
+        {
+          int klen = (room >= 1) ? q[0] : -1;
+          if (klen < 0 || klen > 32 || 1 + klen + 3 > room)
+            return bl_err(-1,"bl_replay: corrupted stream");
+          int dlen = q[1+klen+2];
+          if (dlen > CFG_REC_PAYLOAD || 1 + klen + 3 + dlen > room)
+            return bl_err(-1,"bl_replay: corrupted stream");
+
+          memcpy(key,q+1,klen);  key[klen] = 0;
+          q += 1 + klen;               // skip original size (q[0..1])
+          memset(data,0,sizeof(data));
+          memcpy(data,q+3,dlen);       // recorded (leading) data bytes
+          pay.dac = (BL_dac){key,data,(size_t)dlen};   // never beyond data[]
+          oo.data = &pay.dac;
+          break;
+        }
+
+        default:
+          break;
+      }
+
+      if (paced)
+      {
+        if (n > 0)
+          due += (int32_t)(us - last) > 0 ? (int32_t)(us - last) : 0;
+        rec_wait(due);
+      }
+      last = us;
+
+      to(&oo,val);                     // replay message
+    }
+    return n;                          // number of replayed messages
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
@@ -0,0 +1,144 @@
+//==============================================================================
+//  bl_rec.h
+//  message flow recorder and replayer
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A recorder is a module which is spliced into a message path (a gear's or
+// any module's <out> path): it records each message [CL:OP @id,<data>,val]
+// with a us time stamp and forwards it unchanged to its own <out> callback.
+// Records go into a RAM ring (MPSC, any context) and/or to a stream writer
+// (e.g. a file on the host). Payloads of known types (BL_pace, BL_goo, BL_dac)
+// are serialized, other <data> is recorded as NULL.
+//
+// The replayer feeds a recorded stream into a module, either as fast as
+// possible (load test, benchmark) or at the original pacing.
+//
+// Example:
+//
+//   BL_RECORDER(rec,4096);               // recorder rec() with 4k RAM ring
+//
+//   bl_init(rec,bl_top);                 // splice rec between up gear and
+//   bl_init(bl_up,rec);                  // top gear: bl_up -> rec -> bl_top
+//   ...
+//   static uint8_t buf[4096];
+//   int len = bl_rec_read(&rec_rec,buf,sizeof(buf));  // RAM ring -> stream
+//   int n = bl_replay(buf,len,(app),false);           // replay at full speed
+//
+// Stream format (little endian), one record per message:
+//
+//   u8 len | u8 type | u16 cl | u16 op | i32 id | i32 val | u32 us | payload
+//
+// len is the record length incl. header (18 bytes), us the low 32 bits of
+// bl_us() (pacing survives wrap around, gaps must be < 71 min).
+//
+// BL_dac payloads record the key (max. 32 chars), the original data size and
+// the leading CFG_REC_PAYLOAD data bytes. The size of a replayed BL_dac is
+// the number of recorded bytes (<= CFG_REC_PAYLOAD), thus a receiver never
+// accesses the replayer's data buffer beyond the recorded bytes. Records
+// whose payload does not fit the record length are rejected as corrupted
+// stream.
+//
+//==============================================================================
+
+#ifndef __BL_REC_H__
+#define __BL_REC_H__
+
+  #include "bl_ring.h"
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_REC_RING
+    #define CFG_REC_RING      1024     // RAM ring size of default recorder
+  #endif
+
+  #ifndef CFG_REC_PAYLOAD
+    #define CFG_REC_PAYLOAD     64     // max serialized BL_dac data bytes
+  #endif
+
+  #define BL_REC_HEADER         18     // record header size
+  #define BL_REC_MAX           255     // max record size
+
+//==============================================================================
+// payload types
+//==============================================================================
+
+  typedef enum BL_rectype
+          {
+            BL_REC_NONE = 0,           // no payload (<data> replayed as NULL)
+            BL_REC_PACE,               // BL_pace (SYS:TICK/TOCK)
+            BL_REC_GOO,                // BL_goo (GOOCLI/GOOSRV)
+            BL_REC_DAC,                // BL_dac (NVM:LOAD/SAVE)
+          } BL_rectype;
+
+//==============================================================================
+// recorder structure
+//==============================================================================
+
+  typedef void (*BL_recwr)(void *ctx, const void *data, int len);
+
+  typedef struct BL_rec                // message flow recorder
+          {
+            BL_ring *ring;             // RAM ring (NULL: none)
+            BL_recwr write;            // stream writer (NULL: none)
+            void *ctx;                 // stream writer context
+            BL_oval out;               // <out> callback (next module)
+            bool sys;                  // record [SYS:] messages?
+            volatile uint32_t records; // number of stored messages
+          } BL_rec;
+
+//==============================================================================
+// define a recorder module with RAM ring of given size (power of 2)
+// - usage: BL_RECORDER(rec,4096);  // recorder instance rec_rec, module rec()
+//==============================================================================
+
+  #define BL_RECORDER(name,bytes)                                           \
+          BL_RING(name##_ring,bytes);                                       \
+          static BL_rec name##_rec = {&name##_ring,NULL,NULL,NULL,false,0}; \
+          static int name(BL_ob *o, int val)                                \
+          {                                                                 \
+            return bl_rec_module(&name##_rec,o,val);                        \
+          }
+
+//==============================================================================
+// recorder module worker: [SYS:INIT <out>] stores <out>, any other message is
+// recorded and forwarded to <out>
+// - usage: return bl_rec_module(&rec,o,val)
+//==============================================================================
+
+  int bl_rec_module(BL_rec *r, BL_ob *o, int val);
+
+//==============================================================================
+// record a message (any context)
+// - usage: err = bl_rec_put(&rec,o,val)   // -1: RAM ring full (dropped)
+//==============================================================================
+
+  int bl_rec_put(BL_rec *r, BL_ob *o, int val);
+
+//==============================================================================
+// move records from RAM ring into a stream buffer (single consumer)
+// - usage: len = bl_rec_read(&rec,buf,size) // stream length in bytes
+//==============================================================================
+
+  int bl_rec_read(BL_rec *r, void *buf, int size);
+
+//==============================================================================
+// replay a recorded stream into a module (fast or at original pacing)
+// - usage: n = bl_replay(buf,len,(to),paced) // number of replayed messages
+//==============================================================================
+
+  int bl_replay(const void *buf, int len, BL_oval to, bool paced);
+
+//==============================================================================
+// default recorder and its module interface (RAM ring of CFG_REC_RING bytes)
+// - usage: bl_init(bl_rec,bl_top); bl_init(bl_up,bl_rec); // splice
+//==============================================================================
+
+  extern BL_rec bl_recs;               // default recorder
+
+  int bl_rec(BL_ob *o, int val);
+
+#endif // __BL_REC_H__
@@ -18,8 +18,8 @@
   #endif
 
   #if (CFG_LOG_RESET)
-    #define LOG_RESET(l,f,...)    BL_LOG(CFG_LOG_RESET-1+l,f,##__VA_ARGS__)
-    #define LOGO_RESET(l,f,o,v)   bl_logo(CFG_LOG_RESET-1+l,f,o,v)
+    #define LOG_RESET(l,f,...)    BL_LOGA(BL_AREA_RESET,CFG_LOG_RESET-1+l,f,##__VA_ARGS__)
+    #define LOGO_RESET(l,f,o,v)   BL_LOGO(BL_AREA_RESET,CFG_LOG_RESET-1+l,f,o,v)
   #else
     #define LOG_RESET(l,f,...)    {}     // empty
     #define LOGO_RESET(l,f,o,v)   {}     // empty
@@ -0,0 +1,160 @@
+//==============================================================================
+//  bl_ring.c
+//  lock-free multi producer / single consumer (MPSC) ring of records
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Record states: a producer owns the space between the old and the new head
+// index after a successful CAS. The record header's state word is zero until
+// the producer commits. The consumer zeroes a freed record before moving the
+// tail index, so newly reserved space always starts with state zero.
+//
+// Atomics are GCC __atomic builtins (ldrex/strex on Cortex-M3/M4).
+//
+//==============================================================================
+
+  #include <string.h>
+  #include "bl_ring.h"
+
+  #define FREE     0                   // record not (yet) committed
+  #define COMMIT   1                   // record committed
+  #define PADDING  2                   // padding record (skip)
+
+  typedef struct HDR                   // record header
+          {
+            uint32_t len;              // payload length
+            uint32_t state;            // record state
+          } HDR;
+
+  #define ALIGN(n)          (((n) + 7) & ~7u)        // 8 byte alignment
+  #define SIZE(len)         (sizeof(HDR) + ALIGN(len))
+
+  #define LOAD(p)           __atomic_load_n(p,__ATOMIC_ACQUIRE)
+  #define STORE(p,v)        __atomic_store_n(p,v,__ATOMIC_RELEASE)
+  #define CAS(p,pold,new)   __atomic_compare_exchange_n(p,pold,new,false, \
+                                  __ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE)
+
+//==============================================================================
+// reserve space for a record of given length (return NULL if full)
+//==============================================================================
+
+  void *bl_ring_reserve(BL_ring *r, int len)
+  {
+    uint32_t need = SIZE(len);         // header & aligned payload
+
+    if (len < 0 || need > r->size/2)   // record too big for the ring
+    {
+      __atomic_fetch_add(&r->drops,1,__ATOMIC_RELAXED);
+      return NULL;
+    }
+
+    uint32_t h = LOAD(&r->head);
+    for (;;)
+    {
+      uint32_t t = LOAD(&r->tail);
+      uint32_t pos = h & (r->size-1);
+      uint32_t pad = (pos + need > r->size) ? r->size - pos : 0;
+
+      if (h + pad + need - t > r->size)  // not enough free space?
+      {
+        __atomic_fetch_add(&r->drops,1,__ATOMIC_RELAXED);
+        return NULL;
+      }
+
+      if (CAS(&r->head,&h,h + pad + need))   // on failure h is reloaded
+      {
+        if (pad)                       // fill gap up to buffer end
+        {
+          HDR *p = (HDR*)(r->buf + pos);
+          p->len = pad - sizeof(HDR);
+          STORE(&p->state,PADDING);
+          pos = 0;
+        }
+
+        HDR *q = (HDR*)(r->buf + pos);
+        q->len = len;
+        return q + 1;                  // payload follows header
+      }
+    }
+  }
+
+//==============================================================================
+// commit a reserved record
+//==============================================================================
+
+  void bl_ring_commit(BL_ring *r, void *p)
+  {
+    HDR *q = (HDR*)p - 1;
+    STORE(&q->state,COMMIT);           // publish (payload written before)
+  }
+
+//==============================================================================
+// peek oldest record (return NULL if empty or oldest record not committed)
+//==============================================================================
+
+  void *bl_ring_peek(BL_ring *r, int *plen)
+  {
+    for (;;)
+    {
+      uint32_t t = r->tail;            // we are the only consumer
+      if (t == LOAD(&r->head))
+        return NULL;                   // ring is empty
+
+      HDR *q = (HDR*)(r->buf + (t & (r->size-1)));
+      uint32_t state = LOAD(&q->state);
+
+      if (state == FREE)
+        return NULL;                   // reserved, but not yet committed
+
+      if (state == PADDING)
+      {
+        bl_ring_free(r);               // skip padding record
+        continue;
+      }
+
+      if (plen)
+        *plen = q->len;
+      return q + 1;
+    }
+  }
+
+//==============================================================================
+// free oldest (peeked) record
+//==============================================================================
+
+  void bl_ring_free(BL_ring *r)
+  {
+    uint32_t t = r->tail;
+    HDR *q = (HDR*)(r->buf + (t & (r->size-1)));
+    uint32_t size = SIZE(q->len);
+
+    memset(q,0,size);                  // reserved space starts with FREE
+    STORE(&r->tail,t + size);
+  }
+
+//==============================================================================
+// read (and optionally clear) drop counter
+//==============================================================================
+
+  int bl_ring_drops(BL_ring *r, bool clear)
+  {
+    if (clear)
+      return (int)__atomic_exchange_n(&r->drops,0,__ATOMIC_RELAXED);
+    return (int)LOAD(&r->drops);
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #undef FREE
+  #undef COMMIT
+  #undef PADDING
+  #undef ALIGN
+  #undef SIZE
+  #undef LOAD
+  #undef STORE
+  #undef CAS
+
+  #include "bl_clean.h"
@@ -0,0 +1,90 @@
+//==============================================================================
+//  bl_ring.h
+//  lock-free multi producer / single consumer (MPSC) ring of records
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Producers (ISRs, work queues, main loop) reserve space for a variable length
+// record with an atomic compare-and-swap on the head index, fill the record
+// and commit it. A single consumer peeks committed records in order and frees
+// them. No interrupt masking is needed. If a record does not fit, it is
+// dropped and the drop counter is incremented.
+//
+// Example:
+//
+//   BL_RING(ring,1024);                     // 1024 byte ring (power of 2)
+//
+//   char *p = bl_ring_reserve(&ring,len);   // producer (any context)
+//   if (p)
+//   {
+//     memcpy(p,data,len);
+//     bl_ring_commit(&ring,p);
+//   }
+//
+//   while ((p = bl_ring_peek(&ring,&len)))  // single consumer
+//   {
+//     ...
+//     bl_ring_free(&ring);
+//   }
+//
+// Memory layout: each record is preceded by an 8 byte header {len,state} and
+// padded to 8 byte alignment. A record never wraps around the end of the
+// buffer, the gap is filled by a padding record.
+//
+//==============================================================================
+
+#ifndef __BL_RING_H__
+#define __BL_RING_H__
+
+  #include <stdint.h>
+  #include <stdbool.h>
+
+//==============================================================================
+// ring structure
+//==============================================================================
+
+  typedef struct BL_ring               // MPSC record ring
+          {
+            uint8_t *buf;              // ring buffer (8 byte aligned)
+            uint32_t size;             // buffer size (power of 2)
+            volatile uint32_t head;    // reserve index (free running)
+            volatile uint32_t tail;    // consume index (free running)
+            volatile uint32_t drops;   // number of dropped records
+          } BL_ring;
+
+//==============================================================================
+// define a ring with given buffer size (power of 2, multiple of 8)
+// - usage: BL_RING(ring,1024);         // static ring with 1024 byte buffer
+//==============================================================================
+
+  #define BL_RING(name,bytes)                                               \
+          static uint64_t name##_buf[(bytes)/8];                            \
+          static BL_ring name = { (uint8_t*)name##_buf, (bytes), 0,0,0 }
+
+//==============================================================================
+// producer API (any context)
+// - usage: p = bl_ring_reserve(&ring,len)  // NULL if full (drop counted)
+// -        bl_ring_commit(&ring,p)         // publish record
+//==============================================================================
+
+  void *bl_ring_reserve(BL_ring *r, int len);
+  void bl_ring_commit(BL_ring *r, void *p);
+
+//==============================================================================
+// consumer API (single consumer)
+// - usage: p = bl_ring_peek(&ring,&len)    // NULL if no committed record
+// -        bl_ring_free(&ring)             // free peeked record
+//==============================================================================
+
+  void *bl_ring_peek(BL_ring *r, int *plen);
+  void bl_ring_free(BL_ring *r);
+
+//==============================================================================
+// read drop counter
+// - usage: drops = bl_ring_drops(&ring,true)  // read and clear drop counter
+//==============================================================================
+
+  int bl_ring_drops(BL_ring *r, bool clear);
+
+#endif // __BL_RING_H__
@@ -0,0 +1,176 @@
+//==============================================================================
+//  bl_route.c
+//  publish/subscribe router (multiple subscribers per message class)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include "bluccino.h"
+  #include "bl_route.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO                     "bl_route:"
+
+  #define LOG                     LOG_GEAR
+  #define LOGO(lvl,col,o,val)     LOGO_GEAR(lvl,col WHO,o,val)
+
+  BL_route bl_routes = {{NULL}};       // default router
+
+//==============================================================================
+// helper: find subscriber index of a module (add if new), -1 if not found
+//==============================================================================
+
+  static int route_sub(BL_route *r, BL_oval module, bool add)
+  {
+    for (int i=0; i < CFG_ROUTE_SUBSCRIBERS; i++)
+      if (r->sub[i] == module)
+        return i;
+
+    for (int i=0; add && i < CFG_ROUTE_SUBSCRIBERS; i++)
+      if (r->sub[i] == NULL)
+      {
+        r->sub[i] = module;
+        return i;
+      }
+    return -1;                         // not found or table full
+  }
+
+//==============================================================================
+// helper: find opcode filter of a subscription, NULL if not found
+//==============================================================================
+
+  static BL_opfilt *route_filt(BL_route *r, int i, int cl)
+  {
+    if ( !(r->fmap[cl] & (1u << i)) )
+      return NULL;
+
+    for (int k=0; k < CFG_ROUTE_FILTERS; k++)
+      if (r->filt[k].ops && r->filt[k].sub == i && r->filt[k].cl == cl)
+        return r->filt + k;
+    return NULL;
+  }
+
+//==============================================================================
+// helper: free subscriber slot, if not subscribed to any class
+//==============================================================================
+
+  static void route_release(BL_route *r, int i)
+  {
+    for (int k=0; k < BL_ROUTE_CLASSES; k++)
+      if (r->map[k] & (1u << i))
+        return;                        // still subscribed to some class
+    r->sub[i] = NULL;                  // free subscriber slot
+  }
+
+//==============================================================================
+// subscribe a module to a message class
+//==============================================================================
+
+  int bl_subscribe(BL_route *r, BL_oval module, BL_cl cl, uint64_t ops)
+  {
+    cl = BL_UNAUG(cl);
+    if (cl >= BL_ROUTE_CLASSES)
+      return bl_err(-1,"bl_subscribe: bad class");
+
+    int i = route_sub(r,module,true);
+    if (i < 0)
+      return bl_err(-1,"bl_subscribe: subscriber table full");
+
+    BL_opfilt *f = route_filt(r,i,cl);
+    if (!ops)                          // all opcodes => remove filter
+    {
+      if (f)
+        f->ops = 0;
+      r->fmap[cl] &= ~(1u << i);
+    }
+    else                               // (re-)subscribe with filter
+    {
+      for (int k=0; !f && k < CFG_ROUTE_FILTERS; k++)
+        if (r->filt[k].ops == 0)
+          f = r->filt + k;             // free filter slot
+
+      if (!f)
+      {
+        route_release(r,i);            // don't leak a new subscriber slot
+        return bl_err(-1,"bl_subscribe: opcode filter table full");
+      }
+
+      *f = (BL_opfilt){ops,(uint8_t)i,(uint8_t)cl};
+      r->fmap[cl] |= (1u << i);
+    }
+
+    r->map[cl] |= (1u << i);
+    return 0;                          // OK
+  }
+
+//==============================================================================
+// unsubscribe a module from a message class
+//==============================================================================
+
+  void bl_unsubscribe(BL_route *r, BL_oval module, BL_cl cl)
+  {
+    int i = route_sub(r,module,false);
+    cl = BL_UNAUG(cl);
+
+    if (i < 0 || cl >= BL_ROUTE_CLASSES)
+      return;
+
+    BL_opfilt *f = route_filt(r,i,cl);
+    if (f)
+      f->ops = 0;                      // free filter slot
+
+    r->map[cl] &= ~(1u << i);
+    r->fmap[cl] &= ~(1u << i);
+    route_release(r,i);
+  }
+
+//==============================================================================
+// deliver message to all subscribers in a single pass
+//==============================================================================
+
+  int bl_route(BL_route *r, BL_ob *o, int val)
+  {
+    uint32_t cl = BL_UNAUG(o->cl);
+    if (cl >= BL_ROUTE_CLASSES)
+      return 0;
+
+    uint32_t m = r->map[cl];           // subscribers of class
+    uint32_t f = r->fmap[cl];          // ... having an opcode filter
+    int n = 0;
+
+    while (m)
+    {
+      int i = __builtin_ctz(m);        // next subscriber
+      m &= m - 1;
+
+      if (f & (1u << i))               // opcode filter => check opcode
+      {
+        BL_opfilt *p = route_filt(r,i,cl);
+        if (!p || o->op >= 64 || !(p->ops & BL_OPBIT(o->op)))
+          continue;
+      }
+
+      bl_out(o,val,r->sub[i]);
+      n++;
+    }
+    return n;                          // number of deliveries
+  }
+
+//==============================================================================
+// default router module interface
+//==============================================================================
+
+  int bl_router(BL_ob *o, int val)
+  {
+    LOGO(5,"",o,val);
+    return bl_route(&bl_routes,o,val);
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
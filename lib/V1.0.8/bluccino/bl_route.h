@@ -0,0 +1,108 @@
+//==============================================================================
+//  bl_route.h
+//  publish/subscribe router (multiple subscribers per message class)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A module has exactly one <out> callback. For fan-out a router can be used
+// as <out> callback: it delivers a message [CL:OP ...] in a single pass to all
+// modules which subscribed to class CL, optionally restricted to a set of
+// opcodes. Each class has a bitmap of subscribers, so modules which don't care
+// about a class are skipped without a call (and without running their switch).
+//
+// Example:
+//
+//   BL_ROUTER(router);                           // define router
+//
+//   bl_subscribe(&router,app,_BUTTON,0);         // all [BUTTON:] messages
+//   bl_subscribe(&router,led,_BUTTON,            // only [BUTTON:PRESS/RELEASE]
+//                BL_OPBIT(PRESS_)|BL_OPBIT(RELEASE_));
+//   bl_route(&router,o,val);                     // deliver to subscribers
+//
+//   bl_init(bl_hw,bl_router);                    // fan out HW core output via
+//   bl_subscribe(&bl_routes,app,_SWITCH,0);      // the default router
+//
+// Messages are delivered like bl_out() does (augmented class tags are cleared)
+// in order of subscriber slots. Subscribing again to the same class replaces
+// the opcode filter. Subscriptions are meant to be done at init time,
+// they are not synchronized with concurrent deliveries.
+//
+//==============================================================================
+
+#ifndef __BL_ROUTE_H__
+#define __BL_ROUTE_H__
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_ROUTE_SUBSCRIBERS
+    #define CFG_ROUTE_SUBSCRIBERS  8   // max subscribers per router (<= 32)
+  #endif
+
+  #ifndef CFG_ROUTE_FILTERS
+    #define CFG_ROUTE_FILTERS      8   // max opcode filters per router
+  #endif
+
+  #define BL_ROUTE_CLASSES        32   // routable classes 0..31
+
+  #define BL_OPBIT(op)  ((uint64_t)1 << (op))    // opcode filter bit
+
+//==============================================================================
+// router structure
+//==============================================================================
+
+  typedef struct BL_opfilt             // opcode filter of a subscription
+          {
+            uint64_t ops;              // opcode bitmap (BL_OPBIT)
+            uint8_t sub;               // subscriber index
+            uint8_t cl;                // class tag
+          } BL_opfilt;
+
+  typedef struct BL_route              // publish/subscribe router
+          {
+            BL_oval sub[CFG_ROUTE_SUBSCRIBERS];  // subscriber modules
+            uint32_t map[BL_ROUTE_CLASSES];      // class -> subscriber bitmap
+            uint32_t fmap[BL_ROUTE_CLASSES];     // class -> filtered subscr.
+            BL_opfilt filt[CFG_ROUTE_FILTERS];   // opcode filters
+          } BL_route;
+
+//==============================================================================
+// define a (static) router
+// - usage: BL_ROUTER(router);
+//==============================================================================
+
+  #define BL_ROUTER(name)   static BL_route name = {{NULL}}
+
+//==============================================================================
+// subscribe a module to a message class (ops: opcode filter, 0: all opcodes)
+// - usage: err = bl_subscribe(&router,module,cl,ops)  // -1: table full
+//==============================================================================
+
+  int bl_subscribe(BL_route *r, BL_oval module, BL_cl cl, uint64_t ops);
+
+//==============================================================================
+// unsubscribe a module from a message class
+// - usage: bl_unsubscribe(&router,module,cl)
+//==============================================================================
+
+  void bl_unsubscribe(BL_route *r, BL_oval module, BL_cl cl);
+
+//==============================================================================
+// deliver message to all subscribers (return number of deliveries)
+// - usage: n = bl_route(&router,o,val)
+//==============================================================================
+
+  int bl_route(BL_route *r, BL_ob *o, int val);
+
+//==============================================================================
+// default router and its module interface (usable as <out> callback)
+// - usage: bl_init(module,bl_router)  // fan out module's output
+//==============================================================================
+
+  extern BL_route bl_routes;           // default router
+
+  int bl_router(BL_ob *o, int val);
+
+#endif // __BL_ROUTE_H__
@@ -16,7 +16,9 @@
   #endif
 
   #ifndef __ZEPHYR__
-    #define __NRF_SDK__ 1
+    #ifndef __HOST__
+      #define __NRF_SDK__ 1
+    #endif
   #endif
 
 //==============================================================================
@@ -33,6 +35,20 @@
 
 #endif // __ZEPHYR__
 
+//==============================================================================
+// host (POSIX) support - see host/bl_host.h
+//==============================================================================
+
+#ifdef __HOST__
+
+  #include "bl_host.h"
+
+  #define bl_prt             printk
+  #define BL_SLEEP(ms)       k_msleep(ms)
+  #define BL_VPRINTF(...)    // empty
+
+#endif // __HOST__
+
 //==============================================================================
 // Nordic SDK support
 //==============================================================================
@@ -6,7 +6,9 @@
 //  Copyright © 2022 Bluenetics GmbH. All rights reserved.
 //==============================================================================
 
-  #include <irq.h>                     // access irq_lock() and irq_unlock()
+  #ifdef __ZEPHYR__
+    #include <irq.h>                   // access irq_lock() and irq_unlock()
+  #endif
 
   #include "bluccino.h"
   #include "bl_run.h"
@@ -31,6 +33,32 @@
     #define CFG_RUN_LOG_PERIOD 5000   // 5000 ms assessment interval
   #endif
 
+//==============================================================================
+// tickless engine mode
+// - CFG_RUN_TICKLESS 0: [SYS:TICK] is posted every tick_ms (legacy mode)
+// - CFG_RUN_TICKLESS 1: the engine sleeps until the earliest deadline, which
+//   is either a bl_wake() request, the next tock or the next tick of a legacy
+//   (not tickless aware) app/test module
+//==============================================================================
+
+  #ifndef CFG_RUN_TICKLESS
+    #define CFG_RUN_TICKLESS   0      // tickless engine mode off by default
+  #endif
+
+  #define NEVER ((BL_ms)0x7FFFFFFFFFFFFFFF)   // no wakeup requested
+
+//==============================================================================
+// mailbox draining (see bl_mbox.h)
+// - CFG_MBOX_WORKQ 0: the engine delivers async posts once per engine cycle
+// - CFG_MBOX_WORKQ 1: async posts are delivered by a work item
+//==============================================================================
+
+  #if (CFG_MBOX_WORKQ)
+    #define mbox_drain()               // empty (drained by work queue)
+  #else
+    #define mbox_drain()      bl_mbox_drain()
+  #endif
+
 //==============================================================================
 // enable/disable interrupts
 // - usage: bl_irq(0)   // disable interrupts
@@ -40,10 +68,16 @@
   void bl_irq(bool enable)
   {
     static uint32_t key;
+    static volatile int nesting = 0;           // allows nested bl_irq() calls
+
     if ( !enable )
-      key = irq_lock();                        // disable interrupts
-    else
-      irq_unlock(key);
+    {
+      uint32_t k = irq_lock();                 // disable interrupts
+      if (nesting++ == 0)
+        key = k;                               // only outermost key counts
+    }
+    else if (nesting > 0 && --nesting == 0)
+      irq_unlock(key);                         // restore at outermost level
   }
 
 //==============================================================================
@@ -55,6 +89,96 @@
 
   BL_run run = {0,0,0,0,0,PERIOD};          // run monitoring data
 
+#endif
+//==============================================================================
+// per module/class CPU accounting
+// - a small stack of child times allows to account self time, i.e. the time
+//   of nested accounted calls is subtracted from the caller's busy time
+//==============================================================================
+#if (CFG_RUN_PROFILE)
+
+  #if (!CFG_RUN_LOG_PERIOD)
+    #error "CFG_RUN_PROFILE requires CFG_RUN_LOG_PERIOD > 0"
+  #endif
+
+  #define DEPTH 16                          // max accounted nesting depth
+
+  static BL_us child[DEPTH];                // cumulated time of nested calls
+  static int depth = 0;                     // current nesting depth
+
+  BL_us bl_acc_tic(void)
+  {
+    bl_irq(0);                              // stack is shared with ISRs
+    if (depth < DEPTH)
+      child[depth] = 0;                     // no nested time so far
+    depth++;
+    bl_irq(1);
+    return bl_us();
+  }
+
+  void bl_acc_toc(BL_accmod mod, BL_ob *o, BL_us tic)
+  {
+    BL_us dt = bl_us() - tic;               // inclusive time of call
+
+    int cl = BL_UNAUG(o->cl);
+    cl = (cl < CFG_RUN_CLASSES) ? cl : 0;   // slot 0 for VOID & others
+
+    bl_irq(0);                              // stack is shared with ISRs
+    BL_us self = (--depth < DEPTH) ? dt - child[depth] : dt;
+
+    if (depth > 0 && depth <= DEPTH)
+      child[depth-1] += dt;                 // subtract from caller's self time
+
+    run.mod[mod].busy += self;  run.mod[mod].calls++;
+    run.cls[cl].busy += self;   run.cls[cl].calls++;
+    bl_irq(1);
+  }
+
+  static int acc_fwd(BL_ob *o, int val, BL_oval module)  // accounted bl_fwd()
+  {
+    BL_accmod mod = (module == bluccino) ? BL_ACC_BLUCCINO
+                  : (module == test) ? BL_ACC_TEST : BL_ACC_APP;
+
+    BL_us tic = bl_acc_tic();
+    int err = bl_fwd(o,val,module);
+    bl_acc_toc(mod,o,tic);
+    return err;
+  }
+
+  static void acc_log(void)                 // log accounting tables
+  {
+  #if (CFG_LOG_RUN)
+    static BL_txt mtext[] = {"bluccino","app","test","down","up","top"};
+    static BL_txt ctext[] = BL_CL_TEXT;
+
+    LOG(1,BL_C "%-10s %8s %10s %7s","module","calls","busy/us","duty");
+    for (int i=0; i < BL_ACC_MODULES; i++)
+    {
+      BL_acc *a = run.mod + i;
+      int permill = run.total ? (int)((1000*a->busy) / run.total) : 0;
+      if (a->calls)
+        LOG(1,BL_C "%-10s %8d %10ld %4d.%d%%",mtext[i],a->calls,
+            (long)a->busy,permill/10,permill%10);
+    }
+
+    LOG(1,BL_C "%-10s %8s %10s %7s","class","calls","busy/us","duty");
+    for (int i=0; i < CFG_RUN_CLASSES; i++)
+    {
+      BL_acc *a = run.cls + i;
+      int permill = run.total ? (int)((1000*a->busy) / run.total) : 0;
+      if (a->calls)
+        LOG(1,BL_C "%-10s %8d %10ld %4d.%d%%",
+            i < (int)BL_LEN(ctext) ? ctext[i] : "???",a->calls,
+            (long)a->busy,permill/10,permill%10);
+    }
+  #endif // CFG_LOG_RUN
+  }
+
+#else
+
+  #define acc_fwd(o,val,module)             bl_fwd(o,val,module)
+  #define acc_log()                         // empty
+
 #endif
 //==============================================================================
 // run time monitoring (control functions)
@@ -75,6 +199,10 @@
     run.tick = tick;  run.tock = tock;
     run.due = now + run.period;
     run.duty = run.total = 0;
+    #if (CFG_RUN_PROFILE)
+      memset(run.mod,0,sizeof(run.mod));    // clear accounting tables
+      memset(run.cls,0,sizeof(run.cls));
+    #endif
     run.start = run.tic = bl_us();
   }
 
@@ -106,6 +234,8 @@
 
       LOG(1,BL_C "run time duty: %d.%d%% @tick/tock %d/%d ms (%ld/%ld us)",
 	      permill/10,permill%10,run.tick,run.tock,(long)run.duty,(long)run.total);
+      acc_log();                            // log accounting tables
+      bl_mbox_log();                        // log mailbox statistics
 
         // finally post a run monitoring message using top gear
 
@@ -148,6 +278,160 @@
     return 0;                          // OK
   }
 
+//==============================================================================
+// tickless wakeup requests
+//==============================================================================
+#if (CFG_RUN_TICKLESS)
+
+  K_SEM_DEFINE(run_alarm,0,1);         // wakes up a sleeping engine early
+
+  static volatile BL_ms wake = 0;      // earliest requested tick time
+  static volatile BL_ms planned = 0;   // time for which the engine sleeps
+
+  static BL_oval aware[2] = {NULL,NULL};    // tickless aware app/test modules
+
+  static bool tickless(BL_oval module)      // is module tickless aware?
+  {
+    for (int i=0; i < (int)BL_LEN(aware); i++)
+      if (aware[i] == module)
+        return true;
+    return false;
+  }
+
+#endif
+//==============================================================================
+// request a tickless wakeup (no effect unless CFG_RUN_TICKLESS is enabled)
+// - usage: bl_wake(due)               // request a [SYS:TICK] at ms-time due
+//==============================================================================
+
+  void bl_wake(BL_ms due)
+  {
+    #if (CFG_RUN_TICKLESS)
+      uint32_t key = irq_lock();       // local key: nestable, any context
+      if (due < wake)
+        wake = due;
+      bool early = (due < planned);    // engine sleeps beyond due time?
+      irq_unlock(key);
+
+      if (early)
+        k_sem_give(&run_alarm);        // wake up engine early
+    #endif
+  }
+
+//==============================================================================
+// declare an app/test module as tickless aware (CFG_RUN_TICKLESS mode)
+// - usage: bl_tickless((app))         // app gets ticks only on bl_wake()
+//==============================================================================
+
+  int bl_tickless(BL_oval module)
+  {
+    #if (CFG_RUN_TICKLESS)
+      for (int i=0; i < (int)BL_LEN(aware); i++)
+        if (aware[i] == NULL || aware[i] == module)
+        {
+          aware[i] = module;
+          return 0;                    // OK
+        }
+      return bl_err(-1,"bl_tickless: too many modules");
+    #else
+      return 0;                        // OK (all modules are ticked anyway)
+    #endif
+  }
+
+//==============================================================================
+// tickless engine: sleep until earliest deadline (wakeup request, next tock,
+// or next tick of a legacy app/test module), bluccino is tickless aware
+//==============================================================================
+#if (CFG_RUN_TICKLESS)
+
+  static void run_tickless(BL_oval A, BL_oval B, BL_oval T,
+                           int tick_ms, int tock_ms)
+  {
+    BL_pace tick_pace = {tick_ms,0};
+    BL_pace tock_pace = {tock_ms,0};
+
+    BL_ob oo_tick = {_SYS,TICK_,0,&tick_pace};
+    BL_ob oo_tock = {_SYS,TOCK_,1,&tock_pace};
+
+    bool legacy_a = (A) && !tickless(A);    // app needs fixed ticks?
+    bool legacy_t = (T) && !tickless(T);    // test needs fixed ticks?
+    int tocks = 0;
+
+    moni_start(tick_pace.time,tick_ms,tock_ms);
+
+    for (BL_ms time = 0;;)
+    {
+      int ticks = (int)(time / tick_ms);
+      tick_pace.time = time;
+
+        // a wakeup request is consumed only if already passed, since requests
+        // for later times may arrive meanwhile from other contexts
+
+      uint32_t key = irq_lock();
+      bool due = (wake <= time);
+      if (due)
+        wake = NEVER;
+      irq_unlock(key);
+
+      mbox_drain();                    // deliver async posts
+
+        // post [SYS:TICK @id,cnt] events
+
+      if (due)
+        acc_fwd(&oo_tick,ticks,(B));   // tick bluccino module
+      if ((A) && (due || legacy_a))
+        acc_fwd(&oo_tick,ticks,(A));   // tick APP module
+      if ((T) && (due || legacy_t))
+        acc_fwd(&oo_tick,ticks,(T));   // tick TEST module
+
+        // post [SYS:TOCK @id,cnt] events
+
+      if (time >= tock_pace.time)      // time for tocking?
+      {
+        acc_fwd(&oo_tock,tocks,(B));   // tock BLUCCINO module
+        if ((A))
+          acc_fwd(&oo_tock,tocks,(A)); // tock APP module
+        if ((T))
+          acc_fwd(&oo_tock,tocks,(T)); // tock TEST module
+        tocks++;
+        tock_pace.time += tock_ms;     // increase tock time
+      }
+
+        // calculate next tick time (rounded up to the tick grid) and sleep
+        // until this time or until a bl_wake() request for an earlier time
+
+      for (;;)
+      {
+        key = irq_lock();
+        BL_ms next = tock_pace.time;
+        if (wake < next)
+          next = wake;
+        if ((legacy_a || legacy_t) && time + tick_ms < next)
+          next = time + tick_ms;
+
+        next = ((next + tick_ms - 1) / tick_ms) * tick_ms;
+        if (next <= time)
+          next = time + tick_ms;       // past requests go to the next tick
+        planned = next;
+        irq_unlock(key);
+
+        BL_ms now = bl_ms();           // current time
+        if (now >= next)               // next tick time reached?
+        {
+          time = now - now % tick_ms;  // tick time on grid (catch up if late)
+          break;
+        }
+
+        moni_suspend();                // suspend run monitoring
+        k_sem_take(&run_alarm,K_MSEC(next-now));  // sleep or early wakeup
+        mbox_drain();                  // deliver async posts
+        moni_log(bl_ms());             // log results if due
+        moni_resume();                 // resume run monitoring
+      }
+    }
+  }
+
+#endif
 //==============================================================================
 // run app with given tick/tock periods and provided when-callback
 // - usage: bl_run(app,10,100,when)    // run app with 10/1000 tick/tock periods
@@ -179,6 +463,10 @@
     if ((T))
       bl_init((T),(W));
 
+    #if (CFG_RUN_TICKLESS)
+      run_tickless(A,B,T,tick_ms,tock_ms);  // never returns
+    #endif
+
       // post periodic ticks and tocks ...
 
     moni_start(tick_pace.time,tick_ms,tock_ms);
@@ -187,23 +475,25 @@
     {
       static int tocks = 0;
 
+      mbox_drain();                    // deliver async posts
+
         // post [SYS:TICK @id,cnt] events
 
-      bl_fwd(&oo_tick,ticks,(B));      // tick bluccino module
+      acc_fwd(&oo_tick,ticks,(B));     // tick bluccino module
       if ((A))
-        bl_fwd(&oo_tick,ticks,(A));    // tick APP module
+        acc_fwd(&oo_tick,ticks,(A));   // tick APP module
       if ((T))
-        bl_fwd(&oo_tick,ticks,(T));    // tick TEST module
+        acc_fwd(&oo_tick,ticks,(T));   // tick TEST module
 
         // post [SYS:TOCK @id,cnt] events
 
       if (ticks % multiple == 0)       // time for tocking?
       {
-        bl_fwd(&oo_tock,tocks,(B));    // tock BLUCCINO module
+        acc_fwd(&oo_tock,tocks,(B));   // tock BLUCCINO module
         if ((A))
-          bl_fwd(&oo_tock,tocks,(A));  // tock APP module
+          acc_fwd(&oo_tock,tocks,(A)); // tock APP module
         if ((T))
-          bl_fwd(&oo_tock,tocks,(T));  // tock TEST module
+          acc_fwd(&oo_tock,tocks,(T)); // tock TEST module
         tocks++;
         tock_pace.time += tock_ms;     // increase tock time
       }
@@ -65,6 +65,32 @@
 //
 //==============================================================================
 //
+// Example 4: tickless engine (build with CFG_RUN_TICKLESS=1). The engine sleeps
+// until the earliest deadline (next tock or bl_wake() request). Tickless aware
+// modules request their next [SYS:TICK] by bl_wake(), while app/test modules
+// which are not declared by bl_tickless() keep getting every tick
+//
+//   int app(BL_ob *o, int val)
+//   {
+//     switch (bl_id(o))
+//     {
+//       case SYS_TICK_id_BL_pace_cnt:
+//         if (bl_period(o,500))
+//           bl_led(1,-1);             // toggle LED @1 every 500 ms
+//         bl_wake(bl_next(o,0,500));  // request tick at next 500 ms period
+//         return 0;
+//       ...
+//     }
+//   }
+//
+//   void main(void)
+//   {
+//     bl_tickless(app);               // app is tickless aware
+//     bl_engine(app,10,1000);         // tick grid 10 ms, tock period 1000 ms
+//   }
+//
+//==============================================================================
+//
 // Typical Hierarchy and output message flow with test module integration,
 // demonstrating that
 //
@@ -133,13 +159,42 @@
 #endif
 
 #if (CFG_LOG_RUN)
-    #define LOG_RUN(l,f,...)    BL_LOG(CFG_LOG_RUN-1+l,f,##__VA_ARGS__)
-    #define LOGO_RUN(l,f,o,v)   bl_logo(CFG_LOG_RUN-1+l,f,o,v)
+    #define LOG_RUN(l,f,...)    BL_LOGA(BL_AREA_RUN,CFG_LOG_RUN-1+l,f,##__VA_ARGS__)
+    #define LOGO_RUN(l,f,o,v)   BL_LOGO(BL_AREA_RUN,CFG_LOG_RUN-1+l,f,o,v)
 #else
     #define LOG_RUN(l,f,...)    {}     // empty
     #define LOGO_RUN(l,f,o,v)   {}     // empty
 #endif
 
+//==============================================================================
+// per module/class CPU accounting (requires CFG_RUN_LOG_PERIOD > 0)
+//==============================================================================
+
+#ifndef CFG_RUN_PROFILE
+    #define CFG_RUN_PROFILE    0    // per module/class accounting by default off
+#endif
+
+#ifndef CFG_RUN_CLASSES
+    #define CFG_RUN_CLASSES   32    // number of accounted message classes
+#endif
+
+  typedef enum BL_accmod          // accounted modules
+          {
+            BL_ACC_BLUCCINO,      // bluccino module (tick/tock dispatch)
+            BL_ACC_APP,           // app module (tick/tock & event dispatch)
+            BL_ACC_TEST,          // test module (tick/tock dispatch)
+            BL_ACC_DOWN,          // down gear (incl. core & drivers)
+            BL_ACC_UP,            // up gear
+            BL_ACC_TOP,           // top gear
+            BL_ACC_MODULES        // number of accounted modules
+          } BL_accmod;
+
+  typedef struct BL_acc           // accounting record
+          {
+            BL_us busy;           // cumulated (self) busy us-time
+            int calls;            // number of calls
+          } BL_acc;
+
 //==============================================================================
 // monitoring structure for bl_run performance
 //==============================================================================
@@ -154,8 +209,32 @@
             BL_ms period;         // run logging period
             int tick;             // tick period in ms
             int tock;             // tock period in ms
+          #if (CFG_RUN_PROFILE)
+            BL_acc mod[BL_ACC_MODULES];   // per module accounting
+            BL_acc cls[CFG_RUN_CLASSES];  // per message class accounting
+          #endif
           } BL_run;
 
+//==============================================================================
+// account a module call (self time, i.e. without nested accounted calls)
+// - usage: BL_us tic = bl_acc_tic();  // begin of accounted call
+// -        err = module(o,val);
+// -        bl_acc_toc(BL_ACC_DOWN,o,tic)  // account module & message class
+// - note: calls must be properly nested (given for ISRs on a single core)
+//==============================================================================
+
+#if (CFG_RUN_PROFILE)
+
+  BL_us bl_acc_tic(void);
+  void bl_acc_toc(BL_accmod mod, BL_ob *o, BL_us tic);
+
+#else
+
+  static inline BL_us bl_acc_tic(void) { return 0; }
+  static inline void bl_acc_toc(BL_accmod mod, BL_ob *o, BL_us tic) {}
+
+#endif
+
 //==============================================================================
 // message definitions
 //==============================================================================
@@ -163,6 +242,8 @@
 //                  +--------------------+
 //                  |        SYS:        | SYS interface
 //            RUN --|  <BL_run>,permill  | notify run monitoring record
+//                  |                    | (incl. per module/class accounting
+//                  |                    | tables if CFG_RUN_PROFILE enabled)
 //                  +--------------------+
 //
 //==============================================================================
@@ -225,6 +306,23 @@
 
   int bl_test(BL_oval module);
 
+//==============================================================================
+// request a tickless wakeup (no effect unless CFG_RUN_TICKLESS is enabled)
+// - usage: bl_wake(due)               // request a [SYS:TICK] at ms-time due
+// - note: due is rounded up to the tick grid, a due time in the past requests
+//         the next tick. Safe to call from any context (ISR, work queue)
+//==============================================================================
+
+  void bl_wake(BL_ms due);
+
+//==============================================================================
+// declare an app/test module as tickless aware (CFG_RUN_TICKLESS mode)
+// - usage: bl_tickless((app))         // app gets ticks only on bl_wake()
+// - note: modules not declared tickless aware get every tick (legacy mode)
+//==============================================================================
+
+  int bl_tickless(BL_oval module);
+
 //==============================================================================
 // run app with given tick/tock periods and provided when-callback
 // - usage: bl_run((app),10,100,(when)) // run app with 10/1000 tick/tock periods
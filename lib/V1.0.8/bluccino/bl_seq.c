@@ -0,0 +1,271 @@
+//==============================================================================
+//  bl_seq.c
+//  LED pattern sequencer (compact byte code blink patterns)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include "bluccino.h"
+  #include "bl_hw.h"
+  #include "bl_seq.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO                     "bl_seq:"
+
+  #define LOG                     LOG_LED
+  #define LOGO(lvl,col,o,val)     LOGO_LED(lvl,col WHO,o,val)
+
+  #define STEPS  64                    // max steps of a pass without time
+
+//==============================================================================
+// channel of a LED
+//==============================================================================
+
+  typedef struct BL_chan               // sequencer channel
+          {
+            const BL_seq *pat;         // running pattern (NULL: idle)
+            const BL_seq *pc;          // next instruction
+            const BL_seq *mark;        // loop begin
+            uint8_t loops;             // passes of current loop
+            uint8_t dim;               // dim level of current step (0: none)
+            bool on;                   // LED level
+            bool start;                // start pattern at next pass
+            BL_ms due;                 // time of next step or PWM edge
+            BL_ms end;                 // end time of current (dimmed) step
+          } BL_chan;
+
+  static BL_chan chan[CFG_SEQ_CHANNELS];
+  static BL_oval out = bl_hw;          // LED output (hardware core)
+
+  static void seq_pass(struct k_work *work);
+  K_WORK_DEFINE(seq_work, seq_pass);   // processes due channels
+
+  static void seq_expired(struct k_timer *timer)
+  {
+    k_work_submit(&seq_work);          // ISR context: continue in work queue
+  }
+
+  K_TIMER_DEFINE(seq_timer, seq_expired, NULL);   // THE sequencer timer
+
+//==============================================================================
+// helper: soft PWM on time of dim level (ms)
+//==============================================================================
+
+  static inline BL_ms seq_pwm(int dim)
+  {
+    return (BL_ms)dim * CFG_SEQ_PWM / 32;
+  }
+
+//==============================================================================
+// helper: next PWM edge of a dimmed step (toggles LED level)
+//==============================================================================
+
+  static void seq_edge(BL_chan *c)
+  {
+    BL_ms on = seq_pwm(c->dim);
+
+    c->on = !c->on;
+    c->due += c->on ? on : CFG_SEQ_PWM - on;
+    if (c->due > c->end)
+      c->due = c->end;
+  }
+
+//==============================================================================
+// helper: execute instructions of a channel until the next timed step
+//==============================================================================
+
+  static void seq_step(BL_chan *c, int id)
+  {
+    for (int n=0; n < STEPS; n++)
+    {
+      BL_seq op = *c->pc++;
+      BL_ms ms = 0;
+
+      switch (op & 0xE0)
+      {
+        case BL_SEQ_END:
+          c->pat = NULL;               // channel idle, LED keeps level
+          return;
+
+        case 0x20:                     // BL_SEQ_ON(ms)
+        case 0x40:                     // BL_SEQ_OFF(ms)
+        case 0x60:                     // BL_SEQ_DIM(lvl,ms)
+          ms = (BL_ms)(*c->pc++) * BL_SEQ_UNIT;
+          c->dim = (op & 0xE0) == 0x60 ? (op & 0x1F) : 0;
+          c->on = (op & 0xE0) != 0x40;
+          c->end = c->due + ms;
+
+          if (c->dim && seq_pwm(c->dim) == 0)
+          {
+            c->on = false;             // too dark: off for whole step
+            c->dim = 0;
+          }
+          else if (c->dim && seq_pwm(c->dim) >= CFG_SEQ_PWM)
+            c->dim = 0;                // too bright: on for whole step
+
+          if (c->dim)                  // dimmed: first PWM on phase
+          {
+            c->due += seq_pwm(c->dim);
+            if (c->due > c->end)
+              c->due = c->end;
+          }
+          else
+            c->due = c->end;
+
+          if (ms)
+            return;                    // wait for next step
+          break;
+
+        case BL_SEQ_MARK:
+          c->mark = c->pc;
+          c->loops = 0;
+          break;
+
+        case 0xA0:                     // BL_SEQ_LOOP(n)
+          if (++c->loops < (op & 0x1F))
+            c->pc = c->mark;           // once more
+          else
+            c->loops = 0;              // loop done
+          break;
+
+        case BL_SEQ_AGAIN:
+          c->pc = c->pat;
+          c->mark = c->pat;
+          c->loops = 0;
+          break;
+
+        default:
+          LOG(1,BL_R "LED @%d: bad op 0x%02X (stop)",id,op);
+          c->pat = NULL;
+          return;
+      }
+    }
+
+    LOG(1,BL_R "LED @%d: pattern without timed step (stop)",id);
+    c->pat = NULL;
+  }
+
+//==============================================================================
+// helper: arm sequencer timer for the earliest step of all channels
+//==============================================================================
+
+  static void seq_arm(BL_ms now)
+  {
+    BL_ms next = 0;
+    bool busy = false;
+
+    for (int id=0; id < CFG_SEQ_CHANNELS; id++)
+      if (chan[id].pat && (!busy || chan[id].due < next))
+      {
+        next = chan[id].due;
+        busy = true;
+      }
+
+    if (!busy)
+      k_timer_stop(&seq_timer);        // all channels idle
+    else
+      k_timer_start(&seq_timer,K_MSEC(next > now ? next - now : 0),K_NO_WAIT);
+  }
+
+//==============================================================================
+// work horse: process all due channels, output LED changes as one [LED:MASK]
+//==============================================================================
+
+  static void seq_pass(struct k_work *work)
+  {
+    BL_ms now = bl_ms();
+    int mask = 0, bits = 0;
+
+    bl_irq(0);                         // no [LED:SEQ] while stepping
+    for (int id=0; id < CFG_SEQ_CHANNELS; id++)
+    {
+      BL_chan *c = chan + id;
+      bool on = c->on;
+
+      if (c->start)                    // patterns started since last pass
+      {
+        c->start = false;
+        c->due = now;                  // common start time: lock step
+        mask |= BL_LED(id);            // output initial level anyway
+      }
+
+      while (c->pat && c->due <= now)
+      {
+        if (c->dim && c->due < c->end)
+          seq_edge(c);                 // PWM edge of dimmed step
+        else
+          seq_step(c,id);              // next step
+      }
+
+      if (c->on != on)
+        mask |= BL_LED(id);
+      if (c->on)
+        bits |= BL_LED(id);
+    }
+    seq_arm(now);
+    bl_irq(1);
+
+    if (mask)
+      bl_post((out),LED_MASK_mask_0_bits, mask,NULL,bits & mask);
+  }
+
+//==============================================================================
+// public module interface
+//==============================================================================
+//
+// (C) := (bl_core);  (H) := (bl_hw)
+//
+//                  +--------------------+
+//                  |       bl_seq       | LED pattern sequencer
+//                  +--------------------+
+//                  |        SYS:        | SYS input interface
+// (C)->     INIT ->|       <out>        | init module, store <out> callback
+//                  +--------------------+
+//                  |        LED:        | LED input interface
+// (C)->      SEQ ->|  @id,<BL_seq>,0    | run pattern on LED @id (NULL: stop)
+//                  |        LED:        | LED output interface
+// (H)<-     MASK <-|     @mask,bits     | LED changes of a sequencer step
+//                  +--------------------+
+//
+//==============================================================================
+
+  int bl_seq(BL_ob *o, int val)
+  {
+    switch (bl_id(o))
+    {
+      case SYS_INIT_0_cb_0:            // [SYS:INIT <out>]
+        out = bl_cb(o,(out),WHO"(out)");
+        return 0;
+
+      case LED_SEQ_id_BL_seq_0:        // [LED:SEQ @id,<BL_seq>]
+      {
+        if (o->id < 0 || o->id >= CFG_SEQ_CHANNELS)
+          return -1;                   // bad LED ID
+
+        LOGO(4,"",o,val);
+        BL_chan *c = chan + o->id;
+
+        bl_irq(0);
+        c->pat = c->pc = c->mark = (const BL_seq*)o->data;
+        c->loops = c->dim = 0;
+        c->start = (c->pat != NULL);   // NULL: stop (LED keeps level)
+        bl_irq(1);
+
+        if (c->start)
+          k_work_submit(&seq_work);    // start in next pass (lock step)
+        return 0;
+      }
+
+      default:
+        return -1;                     // bad input
+    }
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
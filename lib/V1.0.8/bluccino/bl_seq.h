@@ -0,0 +1,101 @@
+//==============================================================================
+//  bl_seq.h
+//  LED pattern sequencer (compact byte code blink patterns)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A blink pattern is a small byte code program which is run on the channel
+// of LED @id by [LED:SEQ @id,<pattern>] (sugar: bl_ledseq(id,pattern)).
+// There is one channel per LED (@0..@4), a new pattern replaces the running
+// pattern of the channel, a <NULL> pattern stops the channel (the LED keeps
+// its level).
+//
+//   BL_SEQ_ON(ms)          LED on for ms
+//   BL_SEQ_OFF(ms)         LED off for ms
+//   BL_SEQ_DIM(lvl,ms)     LED dimmed to lvl/32 (lvl: 0..31) for ms (soft
+//                          PWM with CFG_SEQ_PWM period)
+//   BL_SEQ_MARK            begin of loop
+//   BL_SEQ_LOOP(n)         run the steps since BL_SEQ_MARK n times (1..31)
+//   BL_SEQ_AGAIN           restart pattern from the beginning (forever)
+//   BL_SEQ_END             end of pattern (LED keeps its level)
+//
+// Timed steps take two bytes, durations are stored in units of 10 ms (max.
+// 2550 ms, longer phases are split into several steps). Step times are
+// absolute to the start of the pattern, thus patterns do not drift.
+//
+// All channels share one k_timer, which is armed for the earliest step, and
+// the steps are processed in a work item. Patterns which are started in the
+// same context (e.g. [LED:SEQ] for several LEDs in a row) start in the same
+// work pass and run in lock step, and all LED changes of a pass are output
+// as one [LED:MASK] message. Blinking modules never need [SYS:TICK] messages.
+//
+// Example (SOS):
+//
+//   static const BL_seq sos[] =
+//          {
+//            BL_SEQ_MARK, BL_SEQ_ON(200), BL_SEQ_OFF(200), BL_SEQ_LOOP(3),
+//            BL_SEQ_MARK, BL_SEQ_ON(600), BL_SEQ_OFF(200), BL_SEQ_LOOP(3),
+//            BL_SEQ_MARK, BL_SEQ_ON(200), BL_SEQ_OFF(200), BL_SEQ_LOOP(3),
+//            BL_SEQ_OFF(1200), BL_SEQ_AGAIN,
+//          };
+//
+//   bl_ledseq(1,sos);                   // run SOS pattern on LED @1
+//
+//==============================================================================
+
+#ifndef __BL_SEQ_H__
+#define __BL_SEQ_H__
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_SEQ_CHANNELS
+    #define CFG_SEQ_CHANNELS     5     // number of channels (LEDs @0..@4)
+  #endif
+
+  #ifndef CFG_SEQ_PWM
+    #define CFG_SEQ_PWM         16     // soft PWM period of dimmed steps (ms)
+  #endif
+
+//==============================================================================
+// pattern byte code
+//==============================================================================
+
+  typedef uint8_t BL_seq;              // byte code of a blink pattern
+
+  #define BL_SEQ_UNIT           10     // time unit of step durations (ms)
+  #define BL_SEQ_T(ms)          (((ms) + BL_SEQ_UNIT/2) / BL_SEQ_UNIT)
+
+  #define BL_SEQ_END            0x00   // end of pattern
+  #define BL_SEQ_ON(ms)         0x20, BL_SEQ_T(ms)
+  #define BL_SEQ_OFF(ms)        0x40, BL_SEQ_T(ms)
+  #define BL_SEQ_DIM(lvl,ms)    (0x60 | ((lvl) & 0x1F)), BL_SEQ_T(ms)
+  #define BL_SEQ_MARK           0x80   // begin of loop
+  #define BL_SEQ_LOOP(n)        (0xA0 | ((n) & 0x1F))
+  #define BL_SEQ_AGAIN          0xC0   // restart pattern
+
+//==============================================================================
+// public module interface
+//==============================================================================
+//
+// (C) := (bl_core);  (H) := (bl_hw)
+//
+//                  +--------------------+
+//                  |       bl_seq       | LED pattern sequencer
+//                  +--------------------+
+//                  |        SYS:        | SYS input interface
+// (C)->     INIT ->|       <out>        | init module, store <out> callback
+//                  +--------------------+
+//                  |        LED:        | LED input interface
+// (C)->      SEQ ->|  @id,<BL_seq>,0    | run pattern on LED @id (NULL: stop)
+//                  |        LED:        | LED output interface
+// (H)<-     MASK <-|     @mask,bits     | LED changes of a sequencer step
+//                  +--------------------+
+//
+//==============================================================================
+
+  int bl_seq(BL_ob *o, int val);
+
+#endif // __BL_SEQ_H__
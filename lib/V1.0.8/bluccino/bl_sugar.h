@@ -45,7 +45,7 @@
 
   static inline int _bl_fwd(BL_ob *o, int val, BL_oval to)
   {
-    return _bl_msg((to), o->cl,o->op, o->id,o->data,val);   // augmented message
+    return bl_view(o,val,(to),BL_AUG(o->cl));   // augmented view (no copy)
   }
 
 //==============================================================================
@@ -98,6 +98,40 @@
     return _bl_post((to),mid, id,NULL, val<0?0:val);
   }
 
+//==============================================================================
+// syntactic sugar: set or toggle several LEDs at once (bit i: LED @i)
+// - usage: bl_leds(mask,bits)      // LEDs of mask: bits 0:off, 1:on
+//          bl_leds(BL_RGB,-1)      // toggle RGB LEDs @2,@3,@4
+//          _bl_leds(mask,bits,(PMI))   // augmented version
+//==============================================================================
+
+  static inline int bl_leds(int mask, int bits)
+  {
+    return bl_post((bl_down),LED_MASK_mask_0_bits, mask,NULL,bits);
+  }
+
+  static inline int _bl_leds(int mask, int bits, BL_oval to)
+  {
+    return _bl_post((to),LED_MASK_mask_0_bits, mask,NULL,bits);
+  }
+
+//==============================================================================
+// syntactic sugar: run a blink pattern on LED @id (see bl_seq.h)
+// - usage: bl_ledseq(id,pattern)   // start pattern (BL_seq byte code)
+//          bl_ledseq(id,NULL)      // stop pattern (LED keeps its level)
+//          _bl_ledseq(id,pattern,(PMI))   // augmented version
+//==============================================================================
+
+  static inline int bl_ledseq(int id, const BL_seq *pattern)
+  {
+    return bl_post((bl_down),LED_SEQ_id_BL_seq_0, id,pattern,0);
+  }
+
+  static inline int _bl_ledseq(int id, const BL_seq *pattern, BL_oval to)
+  {
+    return _bl_post((to),LED_SEQ_id_BL_seq_0, id,pattern,0);
+  }
+
 //==============================================================================
 // syntactic sugar: check if message is a button press message ([BUTTON:PRESS])
 // - usage: pressed = bl_pressed(o)
@@ -75,7 +75,8 @@
                         "ONOFF","COUNT","TOGGLE","INC","DEC","PAY", "ADV", \
                         "BEACON","SEND","PRESS","RELEASE","CLICK","HOLD","MS", \
                         "STORE","RECALL","SAVE","LOAD","AVAIL", \
-                        "MPUB","REPEAT","INTERVAL","RUN"}
+                        "MPUB","REPEAT","INTERVAL","RUN","LOG","COMBO","MASK", \
+                        "SEQ"}
 
     typedef enum BL_op
             {
@@ -132,6 +133,10 @@
               REPEAT_,                 // number of repeats
               INTERVAL_,               // interval between repeats
               RUN_,                    // run monitoring
+              LOG_,                    // log filter
+              COMBO_,                  // button combo (hold + click)
+              MASK_,                   // masked update (e.g. several LEDs)
+              SEQ_,                    // sequence (e.g. LED blink pattern)
             } BL_op;
 
   #endif // BL_OP_TEXT
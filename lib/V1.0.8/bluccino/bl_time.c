@@ -17,25 +17,114 @@
   #define LOG0(lvl,col,o,val)     LOGO_TIME(lvl,col,o,val)
 
 //==============================================================================
-// us/ms clock
+// raw cycle counter (64-bit)
+// - a 32-bit hardware counter is extended with a wrap around count, which is
+//   updated with interrupts locked (the counter is read under the lock, so a
+//   nested reader can't make us see a false wrap around)
+//==============================================================================
+
+  uint64_t bl_cyc(void)                // raw hardware cycles since boot
+  {
+    #if defined(__HOST__) || defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+      return k_cycle_get_64();
+    #elif __ZEPHYR__
+      static uint32_t last = 0;        // last counter value
+      static uint32_t wraps = 0;       // wrap around count
+
+      unsigned key = irq_lock();
+      uint32_t cyc = k_cycle_get_32();
+      if (cyc < last)
+        wraps++;                       // counter wrapped around
+      last = cyc;
+      irq_unlock(key);
+
+      return ((uint64_t)wraps << 32) | cyc;
+    #else
+      return (uint64_t)timer_now();    // us timer (1 cycle = 1 us)
+    #endif
+  }
+
+  uint32_t bl_cyc_hz(void)             // cycle counter frequency
+  {
+    #if __ZEPHYR__ || defined(__HOST__)
+      return sys_clock_hw_cycles_per_sec();
+    #else
+      return 1000000;
+    #endif
+  }
+
 //==============================================================================
+// cycles to us/ms conversion by precomputed 32.64 fixed point multipliers
+// - x = cyc * (mi + mf/2^64), mf rounded up: exact (floor) results as long
+//   as cyc < 2^64/hz (e.g. 584 years at 1 GHz), no 64-bit division at runtime
+//==============================================================================
+
+  typedef struct BL_scale              // fixed point multiplier
+          {
+            uint32_t mi;               // integer part
+            uint64_t mf;               // fraction (2^-64 units, rounded up)
+          } BL_scale;
 
-  static BL_us offset = 0;             // offset for us clock
+  static BL_scale us_scale, ms_scale;  // cycles => us, cycles => ms
+  static volatile bool scaled = false; // multipliers computed?
+
+  static BL_scale cyc_scale(uint32_t units, uint32_t hz)  // units per second
+  {
+    BL_scale s;
+    uint64_t r = units % hz;           // fraction r/hz in 2 steps of 32 bit
+
+    s.mi = units / hz;
+    uint64_t q1 = (r << 32) / hz;  r = (r << 32) % hz;
+    uint64_t q2 = (r << 32) / hz;  r = (r << 32) % hz;
+    s.mf = (q1 << 32) + q2 + (r != 0); // round up
+    return s;
+  }
+
+  static void cyc_init(void)           // compute multipliers (once)
+  {
+    uint32_t hz = bl_cyc_hz();
+    us_scale = cyc_scale(1000000,hz);
+    ms_scale = cyc_scale(1000,hz);
+    __atomic_store_n(&scaled,true,__ATOMIC_RELEASE);
+  }
 
-  static BL_us now_us()                // system clock in us
+  static inline uint64_t mulhi(uint64_t a, uint64_t b)  // (a*b) >> 64
   {
-    #if __ZEPHYR__
-      uint64_t cyc = k_uptime_ticks();
-      uint64_t f = sys_clock_hw_cycles_per_sec();
-      return (BL_us)((1000000*cyc)/f);
+    #if defined(__SIZEOF_INT128__)
+      return (uint64_t)(((unsigned __int128)a * b) >> 64);
     #else
-      return (BL_us)timer_now();
+      uint64_t al = (uint32_t)a, ah = a >> 32;
+      uint64_t bl = (uint32_t)b, bh = b >> 32;
+      uint64_t lh = al*bh, hl = ah*bl;
+      uint64_t mid = ((al*bl) >> 32) + (uint32_t)lh + (uint32_t)hl;
+      return ah*bh + (lh >> 32) + (hl >> 32) + (mid >> 32);
     #endif
   }
 
+  static inline uint64_t cyc_mul(uint64_t cyc, const BL_scale *s)
+  {
+    if (!__atomic_load_n(&scaled,__ATOMIC_ACQUIRE))
+      cyc_init();
+    return cyc * s->mi + mulhi(cyc,s->mf);
+  }
+
+  BL_us bl_cyc2us(uint64_t cyc)        // convert cycles to us
+  {
+    return (BL_us)cyc_mul(cyc,&us_scale);
+  }
+
+//==============================================================================
+// us/ms clock
+//==============================================================================
+
+  static uint64_t offset = 0;          // clock reset time (cycles)
+  static bool zeroed = false;          // clock reset happened?
+
   BL_us bl_zero(void)                  // reset clock
   {
-    return offset = now_us();
+    offset = bl_cyc();
+    zeroed = true;
+    return bl_cyc2us(offset);
   }
 
 //==============================================================================
@@ -44,12 +133,10 @@
 
   BL_us bl_us(void)                    // get current clock time in us
   {
-    BL_us us = now_us();
-
-    if (offset == 0)                   // first call always returns 0
-      us = bl_zero();                  // reset clock
+    if (!zeroed)                       // first call always returns 0
+      bl_zero();                       // reset clock
 
-    return us  - offset;
+    return bl_cyc2us(bl_cyc() - offset);
   }
 
 //==============================================================================
@@ -58,8 +145,33 @@
 
   BL_ms bl_ms(void)                    // get current clock time in ms
   {
-    BL_us us = bl_us();
-    return us/1000;
+    if (!zeroed)                       // first call always returns 0
+      bl_zero();                       // reset clock
+
+    return (BL_ms)cyc_mul(bl_cyc() - offset,&ms_scale);
+  }
+
+//==============================================================================
+// split clock time into min:sec:ms.us (incremental)
+//==============================================================================
+
+  void bl_hms(BL_hms *t, BL_us us)     // split us time
+  {
+    if (us < t->base || us - t->base >= 60000000)
+    {                                  // going back or big jump: recompute
+      BL_us s = us / 1000000;
+      t->base = s * 1000000;
+      t->min = (int)(s / 60);
+      t->sec = (int)(s % 60);
+    }
+
+    for (; us - t->base >= 1000000; t->base += 1000000)
+      if (++t->sec >= 60)              // at most 60 steps (usually 0 or 1)
+        t->sec = 0, t->min++;
+
+    uint32_t rem = (uint32_t)(us - t->base);    // us within second
+    t->ms = rem / 1000;
+    t->us = rem - t->ms * 1000;
   }
 
 //==============================================================================
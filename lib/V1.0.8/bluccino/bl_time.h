@@ -20,6 +20,34 @@
   BL_us bl_us(void);                   // get current clock time in us
   BL_ms bl_ms(void);                   // get current clock time in ms
 
+//==============================================================================
+// raw cycle clock (profiling)
+// - usage: cyc = bl_cyc()             // hardware cycles since boot (64-bit)
+//          us = bl_cyc2us(cyc1-cyc0)  // convert cycles to us (no division)
+//          hz = bl_cyc_hz()           // cycle counter frequency
+// - note: a 32-bit hardware counter is extended to 64 bit, which requires
+//   a clock read at least once per counter period (36 h at 32768 Hz)
+//==============================================================================
+
+  uint64_t bl_cyc(void);               // raw hardware cycles since boot
+  BL_us bl_cyc2us(uint64_t cyc);       // convert cycles to us
+  uint32_t bl_cyc_hz(void);            // cycle counter frequency
+
+//==============================================================================
+// split clock time into min:sec:ms.us (log headers)
+// - usage: static BL_hms t;  bl_hms(&t,bl_us()); // t.min, t.sec, t.ms, t.us
+// - incremental: times increasing in small steps only need a compare and a
+//   32-bit division, jumps (or times going back) recompute from scratch
+//==============================================================================
+
+  typedef struct BL_hms                // split clock time
+          {
+            int min, sec, ms, us;      // min:sec:ms.us
+            BL_us base;                // us time of the current second
+          } BL_hms;
+
+  void bl_hms(BL_hms *t, BL_us us);    // split us time (incremental)
+
 //==============================================================================
 // periode detection
 // - usage: ok = bl_period(o,ms)        // is tick/tock time meeting a period?
@@ -56,6 +84,20 @@
     return p ? (p->time == ms) : 0;
   }
 
+//==============================================================================
+// next period/duty edge (due time for a tickless wakeup request)
+// - usage: bl_wake(bl_next(o,duty,period))  // request tick at next duty edge
+// - note: returns the first time duty + n*period past tick/tock time
+//==============================================================================
+
+  static inline BL_ms bl_next(BL_ob *o, int duty, BL_ms period)
+  {
+    BL_pace *p = (BL_pace*)bl_data(o);
+    if (!p || p->time < duty)
+      return duty;
+    return duty + ((p->time - duty)/period + 1) * period;
+  }
+
 //==============================================================================
 // timing & sleep, system halt
 //==============================================================================
@@ -70,24 +112,22 @@
 // -        for (int i=0; i < o->id; i++)
 // -          { ... }  // do some work (e.g. call function with OVAL interface)
 // -        bl_toc(o,"OVAL call");
+// - note: one average only, use bl_bench (bl_bench.h) for min/median/p99
 //==============================================================================
 
   static inline int bl_tic(BL_ob *o, int n)
   {
-    BL_us now = bl_us();
-//bl_prt("now: %d us\n",(int)now);
-    o->data = (const void*)(int)now;
+    uint32_t now = (uint32_t)bl_us();  // wrap around safe 32-bit time stamp
+    o->data = (const void*)(uintptr_t)now;
     return (o->id = n);                // save number of loops in object's @id
   }
 
   static inline void bl_toc(BL_ob *o, BL_txt msg)
   {
-    int now = (int)bl_us();
-    int begin = (int)o->data;
-    int elapsed = (100*(now - begin)) / o->id;    // devide by number of runs
-//bl_prt("begin: %d us, now: %d us\n",begin,now);
+    uint32_t elapsed = (uint32_t)bl_us() - (uint32_t)(uintptr_t)o->data;
+    uint32_t cus = (uint32_t)((100*(uint64_t)elapsed) / o->id);  // 1/100 us
     if (bl_dbg(1))
-      bl_prt("%s: %d.%02d us\n", msg, elapsed/100, elapsed%100);
+      bl_prt("%s: %u.%02u us\n", msg, (unsigned)(cus/100), (unsigned)(cus%100));
   }
 
 #endif // __BL_TIME_H__
@@ -9,11 +9,19 @@
   #include "bluccino.h"
 
   #include "bl_time.c"                 // Bluccino API stuff
+  #include "bl_ring.c"                 // Bluccino lock-free record ring
   #include "bl_log.c"                  // Bluccino (standard) logging stuff
 
   #include "bl_deco.c"                 // Bluccino log decoration
   #include "bl_gear.c"                 // Bluccino gear
+  #include "bl_disp.c"                 // Bluccino dispatch tables
   #include "bl_run.c"                  // Bluccino engine (weak functions)
+  #include "bl_mbox.c"                 // Bluccino mailboxes (async posting)
+  #include "bl_route.c"                // Bluccino publish/subscribe router
+  #include "bl_rec.c"                  // Bluccino message recorder/replayer
+  #include "bl_bench.c"                // Bluccino microbenchmark harness
+  #include "bl_gesture.c"              // Bluccino button gesture engine
+  #include "bl_seq.c"                  // Bluccino LED pattern sequencer
   #include "bl_core.c"                 // Bluccino default core (weak functions)
 
   #define WHO  "bluccino:"
@@ -32,6 +40,7 @@
 // (M)->     TICK ->|      @id,cnt       | tick module
 // (M)->     TOCK ->|      @id,cnt       | tock module
 // (M)->      OUT ->|       <out>        | set <out> callback
+// (M)->      LOG ->|     @id,level      | set log filter level (bl_logfilt)
 //                  +--------------------+
 //                  |        SYS:        | SYS output interface
 // (D)<-     INIT <-|       <out>        | init module, store <out> callback
@@ -41,43 +50,56 @@
 //
 //==============================================================================
 
+  static BL_oval bluccino_app = NULL;  // (A) output to app module
+
+  static int bluccino_init(BL_ob *o, int val)  // [SYS:INIT <out>]
+  {
+    bluccino_app = bl_cb(o,bluccino_app,WHO"(A)");  // store output callback
+
+      // first init emitter (bl_emit), since down gear can send early
+      // messages which requires bl_top to be able to forward messages
+      // to app via bl_emit();
+
+    bl_init(bl_emit,bluccino_app);     // output non [SYS:] message to app
+
+      // after that we initialize up gear, down gear and top gear
+      // in exactly this order
+
+    bl_init(bl_up,bl_top);             // init up gear, output to top gear
+    bl_init(bl_down,bl_up);            // init down gear, output to up gear
+    bl_init(bl_top,bluccino_app);      // init top gear, output to app
+    return 0;
+  }
+
+  static int bluccino_tick(BL_ob *o, int val)  // [SYS:TICK/TOCK @id,cnt]
+  {
+    bl_fwd(o,val,bl_down);             // tick/tock down gear
+    bl_fwd(o,val,bl_top);              // tick/tock top gear
+    return 0;
+  }
+
+  static int bluccino_out(BL_ob *o, int val)   // [SYS:OUT <out>]
+  {
+    bluccino_app = bl_cb(o,bluccino_app,"");
+    return 0;
+  }
+
+  static int bluccino_log(BL_ob *o, int val)   // [SYS:LOG @id,level]
+  {
+    return bl_logfilt(o->id,val);      // return old level
+  }
+
+  BL_OPS(bluccino_sys,_SYS,
+    BL_ON(SYS_INIT_0_cb_0,         bluccino_init),
+    BL_ON(SYS_TICK_id_BL_pace_cnt, bluccino_tick),
+    BL_ON(SYS_TOCK_id_BL_pace_cnt, bluccino_tick),
+    BL_ON(BL_ID(_SYS,OUT_),        bluccino_out),
+    BL_ON(SYS_LOG_id_0_lvl,        bluccino_log));
+
+  BL_DISPATCH(bluccino_ifc,
+    BL_ROW(bluccino_sys));
+
   int bluccino(BL_ob *o, int val)
   {
-    static BL_oval A = NULL;           // output to app module
-    static BL_oval D = bl_down;        // output to down gear
-    static BL_oval T = bl_top;         // output to top gear
-    static BL_oval U = bl_up;          // output to up gear
-
-    switch (bl_id(o))
-    {
-      case BL_ID(_SYS,INIT_):          // [SYS:INIT <out>]
-        A = bl_cb(o,(A),WHO"(A)");     // store output callback
-
-          // first init emitter (bl_emit), since down gear can send early
-          // messages which requires bl_top to be able to forward messages
-          // to app via bl_emit();
-
-        bl_init(bl_emit,(A));          // output non [SYS:] message to app
-
-          // after that we initialize up gear, down gear and top gear
-          // in exactly this order
-
-        bl_init((U),(T));              // init up gear, output to top gear
-        bl_init((D),(U));              // init down gear, output to up gear
-        bl_init((T),(A));              // init top gear, output to app
-        return 0;
-
-      case BL_ID(_SYS,TICK_):
-      case BL_ID(_SYS,TOCK_):
-        bl_fwd(o,val,(D));             // tick/tock down gear
-        bl_fwd(o,val,(T));             // tick/tock top gear
-        return 0;
-
-      case BL_ID(_SYS,OUT_):
-        A = bl_cb(o,(A),"");
-        return 0;
-
-      default:
-        return -1;                     // bad command
-    }
+    return bl_dispatch(&bluccino_ifc,o,val);  // -1: bad command
   }
@@ -36,6 +36,13 @@
 
   #include "bl_time.h"
   #include "bl_gear.h"
+  #include "bl_disp.h"
+  #include "bl_mbox.h"
+  #include "bl_route.h"
+  #include "bl_rec.h"
+  #include "bl_bench.h"
+  #include "bl_gesture.h"
+  #include "bl_seq.h"
   #include "bl_run.h"
 	#include "bl_sugar.h"
 
@@ -55,6 +62,7 @@
 // (M)->     TICK ->|      @id,cnt       | tick module
 // (M)->     TOCK ->|      @id,cnt       | tock module
 // (M)->      OUT ->|       <out>        | set <out> callback
+// (M)->      LOG ->|     @id,level      | set log filter level (bl_logfilt)
 //                  +--------------------+
 //                  |        SYS:        | SYS output interface
 // (D)<-     INIT <-|       <out>        | init module, store <out> callback
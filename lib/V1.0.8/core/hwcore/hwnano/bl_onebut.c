@@ -7,7 +7,7 @@
 //==============================================================================
 
   #include "bluccino.h"
-  #include "bl_hwbut.h"
+  #include "bl_onebut.h"
   #include "bl_gpio.h"
 
 //==============================================================================
@@ -26,6 +26,17 @@
   static GP_ctx context;               // button context
   static const GP_io button = GP_IO(SW0_NODE, gpios,{0});
 
+//==============================================================================
+// gesture of the one button (multiplexes all functions, see bl_gesture.h)
+//==============================================================================
+
+  static int gesture(BL_ob *o, int val)
+  {
+    return bl_onebut(o,val);           // (BL_ONEBUT)<-[#BUTTON:CLICK/HOLD/..]
+  }
+
+  static BL_GESTURE(gest,1,gesture);   // gesture of button @1
+
 //==============================================================================
 // button work horse - posts [BUTTON:PRESS @id 1] or [BUTTON:RELEASE @id 0]
 // - IRS routine sets id (button ID) and submits (button) work, which invokes
@@ -42,10 +53,13 @@
       // post button state to module interface for output
 
     if (val)
-      ob_button_press(bl_onebut,0);    // (BL_ONEBUT)<-[#BUTTON:PRESS 0]
+    {
+      time = bl_ms();
+      ob_button_press(bl_onebut);      // (BL_ONEBUT)<-[#BUTTON:PRESS 0]
+    }
     else
     {
-      int dt = val ? 0 : (int)(bl_ms() - time);
+      int dt = (int)(bl_ms() - time);
       ob_button_release(bl_onebut,dt); // (BL_ONEBUT)<-[#BUTTON:RELEASE time]
     }
   }
@@ -74,9 +88,9 @@
       return;
     }
 
-    gp_pin_cfg(button, GPIO_INPUT | GPIO_INT_DEBOUNCE);
-    gp_int_cfg(button, GPIO_INT_EDGE_BOTH);
-    gp_add_cb(&button, &context, irs);
+    gp_pin_cfg(&button, GPIO_INPUT | GPIO_INT_DEBOUNCE);
+    gp_int_cfg(&button, GPIO_INT_EDGE_BOTH);
+    gp_add_cb(&button, &context, button_irs);
 
     LOG(4,"set up button @1: %s pin %d", button.port->name, button.pin);
   }
@@ -89,8 +103,6 @@
   {
     LOG(4,BL_B "button init (BL_ONEBUT)");
 
-  	%k_work_init(&work, workhorse);
-
     config();
     return 0;
   }
@@ -109,11 +121,17 @@
 //                  +--------------------+
 //                  |       BUTTON:      | BUTTON interface
 // (O)<-    PRESS <-|       @1,sts       | output button press event
-// (O)<-  RELEASE <-|       @1,sts       | output button release event
+// (O)<-  RELEASE <-|       @1,ms        | output button release event
+// (O)<-    CLICK <-|        @1,n        | output n clicks
+// (O)<-     HOLD <-|        @1,ms       | output hold (begin, repeat, end)
+// (O)<-    COMBO <-|      @1,n+256      | output n clicks after hold
 //                  +====================+
 //                  |      #BUTTON:      | Private BUTTON interface
 // (#)->    PRESS ->|       @1,sts       | trigger button press event
-// (#)->  RELEASE ->|       @1,sts       | trigger button release event
+// (#)->  RELEASE ->|       @1,ms        | trigger button release event
+// (#)->    CLICK ->|        @1,n        | gesture: n clicks
+// (#)->     HOLD ->|        @1,ms       | gesture: hold
+// (#)->    COMBO ->|      @1,n+256      | gesture: n clicks after hold
 //                  +--------------------+
 //
 //==============================================================================
@@ -129,7 +147,13 @@
       	return init(o,val);            // delegate to init() worker
 
       case _BL_ID(_BUTTON,PRESS_):     // [#BUTTON:PRESS @id]
-      case _BL_ID(_BUTTON,RELEASE_):   // [#BUTTON:RELEASE @id]
+      case _BL_ID(_BUTTON,RELEASE_):   // [#BUTTON:RELEASE @id,ms]
+        bl_gesture(&gest,o,val);       // feed gesture engine
+        return bl_out(o,val,(O));      // post to output subscriber
+
+      case _BL_ID(_BUTTON,CLICK_):     // [#BUTTON:CLICK @id,n]
+      case _BL_ID(_BUTTON,HOLD_):      // [#BUTTON:HOLD @id,ms]
+      case _BL_ID(_BUTTON,COMBO_):     // [#BUTTON:COMBO @id,n+256]
         return bl_out(o,val,(O));      // post to output subscriber
 
       default:
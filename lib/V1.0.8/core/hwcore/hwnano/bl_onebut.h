@@ -8,6 +8,9 @@
 // BUTTON interface
 // - button presses notify with [BUTTON:PRESS @id 1] with @id = 1..4
 // - button releases notify with [BUTTON:RELESE @id 0] with @id = 1..4
+// - all functions are multiplexed on the one button by gestures (see
+//   bl_gesture.h): [BUTTON:CLICK @1,n] for n clicks, [BUTTON:HOLD @1,ms]
+//   with repeat, [BUTTON:COMBO @1,n+256] for n clicks right after a hold
 //==============================================================================
 
 #ifndef __BL_ONEBUT_H__
@@ -27,7 +30,10 @@
 //                  +--------------------+
 //                  |       BUTTON:      | BUTTON interface
 // (O)<-    PRESS <-|       @1,sts       | output button press event
-// (O)<-  RELEASE <-|       @1,sts       | output button release event
+// (O)<-  RELEASE <-|       @1,ms        | output button release event
+// (O)<-    CLICK <-|        @1,n        | output n clicks
+// (O)<-     HOLD <-|        @1,ms       | output hold (begin, repeat, end)
+// (O)<-    COMBO <-|      @1,n+256      | output n clicks after hold
 //                  +====================+
 //                  |      #BUTTON:      | Private BUTTON interface
 // (#)->    PRESS ->|       @1,sts       | trigger button press event
@@ -61,13 +67,13 @@
 
 //==============================================================================
 // syntactic sugar: pseudo-invoke button release event (@id:1 - only one button)
-// - usage: ob_button_release(bl_onebut)
+// - usage: ob_button_release(bl_onebut,ms)   // ms: time since press
 //==============================================================================
 
-  static inline int bl_button_release(BL_oval module)
+  static inline int ob_button_release(BL_oval module, int ms)
   {
     BL_ob oo = {BL_AUG(_BUTTON),RELEASE_,1,NULL};
-    return module(&oo,0);                // pass val=0 to indicate 'inactive'
+    return module(&oo,ms);               // pass elapsed ms-time since press
   }
 
 #endif // __BL_ONEBUT_H__
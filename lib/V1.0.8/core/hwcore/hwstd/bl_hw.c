@@ -250,10 +250,12 @@
 //                  |        LED:        | LED: input interface
 // (D)->      SET ->|      @id,onoff     | set LED @id on/off (i=0..4)
 // (D)->   TOGGLE ->|                    | toggle LED @id (i=0..4)
+// (D)->     MASK ->|     @mask,bits     | set/toggle masked LEDs at once
 //                  |....................|
 //                  |        LED:        | LED: output interface
 // (L)<-      SET <-|      @id,onoff     | set LED @id on/off (i=0..4)
 // (L)<-   TOGGLE <-|                    | toggle LED @id (i=0..4)
+// (L)<-     MASK <-|     @mask,bits     | set/toggle masked LEDs at once
 //                  +--------------------+
 //                  |       BUTTON:      | BUTTON input interface
 // (B)->    PRESS ->|        @id,1       | button @id pressed (rising edge)
@@ -285,59 +287,69 @@
 //
 //==============================================================================
 
-  int bl_hw(BL_ob *o, int val)         // HW core module interface
+  static BL_oval hw_up_cb = bl_up;     // (U) <out> messages go to BL_UP
+  static BL_oval hw_led_cb = bl_hwled; // (L) callback to go to BL_HWLED
+  static BL_oval hw_but_cb = bl_hwbut; // (B) callback to go to BL_HWBUT
+  static BL_oval hw_nvm_cb = bl_hwnvm; // (N) callback to go to BL_HWNVM
+
+  static int hw_init(BL_ob *o, int val)     // [SYS:INIT <cb>] worker
   {
-    static BL_oval U = bl_up;          // <out> messages go to BL_UP by default
-    static BL_oval L = bl_hwled;       // (L) callback to go to BL_HWLED
-    static BL_oval B = bl_hwbut;       // (B) callback to go to BL_HWBUT
-    static BL_oval N = bl_hwnvm;       // (N) callback to go to BL_HWNVM
+    LOG(3,BL_C "init HW core ...");
+    hw_up_cb = bl_cb(o,hw_up_cb,WHO"(U)");  // store output callback
+    bl_init(hw_but_cb,hw_up_cb);       // init bl_hwbut module, output goes up
+    bl_init(hw_led_cb,hw_up_cb);       // init bl_hwled module, output goes up
+    bl_init(hw_nvm_cb,hw_up_cb);       // init bl_hwnvm module, output goes up
+    return 0;                          // OK
+  }
 
-    switch (bl_id(o))
-    {
-      case SYS_INIT_0_cb_0:
-      {
-        LOG(3,BL_C "init HW core ...");
-        U = bl_cb(o,(U),WHO"(U)");     // store output callback
-        bl_init((B),(U));              // init bl_hwbut module, output goes up
-        bl_init((L),(U));              // init bl_hwled module, output goes up
-        bl_init((N),(U));              // init bl_hwnvm module, output goes up
-      	return 0;                      // OK
-      }
+  static int hw_up(BL_ob *o, int val)  { return bl_fwd(o,val,hw_up_cb); }
+  static int hw_led(BL_ob *o, int val) { return bl_fwd(o,val,hw_led_cb); }
+  static int hw_but(BL_ob *o, int val) { return bl_fwd(o,val,hw_but_cb); }
+  static int hw_nvm(BL_ob *o, int val) { return bl_fwd(o,val,hw_nvm_cb); }
+  static int hw_out(BL_ob *o, int val) { return bl_out(o,val,hw_up_cb); }
 
-      case SYS_TICK_id_BL_pace_cnt:
-        return bl_fwd(o,val,(B));      // tick bl_hwbut module
+  BL_OPS(hw_sys,_SYS,
+    BL_ON(SYS_INIT_0_cb_0,          hw_init),
+    BL_ON(SYS_TICK_id_BL_pace_cnt,  hw_but),     // tick bl_hwbut module
+    BL_ON(SYS_TOCK_id_BL_pace_cnt,  hw_nvm));    // tock bl_hwnvm module
 
-      case SYS_TOCK_id_BL_pace_cnt:
-        return bl_fwd(o,val,(N));      // tock bl_hwnvm module
+  BL_OPS(hw_led_row,_LED,                         // forward to LED driver
+    BL_ON(LED_SET_id_0_onoff,       hw_led),
+    BL_ON(LED_TOGGLE_id_0_0,        hw_led),
+    BL_ON(LED_MASK_mask_0_bits,     hw_led));
 
-      case LED_SET_id_0_onoff:
-      case LED_TOGGLE_id_0_0:
-        return bl_fwd(o,val,(L));      // forward to LED driver module
+  BL_OPS(hw_button,_BUTTON,
+    BL_ON(BUTTON_PRESS_id_0_0,      hw_up),      // forward to up gear
+    BL_ON(BUTTON_RELEASE_id_0_ms,   hw_up),
+    BL_ON(BUTTON_CLICK_id_0_cnt,    hw_up),
+    BL_ON(BUTTON_HOLD_id_0_ms,      hw_up),
+    BL_ON(BUTTON_CFG_0_0_mask,      hw_but),     // config bl_hwbut module
+    BL_ON(BUTTON_MS_0_0_ms,         hw_but));
 
-      case BUTTON_PRESS_id_0_0:
-      case BUTTON_RELEASE_id_0_ms:
-      case BUTTON_CLICK_id_0_cnt:
-      case BUTTON_HOLD_id_0_ms:
-      case SWITCH_STS_id_0_sts:
-        return bl_fwd(o,val,(U));      // forward message to up gear
+  BL_OPS(hw_switch,_SWITCH,
+    BL_ON(SWITCH_STS_id_0_sts,      hw_up));     // forward to up gear
 
-      case BUTTON_CFG_0_0_mask:
-      case BUTTON_MS_0_0_ms:
-        return bl_fwd(o,val,(B));      // config bl_hwbut module
+  BL_OPS(hw_nvm_row,_NVM,                         // forward to bl_hwnvm
+    BL_ON(NVM_LOAD_0_BL_dac_0,      hw_nvm),
+    BL_ON(NVM_SAVE_0_BL_dac_0,      hw_nvm),
+    BL_ON(NVM_STORE_id_0_val,       hw_nvm),
+    BL_ON(NVM_RECALL_id_0_0,        hw_nvm),
+    BL_ON(NVM_AVAIL_0_0_0,          hw_nvm));
 
-      case NVM_LOAD_0_BL_dac_0:
-      case NVM_SAVE_0_BL_dac_0:
-      case NVM_STORE_id_0_val:
-      case NVM_RECALL_id_0_0:
-      case NVM_AVAIL_0_0_0:
-        return bl_fwd(o,val,(N));      // forward to bl_hwnvm module
+  BL_OPS(hw_aug_nvm,BL_AUG(_NVM),
+    BL_ON(_NVM_READY_0_0_sts,       hw_out));    // forward to up gear
 
-      case _NVM_READY_0_0_sts:
-        return bl_out(o,val,(U));      // forward to up gear
+  BL_DISPATCH(bl_hw_ifc,
+    BL_ROW(hw_sys),
+    BL_ROW(hw_led_row),
+    BL_ROW(hw_button),
+    BL_ROW(hw_switch),
+    BL_ROW(hw_nvm_row),
+    BL_ROW(hw_aug_nvm));
 
-      default:
-        return -1;                     // bad input
-    }
+  int bl_hw(BL_ob *o, int val)         // HW core module interface
+  {
+    return bl_dispatch(&bl_hw_ifc,o,val);     // -1: bad input
   }
 
 //==============================================================================
@@ -35,12 +35,23 @@
   #define SW2_NODE      DT_ALIAS(sw2)
   #define SW3_NODE      DT_ALIAS(sw3)
 
+  #ifndef CFG_BUT_EDGES
+    #define CFG_BUT_EDGES      8       // edge ring size per button (power of 2)
+  #endif
+
+  #ifndef CFG_BUT_DEBOUNCE
+    #define CFG_BUT_DEBOUNCE  20       // debounce time (ms), 0: no debouncing
+  #endif
+
+  #if (CFG_BUT_EDGES & (CFG_BUT_EDGES-1))
+    #error "CFG_BUT_EDGES must be a power of 2"
+  #endif
+
 //==============================================================================
 // Get button configuration from the devicetree sw0 alias. This is mandatory.
 //==============================================================================
 
   static BL_word mask = 0xFFFF;        // all button events enabled
-  static int id = 0;                   // button ID
   static GP_ctx context[N];            // button context
 
   static const GP_io button[N] =
@@ -51,139 +62,204 @@
                  GP_IO(SW3_NODE, gpios,{0}),
                };
 
-  static int ms = 350;                   // click grace time (ms)
-  static BL_ms time[N+1]  = {0,0,0,0,0}; // button press time for click detection
-  static bool hold[N+1]   = {0,0,0,0,0}; // button is in a HOLD phase
   static bool toggle[N+1] = {0,0,0,0,0}; // toggle switch states
 
 //==============================================================================
-// click modul (click/hold detection)
-// - usage: val = click(o,val)   // val = 0:click, 1:hold
-// - supports 4 buttons (@id:1..4) and the default button (@id:0)
+// gesture output (filters recognized gestures by event mask)
+// - button gestures are recognized by the gesture engine (bl_gesture.h)
+// - supports 4 buttons (@id:1..4)
 //==============================================================================
 //
-// (B) := (bl_hwbut);
+// (E) := (bl_gesture);  (B) := (bl_hwbut);
 //
 //                  +--------------------+
-//                  |        click       | module click
+//                  |       gesture      | gesture output
 //                  +--------------------+
-//                  |       BUTTON:      | BUTTON interface
-// (B)<-    CLICK <-|     @id,clicks     | button click (click time < ms)
-// (B)<-     HOLD <-|       @id,ms       | button hold (hold time >= ms)
-//                  |....................|
 //                  |      #BUTTON:      | internal BUTTON interface
-// (#)->    PRESS ->|       @id,0        | receive button press event
-// (#)->  RELEASE ->|       @id,ms       | receive button release event
+// (E)->    CLICK ->|       @id,n        | n clicks (click time < ms)
+// (E)->     HOLD ->|       @id,ms       | button hold (hold time >= ms)
+// (E)->    COMBO ->|     @id,n+256*h    | n clicks while button @h held
+//                  |....................|
+//                  |       BUTTON:      | BUTTON interface
+// (B)<-    CLICK <-|       @id,n        | button click (and COMBO if disabled)
+// (B)<-     HOLD <-|       @id,ms       | button hold
+// (B)<-    COMBO <-|     @id,n+256*h    | button combo
 //                  +--------------------+
 //
 //==============================================================================
 
-  static int click(BL_ob *o, int val)
+  static int gesture(BL_ob *o, int val)
   {
-    static BL_oval B = bl_hwbut;
-
-    int id = o->id;                    // short hand for @id
-    BL_ms now = bl_ms();
-
-    if (id < 0 || id > N)
-      return -1;                       // bad args
-
     switch (bl_id(o))
     {
-      case _BUTTON_PRESS_id_0_0:
-      {
-        time[id] = now;                // store button press time stamp
-        if (mask & BL_CLICK)
-        {
-          LOG(4,BL_B "button click (begin)");
-          bl_post((B), _BUTTON_CLICK_id_0_cnt, id,NULL,0);
-        }
-        return 0;
-      }
-
-      case _BUTTON_RELEASE_id_0_ms:
-        val = (now >= time[id] + ms);  // grace time exceeded? (return value)
+      case _BUTTON_CLICK_id_0_cnt:
+        return (mask & BL_CLICK) ? bl_fwd(o,val,(PMI)) : 0;
 
-        if (val)                       // grace time exceeded?
-        {
-          val = 0;                     // return value = 0
-          if (mask & BL_HOLD)
-          {
-            BL_ms dt = now - time[id]; // hold time
-            LOG(4,BL_B "button hold event");
-            bl_post((B), _BUTTON_HOLD_id_0_ms, id,NULL,(int)dt);
-          }
-        }
-        else                           // within grace time!
-        {
-          val = 0;                     // return value = 0
-          if (mask & BL_CLICK)
-          {
-            int count = 1;             // 1 click
-            LOG(4,BL_B "button clicked %d times",count);
-            bl_post((B), _BUTTON_CLICK_id_0_cnt, id,NULL,count);
-          }
-        }
+      case _BUTTON_HOLD_id_0_ms:
+        return (mask & BL_HOLD) ? bl_fwd(o,val,(PMI)) : 0;
 
-        time[id] = 0;                  // inactivate click tracking for @id
-        hold[id] = 0;                  // clear button HOLD state
-        return val;
+      case _BUTTON_COMBO_id_0_cnt:
+        if (mask & BL_COMBO)
+          return bl_fwd(o,val,(PMI));
+        if (mask & BL_CLICK)           // combo not enabled: plain clicks
+          return bl_post((PMI), _BUTTON_CLICK_id_0_cnt, o->id,NULL,val % 256);
+        return 0;
 
       default:
         return -1;                     // bad arg
     }
   }
 
+  static BL_gesture gest[N] =          // gestures of buttons @1..@4
+                    {
+                      BL_GESTURE_INIT(1,gesture),
+                      BL_GESTURE_INIT(2,gesture),
+                      BL_GESTURE_INIT(3,gesture),
+                      BL_GESTURE_INIT(4,gesture),
+                    };
+
 //==============================================================================
-// button work horse - posts [BUTTON:PRESS @id 1] or [BUTTON:RELEASE @id 0]
-// - IRS routine sets id (button ID) and submits (button) work, which invokes
-// - workhorse to process [BUTTON:PRESS @id 1] or [BUTTON:RELEASE @id,0]
+// per button edge ring and debouncer
+// - ISRs push time stamped pin levels into the edge ring of their button
+//   (single producer per ring, no locking), the work horse is the consumer
+// - a button is debounced when its pin level has been stable for
+//   CFG_BUT_DEBOUNCE ms, the settle timer re-invokes the work horse then
 //==============================================================================
 
-  static void workhorse(struct k_work *work)
-  {
-    static BL_oval C = click;          // process CLICK/HOLD events
+  typedef struct BL_edge               // pin edge event
+          {
+            uint32_t us;               // time stamp (us, wraps around)
+            int8_t level;              // pin level after the edge
+          } BL_edge;
 
-    if (id < 1 || id > N)
-      return;                          // ignore out of range ID values
+  typedef struct BL_butq               // per button edge ring & debouncer
+          {
+            BL_edge edge[CFG_BUT_EDGES];   // edge ring
+            uint32_t head;             // write index (ISR)
+            uint32_t tail;             // read index (work horse)
+            uint32_t lost;             // edges lost by ring overflow
+            int8_t level;              // raw pin level (last edge)
+            int8_t state;              // debounced pin level (reported)
+            uint32_t since;            // time stamp of last raw level change
+            uint32_t pressed;          // time stamp of debounced press
+          } BL_butq;
+
+  static BL_butq butq[N];              // edge rings & debouncers
+
+  static void workhorse(struct k_work *work);
+  K_WORK_DEFINE(work, workhorse);      // assign work with workhorse
 
-    int idx = id-1;
-    int val = gp_pin_get(button+idx);  // read I/O pin input value
+  static void settled(struct k_timer *timer)
+  {
+    k_work_submit(&work);              // debounce time over: check levels
+  }
+
+  K_TIMER_DEFINE(settle, settled, NULL);   // debounce settle timer
 
-      // post button state to module interface for output
+//==============================================================================
+// helper: report a debounced level change of button @id
+//==============================================================================
 
-    //LOG(4,BL_Y"button @%d %s",id,val?"press":"release");
+  static void report(int id, BL_butq *q)
+  {
+    int idx = id-1;
+    BL_ob oo = {BL_AUG(_BUTTON),q->state ? PRESS_ : RELEASE_,id,NULL};
 
-    if (val)                           // [BUTTON:PRESS 0] event
-		{
+    if (q->state)                      // [BUTTON:PRESS 0] event
+    {
+      q->pressed = q->since;
       if (mask & BL_PRESS)
         bl_post((PMI), _BUTTON_PRESS_id_0_0, id,NULL,0);
 
-      bl_post((C), _BUTTON_PRESS_id_0_0, id,NULL,0);
+      bl_gesture(gest+idx,&oo,0);      // feed gesture engine
       toggle[idx] = !toggle[idx];
       if (mask & BL_SWITCH)
         bl_post((PMI), _SWITCH_STS_id_0_sts, id,NULL,toggle[idx]);
     }
     else                               // [BUTTON:RELEASE ms] event
     {
-      int dt = (int)(bl_ms() - time[id]);
+      int dt = (int)((q->since - q->pressed) / 1000);   // edge to edge
       if (mask & BL_RELEASE)
         bl_post((PMI), _BUTTON_RELEASE_id_0_ms, id,NULL,dt);
 
-      bl_post((C), _BUTTON_RELEASE_id_0_ms, id,NULL,dt);
+      bl_gesture(gest+idx,&oo,dt);     // feed gesture engine
     }
   }
 
-  K_WORK_DEFINE(work, workhorse);      // assign work with workhorse
+//==============================================================================
+// button work horse - posts [BUTTON:PRESS @id 1] or [BUTTON:RELEASE @id 0]
+// - drains the edge rings of all buttons in one pass, reports debounced level
+//   changes and re-arms the settle timer for buttons which are still bouncing
+//==============================================================================
+
+  static void workhorse(struct k_work *work)
+  {
+    uint32_t now = (uint32_t)bl_us();
+    uint32_t wait = 0;                 // min remaining settle time (0: none)
+
+    for (int idx=0; idx < N; idx++)
+    {
+      BL_butq *q = butq + idx;
+      uint32_t head = __atomic_load_n(&q->head,__ATOMIC_ACQUIRE);
+
+      for (; q->tail != head; q->tail++)   // drain edge ring
+      {
+        BL_edge *e = q->edge + (q->tail & (CFG_BUT_EDGES-1));
+        if (e->level != q->level)
+        {
+          q->level = e->level;
+          q->since = e->us;
+        }
+      }
+
+      uint32_t lost = __atomic_exchange_n(&q->lost,0,__ATOMIC_RELAXED);
+      if (lost)                        // ring overflow: resync with pin
+      {
+        LOG(2,BL_R "button @%d: %d edges lost",idx+1,lost);
+        int level = gp_pin_get(button+idx);
+        if (level != q->level)
+        {
+          q->level = level;
+          q->since = now;
+        }
+      }
+
+      if (q->level == q->state)
+        continue;                      // stable
+
+      uint32_t age = now - q->since;
+      if (age >= CFG_BUT_DEBOUNCE*1000)
+      {
+        q->state = q->level;           // debounced level change
+        report(idx+1,q);
+      }
+      else if (!wait || CFG_BUT_DEBOUNCE*1000 - age < wait)
+        wait = CFG_BUT_DEBOUNCE*1000 - age;
+    }
+
+    if (wait)                          // some button still bouncing
+      k_timer_start(&settle,K_USEC(wait),K_NO_WAIT);
+  }
 
 //==============================================================================
-// submit button work for button @id
+// submit edge of button @id (ISR context)
 //==============================================================================
 
   static void submit(int bid)
   {
-    id = bid;                          // store global button ID
-    k_work_submit(&work);              // invoke workhorse(), which picks id
+    BL_butq *q = butq + (bid-1);
+    uint32_t head = q->head;           // we are the only producer
+
+    if (head - __atomic_load_n(&q->tail,__ATOMIC_ACQUIRE) >= CFG_BUT_EDGES)
+      __atomic_add_fetch(&q->lost,1,__ATOMIC_RELAXED);   // ring full
+    else
+    {
+      BL_edge *e = q->edge + (head & (CFG_BUT_EDGES-1));
+      e->us = (uint32_t)bl_us();
+      e->level = (int8_t)gp_pin_get(button+(bid-1));
+      __atomic_store_n(&q->head,head+1,__ATOMIC_RELEASE);
+    }
+    k_work_submit(&work);              // no-op if work is already pending
   }
 
 //==============================================================================
@@ -241,34 +317,6 @@
            id, button[idx].port->name, button[idx].pin);
   }
 
-//==============================================================================
-// worker: ticking
-//==============================================================================
-
-  static int sys_tick(BL_ob *o, int val)
-  {
-    BL_ms now = bl_ms();
-
-    for (int id=0; id <= N; id++)
-    {
-      if ( time[id] )
-      {
-        int held = now - time[id];     // hold time
-        if ( held >= ms && !hold[id] )
-        {
-          hold[id] = true;             // button @id entered HOLD state
-					if (mask & BL_HOLD)
-					{
-            LOG(4,BL_Y "button hold (begin)");
-            bl_post((PMI), _BUTTON_HOLD_id_0_ms, id,NULL,0);
-					}
-        }
-      }
-    }
-
-    return 0;                      // OK
-  }
-
 //==============================================================================
 // worker: init module
 //==============================================================================
@@ -295,13 +343,14 @@
 //                  +--------------------+
 //                  |        SYS:        | SYS interface
 // (!)->     INIT ->|       <out>        | init module, ignore <out> callback
-// (!)->     TICK ->|       @id,cnt      | tick module
+// (!)->     TICK ->|       @id,cnt      | tick module (ignored)
 //                  +--------------------+
 //                  |       BUTTON:      | BUTTON output interface
 // (U)<-    PRESS <-|        @id,0       | button press at time 0
 // (U)<-  RELEASE <-|        @id,ms      | button release after elapsed ms-time
 // (U)<-    CLICK <-|        @id,n       | number of button clicks
 // (U)<-     HOLD <-|       @id,ms       | button hold event at ms-time
+// (U)<-    COMBO <-|     @id,n+256*h    | n clicks of @id while @h held
 // (!)->      CFG ->|        mask        | config button event mask
 // (!)->       MS ->|         ms         | set click/hold discrimination time
 //                  +--------------------+
@@ -325,20 +374,22 @@
       	return sys_init(o,val);           // delegate to sys_init() worker
 
       case SYS_TICK_id_BL_pace_cnt:
-      	return sys_tick(o,val);           // delegate to sys_tick() worker
+      	return 0;                         // gestures are timer driven
 
       case BUTTON_CFG_0_0_mask:
 			  mask = (BL_word)val;              // store event mask
       	return 0;                         // OK
 
       case BUTTON_MS_0_0_ms:              // config click/hold discrim. time
-			  ms = val;                         // store grace time
+        for (int i=0; i < N; i++)
+          gest[i].hold = val;             // store grace time
       	return 0;                         // OK
 
       case _BUTTON_PRESS_id_0_0:
       case _BUTTON_RELEASE_id_0_ms:
       case _BUTTON_CLICK_id_0_cnt:
       case _BUTTON_HOLD_id_0_ms:
+      case _BUTTON_COMBO_id_0_cnt:
         return bl_out(o,val,(U));         // post to output subscriber
 
       case _SWITCH_STS_id_0_sts:
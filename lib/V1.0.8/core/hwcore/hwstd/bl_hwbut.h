@@ -14,6 +14,19 @@
 //   on [BUTTON:PRESS @id,sts] events
 // - each change of the logical switch state is notified by a
 //   [SWITCH:SET @id,onoff] event message
+//
+// Debouncing
+// - button ISRs record time stamped pin levels in a per button edge ring
+//   (CFG_BUT_EDGES entries), so simultaneous presses of several buttons are
+//   never overwritten; one work item drains all rings in one pass
+// - PRESS/RELEASE is reported when the pin level has been stable for
+//   CFG_BUT_DEBOUNCE ms (default 20 ms, settle timer driven); the RELEASE ms
+//   value is measured between the (debounced) press and release edges
+//
+// Gestures
+// - debounced edges feed the gesture engine (bl_gesture.h), which reports
+//   multi-clicks [BUTTON:CLICK @id,n], holds [BUTTON:HOLD @id,ms] with
+//   repeat and hold+click combos [BUTTON:COMBO @id,n+256*h] timer driven
 //==============================================================================
 
 #ifndef __BL_HWBUT_H__
@@ -37,6 +50,7 @@
 // (^)<-  RELEASE <-|        @id,ms      | button release after elapsed ms-time
 // (^)<-    CLICK <-|        @id,n       | number of button clicks
 // (^)<-     HOLD <-|       @id,ms       | button hold event at ms-time
+// (^)<-    COMBO <-|     @id,n+256*h    | n clicks of @id while @h held
 // (!)->      CFG ->|        mask        | config button event mask
 //                  +--------------------+
 //                  |       SWITCH:      | SWITCH interface
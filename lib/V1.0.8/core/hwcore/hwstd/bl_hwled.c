@@ -53,6 +53,20 @@
   static bool led_onoff[4] = {0,0,0,0};
   static const struct device *led_device[4];
 
+  static const gpio_pin_t led_pin[4] =   // GPIO pins of LEDs @1..@4
+         {
+           DT_GPIO_PIN(LED0_NODE, gpios),  DT_GPIO_PIN(LED1_NODE, gpios),
+           DT_GPIO_PIN(LED2_NODE, gpios),  DT_GPIO_PIN(LED3_NODE, gpios),
+         };
+
+  static const bool led_low[4] =       // active low LEDs (logical -> raw)
+         {
+           (DT_GPIO_FLAGS(LED0_NODE, gpios) & GPIO_ACTIVE_LOW) != 0,
+           (DT_GPIO_FLAGS(LED1_NODE, gpios) & GPIO_ACTIVE_LOW) != 0,
+           (DT_GPIO_FLAGS(LED2_NODE, gpios) & GPIO_ACTIVE_LOW) != 0,
+           (DT_GPIO_FLAGS(LED3_NODE, gpios) & GPIO_ACTIVE_LOW) != 0,
+         };
+
 //==============================================================================
 // LED set  [SET:LED @id onoff]  // @id = 1..4
 //==============================================================================
@@ -105,6 +119,48 @@
     return ok;
   }
 
+//==============================================================================
+// LED mask  [LED:MASK @mask,bits]  // bit i of mask/bits: LED @i (i = 0..4)
+// - LED @0 (status LED) is re-mapped to LED @1, bits = -1 toggles the LEDs
+// - LEDs sharing a GPIO port are changed by one port write (glitch free)
+//==============================================================================
+
+  static int led_mask(int mask, int bits)
+  {
+    if (mask & 1)                      // status LED @0 -> LED @1
+    {
+      mask |= 2;
+      if (bits >= 0)
+        bits = (bits & ~2) | ((bits & 1) << 1);
+    }
+
+    bool done[N] = {0,0,0,0};
+    for (int i=0; i < NLEDS; i++)      // LED @i+1 <-> mask bit i+1
+    {
+      if (done[i] || !(mask & (2 << i)))
+        continue;
+
+      const struct device *dev = led_device[i];
+      gpio_port_pins_t pins = 0;
+      gpio_port_value_t value = 0;
+
+      for (int j=i; j < NLEDS; j++)    // collect LEDs on the same port
+      {
+        if (!(mask & (2 << j)) || led_device[j] != dev)
+          continue;
+
+        led_onoff[j] = (bits < 0) ? !led_onoff[j] : ((bits & (2 << j)) != 0);
+        pins |= BIT(led_pin[j]);
+        if (led_onoff[j] != led_low[j])
+          value |= BIT(led_pin[j]);
+        done[j] = true;
+      }
+
+      gpio_port_set_masked_raw(dev,pins,value);   // one write per port
+    }
+    return 0;
+  }
+
 //==============================================================================
 // LED init
 //==============================================================================
@@ -160,37 +216,49 @@
 //                  |        LED:        | LED interface
 // (!)->      SET ->|      @id,onoff     | set LED's onoff state
 // (!)->   TOGGLE ->|        @id         | toggle LED's onoff state
+// (!)->     MASK ->|     @mask,bits     | set/toggle (bits=-1) masked LEDs
 //                  +--------------------+
 //
 //==============================================================================
 
-  int bl_hwled(BL_ob *o, int val)      // public module interface
+  static int hwled_set(BL_ob *o, int val)  // [LED:SET @id,onoff] worker
   {
-    switch (bl_id(o))
-    {
-      case SYS_INIT_0_cb_0:
-      	return sys_init(o,val);        // delegate to sys_init() worker
+    BL_ob oo ={o->cl,o->op,1,NULL};    // change @id=0 -> @id=1
+    if (o->id)
+      LOGO(4,"@",o,val);
 
-      case LED_SET_id_0_onoff:
-      {
-        BL_ob oo ={o->cl,o->op,1,NULL};// change @id=0 -> @id=1
-        if (o->id)
-          LOGO(4,"@",o,val);
+    o = o->id ? o : &oo;               // if (o->id==0) re-map o to &oo
+    return led_set(o,val != 0);        // delegate to led_set();
+  }
 
-        o = o->id ? o : &oo;           // if (o->id==0) re-map o to &oo
-	      return led_set(o,val != 0);    // delegate to led_set();
-      }
+  static int hwled_toggle(BL_ob *o, int val)  // [LED:TOGGLE @id] worker
+  {
+    BL_ob oo = {o->cl,o->op,1,NULL};   // change @id=0 -> @id=1
+    o = o->id ? o : &oo;               // if (o->id==0) re-map o to &oo
+    return led_toggle(o,val);          // delegate to led_toggle();
+  }
 
-      case LED_TOGGLE_id_0_0:
-      {
-        BL_ob oo = {o->cl,o->op,1,NULL};  // change @id=0 -> @id=1
-        o = o->id ? o : &oo;           // if (o->id==0) re-map o to &oo
-	      return led_toggle(o,val);      // delegate to led_toggle();
-      }
+  static int hwled_mask(BL_ob *o, int val) // [LED:MASK @mask,bits] worker
+  {
+    LOGO(4,"@",o,val);
+    return led_mask(o->id,val);        // delegate to led_mask();
+  }
 
-      default:
-	      return -1;                     // bad input
-    }
+  BL_OPS(hwled_sys,_SYS,
+    BL_ON(SYS_INIT_0_cb_0, sys_init)); // delegate to sys_init() worker
+
+  BL_OPS(hwled_led,_LED,
+    BL_ON(LED_SET_id_0_onoff, hwled_set),
+    BL_ON(LED_TOGGLE_id_0_0,  hwled_toggle),
+    BL_ON(LED_MASK_mask_0_bits, hwled_mask));
+
+  BL_DISPATCH(bl_hwled_ifc,
+    BL_ROW(hwled_sys),
+    BL_ROW(hwled_led));
+
+  int bl_hwled(BL_ob *o, int val)      // public module interface
+  {
+    return bl_dispatch(&bl_hwled_ifc,o,val);  // -1: bad input
   }
 
 //==============================================================================
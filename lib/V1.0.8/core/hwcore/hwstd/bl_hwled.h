@@ -8,6 +8,8 @@
 // LED interface:
 // - LED messages [LED:SET @id onoff] control the onoff state of one of the four
 // - LEDs @1..@4. LED @0 is the status LED which will be remapped to LED @1
+// - [LED:MASK @mask,bits] sets (or toggles, bits=-1) all LEDs @i with bit i
+//   of mask at once, LEDs sharing a GPIO port are written by one port access
 //==============================================================================
 
 #ifndef __BL_HWLED_H__
@@ -27,11 +29,13 @@
 //                  |        LED:        | LED interface
 // (!)->      SET ->|      @id,onoff     | set LED's onoff state
 // (!)->   TOGGLE ->|        @id         | toggle LED's onoff state
+// (!)->     MASK ->|     @mask,bits     | set/toggle (bits=-1) masked LEDs
 //                  +--------------------+
 //
 //==============================================================================
 
   int bl_hwled(BL_ob *o, int val);       // HW core module interface
+  extern const BL_dispatch bl_hwled_ifc; // dispatch table (introspection)
 
 //==============================================================================
 // syntactic sugar: LED moduler init
@@ -245,10 +245,12 @@
 //                  |        LED:        | LED input interface
 // (D)->      SET ->|      @id,onoff     | set LED @id on/off (i=0..4)
 // (D)->   TOGGLE ->|                    | toggle LED @id (i=0..4)
+// (D)->     MASK ->|     @mask,bits     | set/toggle masked LEDs at once
 //                  |....................|
 //                  |        LED:        | LED output interface
 // (L)<-      SET <-|      @id,onoff     | set LED @id on/off (i=0..4)
 // (L)<-   TOGGLE <-|                    | toggle LED @id (i=0..4)
+// (L)<-     MASK <-|     @mask,bits     | set/toggle masked LEDs at once
 //                  +--------------------+
 //                  |       BUTTON:      | BUTTON input interface
 // (B)->    PRESS ->|        @id,1       | button @id pressed (rising edge)
@@ -300,6 +302,7 @@
 
       case LED_SET_id_0_onoff:
       case LED_TOGGLE_id_0_0:
+      case LED_MASK_mask_0_bits:
         return bl_fwd(o,val,(L));      // forward to LED driver module
 
       case BUTTON_PRESS_id_0_0:
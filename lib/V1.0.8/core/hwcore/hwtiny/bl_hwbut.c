@@ -93,6 +93,7 @@
       case _BUTTON_PRESS_id_0_0:
       {
         time[id] = now;                // store button press time stamp
+        bl_wake(now + ms);             // tickless: tick for HOLD detection
         if (mask & BL_CLICK)
         {
           LOG(4,BL_B "button click (begin)");
@@ -105,6 +105,30 @@
     return ok;
   }
 
+//==============================================================================
+// LED mask  [LED:MASK @mask,bits]  // bit i of mask/bits: LED @i (i = 0..4)
+// - LED @0 (status LED) is re-mapped to LED @1, bits = -1 toggles the LEDs
+// - tiny core: LEDs are written pin by pin (one message for all LEDs, though)
+//==============================================================================
+
+  static int led_mask(int mask, int bits)
+  {
+    if (mask & 1)                      // status LED @0 -> LED @1
+    {
+      mask |= 2;
+      if (bits >= 0)
+        bits = (bits & ~2) | ((bits & 1) << 1);
+    }
+
+    for (int id=1; id <= NLEDS; id++)
+      if (mask & (1 << id))
+      {
+        BL_ob oo = {_LED,SET_,id,NULL};
+        led_set(&oo, bits < 0 ? !led_onoff[id-1] : (bits >> id) & 1);
+      }
+    return 0;
+  }
+
 //==============================================================================
 // LED init
 //==============================================================================
@@ -160,6 +184,7 @@
 //                  |        LED:        | LED interface
 // (!)->      SET ->|      @id,onoff     | set LED's onoff state
 // (!)->   TOGGLE ->|        @id         | toggle LED's onoff state
+// (!)->     MASK ->|     @mask,bits     | set/toggle (bits=-1) masked LEDs
 //                  +--------------------+
 //
 //==============================================================================
@@ -188,6 +213,10 @@
 	      return led_toggle(o,val);      // delegate to led_toggle();
       }
 
+      case LED_MASK_mask_0_bits:
+        LOGO(4,"@",o,val);
+        return led_mask(o->id,val);    // delegate to led_mask();
+
       default:
 	      return -1;                     // bad input
     }
@@ -27,6 +27,7 @@
 //                  |        LED:        | LED interface
 // (!)->      SET ->|      @id,onoff     | set LED's onoff state
 // (!)->   TOGGLE ->|        @id         | toggle LED's onoff state
+// (!)->     MASK ->|     @mask,bits     | set/toggle (bits=-1) masked LEDs
 //                  +--------------------+
 //
 //==============================================================================
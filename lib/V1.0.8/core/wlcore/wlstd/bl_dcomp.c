@@ -67,12 +67,43 @@
     #include "bl_gonoff.h"
   #endif
 
+  #include "bl_dejavu.h"
+
 //==============================================================================
 // BL_goo data structures, for any generic on/off server
 //==============================================================================
 
   static BL_goo goo[1];              // only 1 generic on/off server
 
+//==============================================================================
+// replay caches (de-ja-vu, see bl_dejavu.h): one per server model, thus a tid
+// of one model never suppresses a SET message of another model
+//==============================================================================
+
+  static BL_DEJAVU(onoff_seen);        // generic on/off server
+  static BL_DEJAVU(level_seen);        // generic level server (set/delta/move)
+  static BL_DEJAVU(vnd_seen);          // vendor server
+  static BL_DEJAVU(lightness_seen);    // light lightness server (actual/linear)
+  static BL_DEJAVU(ctl_seen);          // light CTL server
+  static BL_DEJAVU(temp_seen);         // light CTL temperature server
+  static BL_DEJAVU(level_temp_seen);   // generic level server (temperature)
+
+    // has a message with (src,dst,tid) been processed within the last 6 s?
+
+  static inline bool dejavu(BL_dejavu *seen, BL_ctx *ctx, uint8_t tid,
+                            int64_t now)
+  {
+    return bl_dejavu(seen,ctx->addr,ctx->recv_dst,tid,now);
+  }
+
+    // remember (src,dst,tid) of a processed message
+
+  static inline void remember(BL_dejavu *seen, BL_ctx *ctx, uint8_t tid,
+                              int64_t now)
+  {
+    bl_dejavu_remember(seen,ctx->addr,ctx->recv_dst,tid,now);
+  }
+
 //==============================================================================
 // workhorse which post messages through the upward gear to the application
 //==============================================================================
@@ -313,10 +344,7 @@ static int gen_onoff_set_unack(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC)))
+	if (dejavu(onoff_seen,ctx,tid,now))
   {
  		//(void)gen_onoff_get(model, ctx, buf);
 		LOG(5,BL_Y "ignore #%d repeat tid",tid);
@@ -355,10 +383,7 @@ static int gen_onoff_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(onoff_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -427,10 +452,7 @@ SUBMIT:  dummy = 1;                    // need this in order to use label
     }
 
   	now = k_uptime_get();
-  	if (ctl->last_tid == tid &&
-  	    ctl->last_src_addr == ctx->addr &&
-  	    ctl->last_dst_addr == ctx->recv_dst &&
-  	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC)))
+  	if (dejavu(onoff_seen,ctx,tid,now))
     {
   		(void)gen_onoff_get(model, ctx, buf);
       LOG(5,BL_Y "ignore #%d repeat tid",tid);
@@ -469,10 +491,7 @@ SUBMIT:  dummy = 1;                    // need this in order to use label
   	ctl->transition->counter = 0U;
   	k_timer_stop(&ctl->transition->timer);
 
-  	ctl->last_tid = tid;
-  	ctl->last_src_addr = ctx->addr;
-  	ctl->last_dst_addr = ctx->recv_dst;
-  	ctl->last_msg_timestamp = now;
+  	remember(onoff_seen,ctx,tid,now);
   	ctl->transition->tt = tt;
   	ctl->transition->delay = delay;
   	ctl->transition->type = NON_MOVE;
@@ -600,10 +619,7 @@ static int gen_level_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -627,10 +643,7 @@ static int gen_level_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -666,10 +679,7 @@ static int gen_level_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_seen,ctx,tid,now)) {
 		(void)gen_level_get(model, ctx, buf);
 		return 0;
 	}
@@ -694,10 +704,7 @@ static int gen_level_set(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -736,10 +743,7 @@ static int gen_delta_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_seen,ctx,tid,now)) {
 
 		if (ctl->light->delta == delta) {
 			return 0;
@@ -771,10 +775,7 @@ static int gen_delta_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -818,10 +819,7 @@ static int gen_delta_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_seen,ctx,tid,now)) {
 
 		if (ctl->light->delta == delta) {
 			(void)gen_level_get(model, ctx, buf);
@@ -854,10 +852,7 @@ static int gen_delta_set(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -903,10 +898,7 @@ static int gen_move_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -930,10 +922,7 @@ static int gen_move_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
@@ -977,10 +966,7 @@ static int gen_move_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_seen,ctx,tid,now)) {
 		(void)gen_level_get(model, ctx, buf);
 		return 0;
 	}
@@ -1005,10 +991,7 @@ static int gen_move_set(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
@@ -1280,17 +1263,11 @@ static int vnd_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (state->last_tid == tid &&
-	    state->last_src_addr == ctx->addr &&
-	    state->last_dst_addr == ctx->recv_dst &&
-	    (now - state->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(vnd_seen,ctx,tid,now)) {
 		return 0;
 	}
 
-	state->last_tid = tid;
-	state->last_src_addr = ctx->addr;
-	state->last_dst_addr = ctx->recv_dst;
-	state->last_msg_timestamp = now;
+	remember(vnd_seen,ctx,tid,now);
 	state->current = current;
 
 	LOG(5,"Vendor model message = %04x", state->current);
@@ -1383,10 +1360,7 @@ static int light_lightness_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(lightness_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -1410,10 +1384,7 @@ static int light_lightness_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(lightness_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -1449,10 +1420,7 @@ static int light_lightness_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(lightness_seen,ctx,tid,now)) {
 		(void)light_lightness_get(model, ctx, buf);
 		return 0;
 	}
@@ -1477,10 +1445,7 @@ static int light_lightness_set(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(lightness_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -1571,10 +1536,7 @@ static int light_lightness_linear_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(lightness_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -1598,10 +1560,7 @@ static int light_lightness_linear_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(lightness_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -1637,10 +1596,7 @@ static int light_lightness_linear_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(lightness_seen,ctx,tid,now)) {
 		(void)light_lightness_linear_get(model, ctx, buf);
 		return 0;
 	}
@@ -1665,10 +1621,7 @@ static int light_lightness_linear_set(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(lightness_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2045,10 +1998,7 @@ static int light_ctl_set_unack(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(ctl_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -2072,10 +2022,7 @@ static int light_ctl_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(ctl_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2124,10 +2071,7 @@ static int light_ctl_set(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(ctl_seen,ctx,tid,now)) {
 		(void)light_ctl_get(model, ctx, buf);
 		return 0;
 	}
@@ -2152,10 +2096,7 @@ static int light_ctl_set(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(ctl_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2548,10 +2489,7 @@ static int light_ctl_temp_set_unack(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(temp_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -2575,10 +2513,7 @@ static int light_ctl_temp_set_unack(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2623,10 +2558,7 @@ static int light_ctl_temp_set(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(temp_seen,ctx,tid,now)) {
 		(void)light_ctl_temp_get(model, ctx, buf);
 		return 0;
 	}
@@ -2651,10 +2583,7 @@ static int light_ctl_temp_set(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2747,10 +2676,7 @@ static int gen_level_set_unack_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_temp_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -2774,10 +2700,7 @@ static int gen_level_set_unack_temp(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2813,10 +2736,7 @@ static int gen_level_set_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_temp_seen,ctx,tid,now)) {
 		(void)gen_level_get_temp(model, ctx, buf);
 		return 0;
 	}
@@ -2841,10 +2761,7 @@ static int gen_level_set_temp(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2883,10 +2800,7 @@ static int gen_delta_set_unack_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_temp_seen,ctx,tid,now)) {
 
 		if (ctl->temp->delta == delta) {
 			return 0;
@@ -2918,10 +2832,7 @@ static int gen_delta_set_unack_temp(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2965,10 +2876,7 @@ static int gen_delta_set_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_temp_seen,ctx,tid,now)) {
 
 		if (ctl->temp->delta == delta) {
 			(void)gen_level_get_temp(model, ctx, buf);
@@ -3001,10 +2909,7 @@ static int gen_delta_set_temp(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -3050,10 +2955,7 @@ static int gen_move_set_unack_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_temp_seen,ctx,tid,now)) {
 		return 0;
 	}
 
@@ -3077,10 +2979,7 @@ static int gen_move_set_unack_temp(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
@@ -3125,10 +3024,7 @@ static int gen_move_set_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (dejavu(level_temp_seen,ctx,tid,now)) {
 		(void)gen_level_get_temp(model, ctx, buf);
 		return 0;
 	}
@@ -3153,10 +3049,7 @@ static int gen_move_set_temp(struct bt_mesh_model *model,
 	ctl->transition->counter = 0U;
 	k_timer_stop(&ctl->transition->timer);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	remember(level_temp_seen,ctx,tid,now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
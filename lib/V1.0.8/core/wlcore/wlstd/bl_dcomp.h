@@ -81,10 +81,6 @@
 struct vendor_state {
 	int current;
 	uint32_t response;
-	uint8_t last_tid;
-	uint16_t last_src_addr;
-	uint16_t last_dst_addr;
-	int64_t last_msg_timestamp;
 };
 
 struct lightness {
@@ -133,11 +129,6 @@ struct light_ctl_state {
 
 	uint8_t onpowerup, tt;
 
-	uint8_t last_tid;
-	uint16_t last_src_addr;
-	uint16_t last_dst_addr;
-	int64_t last_msg_timestamp;
-
 	struct transition *transition;
 };
 
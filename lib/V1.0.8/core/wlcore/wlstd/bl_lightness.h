@@ -0,0 +1,221 @@
+//==============================================================================
+//  bl_lightness.h
+//  integer lightness and CTL temperature conversions (no float, no libm)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Conversions of the Mesh Model Specification used by state_binding.c:
+//
+//   linear = ceil(65535 * (actual/65535)^2)              (6.1.2.2.1)
+//   actual = 65535 * sqrt(linear/65535)                  (6.1.2.2.1)
+//   temp   = Tmin + (level + 32768) * (Tmax-Tmin)/65535  (6.1.3.1.1)
+//   level  = (temp - Tmin) * 65535/(Tmax-Tmin) - 32768   (6.1.3.1.1)
+//
+// Divisions by 65535 are done with shifts and adds. The square root is a
+// table lookup: the radicand is normalized to [2^30,2^32), its top bits index
+// a table of 3*2^N+1 entries (CFG_LIGHTNESS_LUT = N), the result is linearly
+// interpolated and finally corrected to the exact integer square root
+// (CFG_LIGHTNESS_EXACT). The option trades table size against the number of
+// correction steps (or against accuracy without correction):
+//
+//   CFG_LIGHTNESS_LUT    table      CFG_LIGHTNESS_EXACT
+//   0                    none       bitwise square root (16 iterations), exact
+//   4 / 5 / 6            98/194/386 bytes  1: exact, 0: +/-1 LSB deviations
+//
+//==============================================================================
+
+#ifndef __BL_LIGHTNESS_H__
+#define __BL_LIGHTNESS_H__
+
+  #include <stdint.h>
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_LIGHTNESS_LUT
+    #define CFG_LIGHTNESS_LUT     6    // sqrt table: 3*2^6+1 entries
+  #endif
+
+  #ifndef CFG_LIGHTNESS_EXACT
+    #define CFG_LIGHTNESS_EXACT   1    // correct to exact integer sqrt
+  #endif
+
+//==============================================================================
+// square root table: lut[k] = sqrt((2^N + k) * 2^(30-N)), k = 0 .. 3*2^N
+// (last entry 65536 clamped to 65535)
+//==============================================================================
+
+  #if (CFG_LIGHTNESS_LUT == 0)
+    // no table, bitwise square root
+  #elif (CFG_LIGHTNESS_LUT == 4)            // 49 entries
+    static const uint16_t bl_sqrt_lut[49] =
+    {
+      32768, 33776, 34756, 35708, 36636, 37540, 38424, 39287,
+      40132, 40960, 41771, 42567, 43348, 44115, 44869, 45611,
+      46341, 47059, 47767, 48465, 49152, 49830, 50499, 51159,
+      51811, 52454, 53090, 53719, 54340, 54954, 55561, 56162,
+      56756, 57344, 57926, 58503, 59073, 59639, 60199, 60753,
+      61303, 61848, 62388, 62924, 63455, 63982, 64504, 65022,
+      65535
+    };
+  #elif (CFG_LIGHTNESS_LUT == 5)            // 97 entries
+    static const uint16_t bl_sqrt_lut[97] =
+    {
+      32768, 33276, 33776, 34270, 34756, 35235, 35708, 36175,
+      36636, 37091, 37540, 37985, 38424, 38858, 39287, 39712,
+      40132, 40548, 40960, 41368, 41771, 42171, 42567, 42959,
+      43348, 43733, 44115, 44494, 44869, 45242, 45611, 45977,
+      46341, 46702, 47059, 47415, 47767, 48117, 48465, 48809,
+      49152, 49492, 49830, 50166, 50499, 50830, 51159, 51486,
+      51811, 52134, 52454, 52773, 53090, 53405, 53719, 54030,
+      54340, 54647, 54954, 55258, 55561, 55862, 56162, 56459,
+      56756, 57051, 57344, 57636, 57926, 58215, 58503, 58789,
+      59073, 59357, 59639, 59919, 60199, 60477, 60753, 61029,
+      61303, 61576, 61848, 62119, 62388, 62657, 62924, 63190,
+      63455, 63719, 63982, 64243, 64504, 64763, 65022, 65279,
+      65535
+    };
+  #elif (CFG_LIGHTNESS_LUT == 6)            // 193 entries
+    static const uint16_t bl_sqrt_lut[193] =
+    {
+      32768, 33023, 33276, 33527, 33776, 34024, 34270, 34514,
+      34756, 34996, 35235, 35472, 35708, 35942, 36175, 36406,
+      36636, 36864, 37091, 37316, 37540, 37763, 37985, 38205,
+      38424, 38642, 38858, 39073, 39287, 39500, 39712, 39923,
+      40132, 40341, 40548, 40755, 40960, 41164, 41368, 41570,
+      41771, 41972, 42171, 42369, 42567, 42763, 42959, 43154,
+      43348, 43541, 43733, 43925, 44115, 44305, 44494, 44682,
+      44869, 45056, 45242, 45427, 45611, 45795, 45977, 46160,
+      46341, 46522, 46702, 46881, 47059, 47237, 47415, 47591,
+      47767, 47942, 48117, 48291, 48465, 48637, 48809, 48981,
+      49152, 49322, 49492, 49661, 49830, 49998, 50166, 50332,
+      50499, 50665, 50830, 50995, 51159, 51323, 51486, 51649,
+      51811, 51972, 52134, 52294, 52454, 52614, 52773, 52932,
+      53090, 53248, 53405, 53562, 53719, 53874, 54030, 54185,
+      54340, 54494, 54647, 54801, 54954, 55106, 55258, 55410,
+      55561, 55712, 55862, 56012, 56162, 56311, 56459, 56608,
+      56756, 56903, 57051, 57198, 57344, 57490, 57636, 57781,
+      57926, 58071, 58215, 58359, 58503, 58646, 58789, 58931,
+      59073, 59215, 59357, 59498, 59639, 59779, 59919, 60059,
+      60199, 60338, 60477, 60615, 60753, 60891, 61029, 61166,
+      61303, 61440, 61576, 61712, 61848, 61984, 62119, 62254,
+      62388, 62523, 62657, 62790, 62924, 63057, 63190, 63323,
+      63455, 63587, 63719, 63850, 63982, 64113, 64243, 64374,
+      64504, 64634, 64763, 64893, 65022, 65151, 65279, 65408,
+      65535
+    };
+  #else
+    #error "CFG_LIGHTNESS_LUT must be 0, 4, 5 or 6"
+  #endif
+
+//==============================================================================
+// helper: floor(y/65535) for y < 65535*65536
+//==============================================================================
+
+  static inline uint32_t bl_div65535(uint32_t y)
+  {
+    return (y + (y >> 16) + 1) >> 16;
+  }
+
+//==============================================================================
+// helper: integer square root floor(sqrt(x))
+//==============================================================================
+
+  static inline uint16_t bl_isqrt(uint32_t x)
+  {
+  #if (CFG_LIGHTNESS_LUT == 0)
+    uint32_t r = 0, bit = 1u << 30;
+
+    while (bit > x)
+      bit >>= 2;
+
+    for (; bit; bit >>= 2)
+    {
+      if (x >= r + bit)
+      {
+        x -= r + bit;
+        r = (r >> 1) + bit;
+      }
+      else
+        r >>= 1;
+    }
+    return (uint16_t)r;
+  #else
+    if (x == 0)
+      return 0;
+
+    int s = __builtin_clz(x) & ~1;     // even shift: sqrt(x) = sqrt(y) >> s/2
+    uint32_t y = x << s;               // y in [2^30,2^32)
+    uint32_t k = (y >> (30-CFG_LIGHTNESS_LUT)) - (1u << CFG_LIGHTNESS_LUT);
+    uint32_t frac = (y >> (14-CFG_LIGHTNESS_LUT)) & 0xFFFF;
+    uint32_t lo = bl_sqrt_lut[k], hi = bl_sqrt_lut[k+1];
+    uint32_t r = (lo + (((hi - lo) * frac) >> 16)) >> (s/2);
+
+    #if (CFG_LIGHTNESS_EXACT)
+      while (r*r > x)
+        r--;
+      while (r < 65535 && (r+1)*(r+1) <= x)
+        r++;
+    #endif
+    return (uint16_t)r;
+  #endif
+  }
+
+//==============================================================================
+// lightness actual -> linear: ceil(actual^2 / 65535)
+// - usage: linear = bl_actual2linear(actual)
+//==============================================================================
+
+  static inline uint16_t bl_actual2linear(uint16_t actual)
+  {
+    return (uint16_t)bl_div65535((uint32_t)actual*actual + 65534);
+  }
+
+//==============================================================================
+// lightness linear -> actual: floor(sqrt(linear * 65535))
+// - usage: actual = bl_linear2actual(linear)
+//==============================================================================
+
+  static inline uint16_t bl_linear2actual(uint16_t linear)
+  {
+    return bl_isqrt((uint32_t)linear * 65535);
+  }
+
+//==============================================================================
+// generic level -> CTL temperature (rounded down, like the float version)
+// - usage: temp = bl_level2temp(level,tmin,tmax)      // tmin <= tmax
+//==============================================================================
+
+  static inline uint16_t bl_level2temp(int16_t level, uint16_t tmin,
+                                       uint16_t tmax)
+  {
+    uint32_t n = (uint32_t)(level + 32768) * (uint32_t)(tmax - tmin);
+    return (uint16_t)(tmin + bl_div65535(n));
+  }
+
+//==============================================================================
+// CTL temperature -> generic level (rounded towards zero like the float
+// version, <temp> is clipped to [tmin,tmax])
+// - usage: level = bl_temp2level(temp,tmin,tmax)      // tmin <= tmax
+//==============================================================================
+
+  static inline int16_t bl_temp2level(uint16_t temp, uint16_t tmin,
+                                      uint16_t tmax)
+  {
+    if (tmax <= tmin || temp <= tmin)
+      return INT16_MIN;
+    if (temp >= tmax)
+      return INT16_MAX;
+
+    uint32_t d = tmax - tmin;
+    uint32_t n = (uint32_t)(temp - tmin) * 65535;
+    uint32_t q = n / d;
+
+    if (q < 32768 && q*d != n)         // negative level: round towards zero
+      q++;
+    return (int16_t)((int32_t)q - 32768);
+  }
+
+#endif // __BL_LIGHTNESS_H__
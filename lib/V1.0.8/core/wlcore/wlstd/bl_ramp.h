@@ -0,0 +1,74 @@
+//==============================================================================
+//  bl_ramp.h
+//  integer ramp generator for state transitions (no float, exact endpoint)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// A ramp moves a value from <from> to <to> in <steps> equal steps. The span
+// is split into an integer step and a remainder which is distributed over the
+// steps Bresenham style, so a step costs two adds and one compare (no division,
+// no soft-float on FPU-less cores), step k yields from + span*k/steps rounded
+// to the nearest integer, and the last step yields exactly <to>.
+//
+// Example:
+//
+//   BL_ramp ramp;
+//   bl_ramp_init(&ramp,current,target,10);   // 10 steps
+//   for (int i=0; i < 10; i++)
+//     current = bl_ramp_step(&ramp);         // last step: current == target
+//
+//==============================================================================
+
+#ifndef __BL_RAMP_H__
+#define __BL_RAMP_H__
+
+  #include <stdint.h>
+
+  typedef struct BL_ramp               // integer ramp
+          {
+            int32_t value;             // current value
+            int32_t quot;              // integer part of a step
+            int32_t unit;              // +1/-1 (direction of remainder)
+            uint32_t rem;              // |span % steps|
+            uint32_t err;              // accumulated remainder
+            uint32_t steps;            // number of steps (> 0)
+          } BL_ramp;
+
+//==============================================================================
+// init ramp (steps == 0 is treated as a single step)
+// - usage: bl_ramp_init(&ramp,from,to,steps)
+//==============================================================================
+
+  static inline void bl_ramp_init(BL_ramp *r, int32_t from, int32_t to,
+                                  uint32_t steps)
+  {
+    int32_t span = to - from;
+    int32_t n = steps ? (int32_t)steps : 1;
+
+    r->value = from;
+    r->quot = span / n;                // C99: truncated towards zero
+    r->unit = (span < 0) ? -1 : 1;
+    r->rem = (uint32_t)((span % n) * r->unit);
+    r->err = n/2;                      // round to nearest
+    r->steps = n;
+  }
+
+//==============================================================================
+// advance ramp by one step and return the new value
+// - usage: val = bl_ramp_step(&ramp)
+//==============================================================================
+
+  static inline int32_t bl_ramp_step(BL_ramp *r)
+  {
+    r->value += r->quot;
+    r->err += r->rem;
+    if (r->err >= r->steps)            // carry of the remainder
+    {
+      r->err -= r->steps;
+      r->value += r->unit;
+    }
+    return r->value;
+  }
+
+#endif // __BL_RAMP_H__
@@ -12,53 +12,16 @@
 #include "state_binding.h"
 #include "storage.h"
 #include "transition.h"
-
-#define MINDIFF 2.25e-308
-
-static float sqrt(float square)
-{
-	float root, last, diff;
-
-	root = square / 3.0;
-	diff = 1;
-
-	if (square <= 0) {
-		return 0;
-	}
-
-	do {
-		last = root;
-		root = (root + square / root) / 2.0;
-		diff = root - last;
-	} while (diff > MINDIFF || diff < -MINDIFF);
-
-	return root;
-}
-
-static int32_t ceiling(float num)
-{
-	int32_t inum;
-
-	inum = (int32_t) num;
-	if (num == (float) inum) {
-		return inum;
-	}
-
-	return inum + 1;
-}
+#include "bl_lightness.h"
 
 static uint16_t actual_to_linear(uint16_t val)
 {
-	float tmp;
-
-	tmp = ((float) val / UINT16_MAX);
-
-	return (uint16_t) ceiling(UINT16_MAX * tmp * tmp);
+	return bl_actual2linear(val);
 }
 
 static uint16_t linear_to_actual(uint16_t val)
 {
-	return (uint16_t) (UINT16_MAX * sqrt(((float) val / UINT16_MAX)));
+	return bl_linear2actual(val);
 }
 
 uint16_t constrain_lightness(uint16_t light)
@@ -100,33 +63,14 @@ uint16_t constrain_temperature(uint16_t temp)
 
 static int16_t light_ctl_temp_to_level(uint16_t temp)
 {
-	float tmp;
-
-	/* Mesh Model Specification 6.1.3.1.1 2nd formula start */
-
-	tmp = (temp - ctl->temp->range_min) * UINT16_MAX;
-
-	tmp = tmp / (ctl->temp->range_max - ctl->temp->range_min);
-
-	return (int16_t) (tmp + INT16_MIN);
-
-	/* 6.1.3.1.1 2nd formula end */
+	/* Mesh Model Specification 6.1.3.1.1 2nd formula */
+	return bl_temp2level(temp, ctl->temp->range_min, ctl->temp->range_max);
 }
 
 uint16_t level_to_light_ctl_temp(int16_t level)
 {
-	uint16_t tmp;
-	float diff;
-
-	/* Mesh Model Specification 6.1.3.1.1 1st formula start */
-	diff = (float) (ctl->temp->range_max - ctl->temp->range_min) /
-		       UINT16_MAX;
-
-	tmp = (uint16_t) ((level - INT16_MIN) * diff);
-
-	return (ctl->temp->range_min + tmp);
-
-	/* 6.1.3.1.1 1st formula end */
+	/* Mesh Model Specification 6.1.3.1.1 1st formula */
+	return bl_level2temp(level, ctl->temp->range_min, ctl->temp->range_max);
 }
 
 void set_target(uint8_t type, void *dptr)
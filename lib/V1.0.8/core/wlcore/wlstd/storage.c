@@ -29,19 +29,40 @@
   #define LOGO(lvl,col,o,val)     LOGO_NVM(lvl,col WHO,o,val)
   #define LOG0(lvl,col,o,val)     LOGO_NVM(lvl,col,o,val)
 
+//==============================================================================
+// config defaults
+// - save_on_flash(id) only marks @id dirty; dirty ids are written back in one
+//   batch CFG_NVM_WINDOW ms after the first request, so repeated saves (e.g.
+//   during transitions) are coalesced into a single flash write per id
+// - ids in CFG_NVM_URGENT are flushed (with all other dirty ids) right away
+//==============================================================================
+
+  #ifndef CFG_NVM_WINDOW
+    #define CFG_NVM_WINDOW  2000       // write-back window [ms]
+  #endif
+
+  #ifndef CFG_NVM_URGENT
+    #define CFG_NVM_URGENT  BIT(RESET_COUNTER)   // multi-reset detection
+  #endif
+
 //==============================================================================
 // locals
 //==============================================================================
 
-  static uint8_t storage_id;
   uint8_t reset_counter;
 
     // the NVM cache
 
   static int nvm_cache[20];            // our addressable NVM cache memory
-  static bool dirty = false;           // is nvm_cache dirty?
   static bool ready = false;           // is nvm cache ready?
 
+    // write-back cache state
+
+  static atomic_t dirty = ATOMIC_INIT(0);     // dirty bitmap (bit per @id)
+  static atomic_t armed = ATOMIC_INIT(0);     // write-back timer running?
+  static atomic_t requests = ATOMIC_INIT(0);  // number of save requests
+  static atomic_t writes = ATOMIC_INIT(0);    // number of id write backs
+
 //==============================================================================
 // helper: settings init (initializes the zephyr settings subsystem)
 // - we keep this function global in order to avoid multiple initializing
@@ -142,12 +163,12 @@
   }
 
 //==============================================================================
-// callback: storage work handler
+// helper: save variable(s) of given storage id on flash
 //==============================================================================
 
-  static void storage_work_handler(struct k_work *work)
+  static void save(uint8_t id)
   {
-  	switch (storage_id)
+  	switch (id)
     {
     	case NVM_CACHE:
     		save_nvm_cache();
@@ -179,17 +200,74 @@
   	}
   }
 
-  K_WORK_DEFINE(storage_work, storage_work_handler);
+//==============================================================================
+// helper: flush - write back all dirty ids in one batch
+// - the NVM cache stays dirty until it is ready (loaded or reset), otherwise
+//   we would overwrite the stored NVM cache with an unloaded one
+// - ids getting dirty during the flush (e.g. GEN_ONPOWERUP_STATE marks
+//   LAST_TARGET_STATES) are written back in the same batch
+//==============================================================================
+
+  static void flush(void)
+  {
+    atomic_val_t mask = ready ? ~0 : ~BIT(NVM_CACHE);
+    atomic_val_t bits;
+    int n = 0;
+
+    while ((bits = atomic_and(&dirty,~mask) & mask))   // take dirty ids
+    {
+      for (uint8_t id = 0; bits; id++, bits >>= 1)
+        if (bits & 1)
+        {
+          save(id);
+          n++;
+        }
+    }
+
+    if (n)
+    {
+      atomic_add(&writes,n);
+      LOG(4,"flush: %d ids written (total: %d writes for %d requests)",
+          n, (int)atomic_get(&writes), (int)atomic_get(&requests));
+    }
+  }
 
 //==============================================================================
-// helper: save on flash
+// write-back timer and flush work
+//==============================================================================
+
+  static void flush_worker(struct k_work *work)
+  {
+    flush();
+  }
+
+  K_WORK_DEFINE(flush_work, flush_worker);
+
+  static void flush_timer_fire(struct k_timer *timer)
+  {
+    atomic_clear(&armed);              // next request re-arms the timer
+    k_work_submit(&flush_work);        // flush in system work queue
+  }
+
+  K_TIMER_DEFINE(flush_timer, flush_timer_fire, NULL);
+
+//==============================================================================
+// helper: save on flash (mark @id dirty, safe to call from any context)
+// - the first request of a batch starts the write-back window, urgent ids
+//   are flushed immediately
 //==============================================================================
 
   void save_on_flash(uint8_t id)
   {
-  	storage_id = id;
     LOG(5,"save_on_flash: @%d",id);
-  	k_work_submit(&storage_work);
+
+    atomic_or(&dirty,BIT(id));
+    atomic_inc(&requests);
+
+    if (BIT(id) & (CFG_NVM_URGENT))
+      k_work_submit(&flush_work);      // flush right away
+    else if (atomic_cas(&armed,0,1))
+      k_timer_start(&flush_timer, K_MSEC(CFG_NVM_WINDOW), K_NO_WAIT);
   }
 
 //==============================================================================
@@ -201,6 +279,9 @@
 		ready = true;
     LOG(4,BL_M "NVM is now ready");
     _bl_msg((bl_storage),_NVM,READY_, 0,NULL,ready);  // (BL_NVM) <- [NVM:READY ready]
+
+    if (atomic_get(&dirty) & BIT(NVM_CACHE))
+      k_work_submit(&flush_work);      // NVM cache stores held back so far
   }
 
   K_WORK_DEFINE(nvm_ready_work, nvm_ready_worker);
@@ -299,13 +380,15 @@
 //==============================================================================
 // worker: save NVM cache to NVM
 // - save operation will be only executed if <data> equals NULL
+// - flushes all dirty ids (including the NVM cache) immediately
 //==============================================================================
 
   static int nvm_save(BL_ob *o, int val)
   {
     if (o->data == NULL)
     {
-      save_nvm_cache();
+      atomic_or(&dirty,BIT(NVM_CACHE));
+      flush();
       return 0;                        // OK
     }
 
@@ -327,7 +410,7 @@
       {
         //bl_feed();                   // feed watchdog
         nvm_cache[o->id] = val;
-        dirty = true;                  // cache is now dirty
+        save_on_flash(NVM_CACHE);      // cache is now dirty
       }
       //bl_nvmdrv_write(id,value);
       return 0;                        // OK
@@ -363,17 +446,10 @@
           nvm_cache[i] = 0;            // init NVM cache
 
         ready = true;
-        dirty = true;
+        save_on_flash(NVM_CACHE);      // cache is now dirty
 
         submit_nvm_ready();            // notify higher levels
       }
-
-      if (ready && dirty)
-      {
-        LOG(4,"backup NVM cache ...");
-        save_nvm_cache();
-        dirty = false;
-      }
     }
     return 0;                          // OK
   }
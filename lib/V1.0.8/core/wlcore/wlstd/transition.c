@@ -87,7 +87,7 @@ static bool set_transition_counter(struct transition *transition)
 		break;
 	}
 
-	transition->counter = ((float) transition->total_duration / 100);
+	transition->counter = transition->total_duration / 100U;
 
 	if (transition->counter > DEVICE_SPECIFIC_RESOLUTION) {
 		transition->counter = DEVICE_SPECIFIC_RESOLUTION;
@@ -96,6 +96,22 @@ static bool set_transition_counter(struct transition *transition)
 	return true;
 }
 
+/* Transition channels: all channels of a transition are stepped by the same
+ * timer and work item, using integer ramps (no float math per step, the last
+ * step hits the target exactly). <delta> keeps the (integer) step size for
+ * the range constraint of state_binding.c
+ */
+
+#define CH_LIGHT	0x01
+#define CH_TEMP		0x02
+#define CH_DUV		0x04
+
+static void set_ramp(BL_ramp *ramp, int *delta, int current, int target)
+{
+	bl_ramp_init(ramp, current, target, ctl->transition->counter);
+	*delta = (current - target) / (int)ctl->transition->counter;
+}
+
 void set_transition_values(uint8_t type)
 {
 	if (!set_transition_counter(ctl->transition)) {
@@ -115,36 +131,26 @@ void set_transition_values(uint8_t type)
 	case LEVEL_LIGHT:
 	case ACTUAL:
 	case LINEAR:
-		ctl->light->delta =
-			((float) (ctl->light->current - ctl->light->target) /
-			 ctl->transition->counter);
+		set_ramp(&ctl->transition->light, &ctl->light->delta,
+			 ctl->light->current, ctl->light->target);
 		break;
 	case CTL_LIGHT:
-		ctl->light->delta =
-			((float) (ctl->light->current - ctl->light->target) /
-			 ctl->transition->counter);
-
-		ctl->temp->delta =
-			((float) (ctl->temp->current - ctl->temp->target) /
-			 ctl->transition->counter);
-
-		ctl->duv->delta =
-			((float) (ctl->duv->current - ctl->duv->target) /
-			 ctl->transition->counter);
+		set_ramp(&ctl->transition->light, &ctl->light->delta,
+			 ctl->light->current, ctl->light->target);
+		set_ramp(&ctl->transition->temp, &ctl->temp->delta,
+			 ctl->temp->current, ctl->temp->target);
+		set_ramp(&ctl->transition->duv, &ctl->duv->delta,
+			 ctl->duv->current, ctl->duv->target);
 		break;
 	case LEVEL_TEMP:
-		ctl->temp->delta =
-			((float) (ctl->temp->current - ctl->temp->target) /
-			 ctl->transition->counter);
+		set_ramp(&ctl->transition->temp, &ctl->temp->delta,
+			 ctl->temp->current, ctl->temp->target);
 		break;
 	case CTL_TEMP:
-		ctl->temp->delta =
-			((float) (ctl->temp->current - ctl->temp->target) /
-			 ctl->transition->counter);
-
-		ctl->duv->delta =
-			((float) (ctl->duv->current - ctl->duv->target) /
-			 ctl->transition->counter);
+		set_ramp(&ctl->transition->temp, &ctl->temp->delta,
+			 ctl->temp->current, ctl->temp->target);
+		set_ramp(&ctl->transition->duv, &ctl->duv->delta,
+			 ctl->duv->current, ctl->duv->target);
 		break;
 	default:
 		return;
@@ -152,32 +158,6 @@ void set_transition_values(uint8_t type)
 }
 
 /* Timers related handlers & threads (Start) */
-static void onoff_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
-		}
-
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
-
 static void level_move_lightness_work_handler(void)
 {
 	int light;
@@ -209,37 +189,6 @@ static void level_move_lightness_work_handler(void)
 	}
 }
 
-static void level_lightness_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
-		}
-
-		return;
-	}
-
-	if (ctl->transition->type == MOVE) {
-		level_move_lightness_work_handler();
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
-
 static void level_move_temp_work_handler(void)
 {
 	int temp;
@@ -271,8 +220,10 @@ static void level_move_temp_work_handler(void)
 	}
 }
 
-static void level_temp_work_handler(struct k_work *work)
+static void transition_work_handler(struct k_work *work)
 {
+	uint8_t channels = ctl->transition->channels;
+
 	if (ctl->transition->just_started) {
 		ctl->transition->just_started = false;
 
@@ -287,286 +238,110 @@ static void level_temp_work_handler(struct k_work *work)
 	}
 
 	if (ctl->transition->type == MOVE) {
-		level_move_temp_work_handler();
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->temp->current -= ctl->temp->delta;
-		update_light_state();
-	} else {
-		ctl->temp->current = ctl->temp->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
-
-static void light_lightness_actual_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
+		if (channels == CH_LIGHT) {
+			level_move_lightness_work_handler();
+		} else if (channels == CH_TEMP) {
+			level_move_temp_work_handler();
 		}
-
 		return;
 	}
 
 	ctl->transition->counter--;
 	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
-
-static void light_lightness_linear_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
+		if (channels & CH_LIGHT) {
+			ctl->light->current =
+				bl_ramp_step(&ctl->transition->light);
 		}
-
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
-
-static void light_ctl_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
+		if (channels & CH_TEMP) {
+			ctl->temp->current =
+				bl_ramp_step(&ctl->transition->temp);
 		}
-
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		/* Lightness */
-		ctl->light->current -= ctl->light->delta;
-		/* Temperature */
-		ctl->temp->current -= ctl->temp->delta;
-		/* Delta_UV */
-		ctl->duv->current -= ctl->duv->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		ctl->temp->current = ctl->temp->target;
-		ctl->duv->current = ctl->duv->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
-
-static void light_ctl_temp_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
+		if (channels & CH_DUV) {
+			ctl->duv->current =
+				bl_ramp_step(&ctl->transition->duv);
 		}
-
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		/* Temperature */
-		ctl->temp->current -= ctl->temp->delta;
-		/* Delta_UV */
-		ctl->duv->current -= ctl->duv->delta;
 		update_light_state();
 	} else {
-		ctl->temp->current = ctl->temp->target;
-		ctl->duv->current = ctl->duv->target;
+		if (channels & CH_LIGHT) {
+			ctl->light->current = ctl->light->target;
+		}
+		if (channels & CH_TEMP) {
+			ctl->temp->current = ctl->temp->target;
+		}
+		if (channels & CH_DUV) {
+			ctl->duv->current = ctl->duv->target;
+		}
 		update_light_state();
 		k_timer_stop(&ctl->transition->timer);
 	}
 }
 
+K_WORK_DEFINE(transition_work, transition_work_handler);
 
-K_WORK_DEFINE(onoff_work, onoff_work_handler);
-K_WORK_DEFINE(level_lightness_work, level_lightness_work_handler);
-K_WORK_DEFINE(level_temp_work, level_temp_work_handler);
-K_WORK_DEFINE(light_lightness_actual_work, light_lightness_actual_work_handler);
-K_WORK_DEFINE(light_lightness_linear_work, light_lightness_linear_work_handler);
-K_WORK_DEFINE(light_ctl_work, light_ctl_work_handler);
-K_WORK_DEFINE(light_ctl_temp_work, light_ctl_temp_work_handler);
-
-static void onoff_tt_handler(struct k_timer *dummy)
+static void transition_tt_handler(struct k_timer *dummy)
 {
-	k_work_submit(&onoff_work);
-}
-
-static void level_lightness_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&level_lightness_work);
-}
-
-static void level_temp_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&level_temp_work);
-}
-
-static void light_lightness_actual_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&light_lightness_actual_work);
-}
-
-static void light_lightness_linear_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&light_lightness_linear_work);
-}
-
-static void light_ctl_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&light_ctl_work);
-}
-
-static void light_ctl_temp_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&light_ctl_temp_work);
+	k_work_submit(&transition_work);
 }
 /* Timers related handlers & threads (End) */
 
 K_TIMER_DEFINE(dummy_timer, NULL, NULL);
 
-/* Messages handlers (Start) */
-void onoff_handler(void)
+/* Start the (single) transition timer for the given channels */
+static void start_transition(uint8_t channels)
 {
 	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
 		update_light_state();
 		return;
 	}
 
-	k_timer_init(&ctl->transition->timer, onoff_tt_handler, NULL);
+	ctl->transition->channels = channels;
+	k_timer_init(&ctl->transition->timer, transition_tt_handler, NULL);
 
 	k_timer_start(&ctl->transition->timer,
 		      K_MSEC(ctl->transition->delay * 5U),
 		      K_MSEC(ctl->transition->quo_tt));
 }
 
-void level_lightness_handler(void)
+/* Messages handlers (Start) */
+void onoff_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     level_lightness_tt_handler, NULL);
+	start_transition(CH_LIGHT);
+}
 
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+void level_lightness_handler(void)
+{
+	start_transition(CH_LIGHT);
 }
 
 void level_temp_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer, level_temp_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	start_transition(CH_TEMP);
 }
 
 void light_lightness_actual_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     light_lightness_actual_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	start_transition(CH_LIGHT);
 }
 
 void light_lightness_linear_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     light_lightness_linear_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	start_transition(CH_LIGHT);
 }
 
 void light_ctl_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer, light_ctl_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	start_transition(CH_LIGHT | CH_TEMP | CH_DUV);
 }
 
 void light_ctl_temp_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     light_ctl_temp_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	start_transition(CH_TEMP | CH_DUV);
 }
 
+#undef CH_LIGHT
+#undef CH_TEMP
+#undef CH_DUV
+
 //==============================================================================
 // cleanup (needed for *.c file merge of the bluccino core)
 //==============================================================================
@@ -9,6 +9,7 @@
 #define _TRANSITION_H
 
 #include "bl_dcomp.h"
+#include "bl_ramp.h"
 
 #define UNKNOWN_VALUE 0x3F
 #define DEVICE_SPECIFIC_RESOLUTION 10
@@ -29,7 +30,10 @@ struct transition {
 	uint32_t total_duration;
 	int64_t start_timestamp;
 
-	struct k_timer timer;
+	uint8_t channels;       /* channels stepped by the transition timer */
+	BL_ramp light, temp, duv; /* integer ramps (current -> target) */
+
+	struct k_timer timer;   /* one timer for all channels */
 };
 
 extern struct transition transition;
@@ -0,0 +1,25 @@
+//==============================================================================
+//  bl_boot.c
+//  host (POSIX) boot of a Zephyr app - runs the app's main(), then idles
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Zephyr apps (e.g. the lessons) return from main() after init, while the
+// system work queue and the kernel timers keep the app alive. On the host
+// the app's main() is renamed to app_main() (main=app_main for the app's
+// main.c only) and the process stays alive in the idle loop below. In
+// virtual time (BL_VIRTUAL=<seconds>) the process ends at the horizon.
+//
+//==============================================================================
+
+  #include "bl_host.h"
+
+  void app_main(void);                 // the app's main()
+
+  int main(void)
+  {
+    app_main();                        // init app (may also loop forever)
+    for (;;)
+      k_msleep(1000);                  // idle, work queue & timers keep going
+  }
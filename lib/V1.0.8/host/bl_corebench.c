@@ -0,0 +1,250 @@
+//==============================================================================
+//  bl_corebench.c
+//  host benchmark suite of core message paths (bl_bench harness)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_corebench [text|csv|json]   // default: text
+//
+// Cases (per loop):
+//
+//   post        bl_post() of [BUTTON:PRESS] to a module (OVAL call)
+//   out_aug     bl_out() of [#BUTTON:PRESS] to a module (un-augmented view)
+//   roundtrip   bl_led() -> bl_down -> bl_core -> bl_hw -> bl_hwled (driver
+//               stub) -> [#SWITCH:STS] -> bl_up -> bl_top -> app
+//   logo_off    bl_logo() below verbose level (filtered)
+//   logo_on     bl_logo() printed (stdout redirected to /dev/null)
+//   log_muted   LOG_GEAR() of a muted log area at verbose level 4
+//   nvm_store   bl_store() -> bl_down -> bl_core -> bl_hw -> bl_hwnvm (RAM)
+//   nvm_recall  bl_recall() along the same path
+//   clock_us    bl_us() (cycles => us by fixed point multiplier)
+//   clock_ms    bl_ms()
+//   clock_hms   bl_hms() split of an increasing us time (log header)
+//
+// The driver stubs bl_hwled() and bl_hwnvm() override the weak defaults of
+// bl_core.c. Results go to stdout via the log sink; compare CSV/JSON output
+// of two releases to spot regressions.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <string.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+
+  #include "bluccino.h"
+
+  static long count = 0;               // messages received by app/sink
+  static int nvm[16];                  // RAM NVM of driver stub
+
+//==============================================================================
+// app and sink modules
+//==============================================================================
+
+  static int app(BL_ob *o, int val)
+  {
+    if (o->cl != _SYS)
+      count++;
+    return 0;
+  }
+
+  static int sink(BL_ob *o, int val)
+  {
+    count++;
+    return 0;
+  }
+
+  static BL_oval volatile S = sink;    // opaque to the optimizer (no inlining)
+
+//==============================================================================
+// driver stubs (override weak defaults of bl_core.c)
+//==============================================================================
+
+  int bl_hwled(BL_ob *o, int val)      // LED driver with status feedback
+  {
+    if (bl_is(o,_LED,SET_))
+      return _bl_post(bl_up,SWITCH_STS_id_0_sts, o->id,NULL,val);
+    return 0;
+  }
+
+  int bl_hwnvm(BL_ob *o, int val)      // RAM based NVM driver
+  {
+    switch (bl_id(o))
+    {
+      case NVM_AVAIL_0_0_0:
+        return 1;                      // NVM handled by HW core
+
+      case NVM_STORE_id_0_val:
+        nvm[o->id & 15] = val;
+        return 0;
+
+      case NVM_RECALL_id_0_0:
+        return nvm[o->id & 15];
+
+      default:
+        return 0;
+    }
+  }
+
+//==============================================================================
+// benchmark cases
+//==============================================================================
+
+  BL_BENCH(post,1000)
+  {
+    for (int i=0; i < n; i++)
+      bl_post((S),BUTTON_PRESS_id_0_0, 1,NULL,i);
+  }
+
+  BL_BENCH(out_aug,1000)
+  {
+    BL_ob oo = {BL_AUG(_BUTTON),PRESS_,1,NULL};
+    for (int i=0; i < n; i++)
+      bl_out(&oo,i,(S));
+  }
+
+  BL_BENCH(roundtrip,1000)
+  {
+    for (int i=0; i < n; i++)
+      bl_led(1,i&1);
+  }
+
+  BL_BENCH(logo_off,1000)
+  {
+    BL_ob oo = {_BUTTON,PRESS_,1,NULL};
+    for (int i=0; i < n; i++)
+      bl_logo(5,"bench:",&oo,i);       // verbose level 0 => filtered
+  }
+
+  BL_BENCH(logo_on,100)
+  {
+    BL_ob oo = {_BUTTON,PRESS_,1,NULL};
+    for (int i=0; i < n; i++)
+      bl_logo(1,"bench:",&oo,i);
+  }
+
+  BL_BENCH(log_muted,1000)
+  {
+    for (int i=0; i < n; i++)
+      LOG_GEAR(1,"bench: %d",i);       // GEAR area muted by [SYS:LOG]
+  }
+
+  BL_BENCH(nvm_store,1000)
+  {
+    for (int i=0; i < n; i++)
+      bl_store(i & 7,i);
+  }
+
+  BL_BENCH(nvm_recall,1000)
+  {
+    int sum = 0;
+    for (int i=0; i < n; i++)
+      sum += bl_recall(i & 7);
+    count += (sum == -1);              // keep result alive
+  }
+
+  BL_BENCH(clock_us,1000)
+  {
+    BL_us sum = 0;
+    for (int i=0; i < n; i++)
+      sum += bl_us();
+    count += (sum == -1);              // keep result alive
+  }
+
+  BL_BENCH(clock_ms,1000)
+  {
+    BL_ms sum = 0;
+    for (int i=0; i < n; i++)
+      sum += bl_ms();
+    count += (sum == -1);              // keep result alive
+  }
+
+  BL_BENCH(clock_hms,1000)
+  {
+    static BL_hms t;
+    static BL_us us = 0;
+    for (int i=0; i < n; i++)
+      bl_hms(&t,us += 1234);           // log line every 1.234 ms
+    count += (t.min == -1);            // keep result alive
+  }
+
+//==============================================================================
+// logo_on setup/teardown: redirect stdout to /dev/null, raise verbose level
+//==============================================================================
+
+  static int saved = -1;               // saved stdout file descriptor
+
+  static void quiet(void *ctx)
+  {
+    fflush(stdout);
+    saved = dup(1);
+    int fd = open("/dev/null",O_WRONLY);
+    dup2(fd,1);  close(fd);
+    bl_verbose(4);
+  }
+
+  static void loud(void *ctx)
+  {
+    bl_verbose(0);
+    fflush(stdout);
+    dup2(saved,1);  close(saved);
+  }
+
+//==============================================================================
+// log_muted setup/teardown: verbose level 4, but GEAR area muted by [SYS:LOG]
+//==============================================================================
+
+  static void mute(void *ctx)
+  {
+    bl_verbose(4);
+    bl_msg((bluccino),_SYS,LOG_, BL_AREA_GEAR,NULL,BL_LOGOFF);
+  }
+
+  static void unmute(void *ctx)
+  {
+    bl_msg((bluccino),_SYS,LOG_, BL_AREA_GEAR,NULL,BL_LOGANY);
+    bl_verbose(0);
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    BL_benchfmt fmt = BL_BENCH_TEXT;
+    if (argc > 1 && strcmp(argv[1],"csv") == 0)
+      fmt = BL_BENCH_CSV;
+    else if (argc > 1 && strcmp(argv[1],"json") == 0)
+      fmt = BL_BENCH_JSON;
+
+    bl_verbose(0);                     // no logging during benchmark
+    bl_init(bluccino,app);             // init gears, output to app
+
+    logo_on_bench.setup = quiet;
+    logo_on_bench.teardown = loud;
+    log_muted_bench.setup = mute;
+    log_muted_bench.teardown = unmute;
+
+    bl_bench_add(&post_bench);
+    bl_bench_add(&out_aug_bench);
+    bl_bench_add(&roundtrip_bench);
+    bl_bench_add(&logo_off_bench);
+    bl_bench_add(&logo_on_bench);
+    bl_bench_add(&log_muted_bench);
+    bl_bench_add(&nvm_store_bench);
+    bl_bench_add(&nvm_recall_bench);
+    bl_bench_add(&clock_us_bench);
+    bl_bench_add(&clock_ms_bench);
+    bl_bench_add(&clock_hms_bench);
+
+    int n = bl_bench_run(fmt);
+
+    long expect = 3 * 1000 * (CFG_BENCH_WARMUP + CFG_BENCH_SAMPLES);
+    bool ok = (n == 11) && (count == expect) && (bl_recall(3) == nvm[3]);
+    if (fmt == BL_BENCH_TEXT)
+      printf("result: %s (%d cases, %ld messages)\n",
+             ok ? "OK" : "FAILED", n, count);
+    return ok ? 0 : 1;
+  }
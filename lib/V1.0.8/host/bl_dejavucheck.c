@@ -0,0 +1,82 @@
+//==============================================================================
+//  bl_dejavucheck.c
+//  host test of the mesh replay cache (bl_dejavu)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_dejavucheck               // plain C, no RTOS needed
+//
+// SET messages (src,dst,tid) are fed into the replay caches of two server
+// models like a mesh SET handler does (check, process, remember), and the
+// repetition verdicts are compared against the expected ones:
+//
+//   duplicate tid within the transaction window (ignored)
+//   new tid from the same source (processed)
+//   same tid after the transaction window expired (processed)
+//   same tid from another source or for another destination (processed)
+//   same tid for another model's cache (processed, caches are separate)
+//   many interleaved sources (more than the probe window of one slot)
+//
+//==============================================================================
+
+  #include <stdio.h>
+
+  #include "bl_dejavu.h"
+
+  static BL_DEJAVU(gen_seen);          // replay cache of a generic model
+  static BL_DEJAVU(vnd_seen);          // replay cache of a vendor model
+
+  static bool ok = true;
+
+//==============================================================================
+// helper: feed a SET message into a replay cache, check the verdict
+//==============================================================================
+
+  static void set(BL_dejavu *seen, uint16_t src, uint16_t dst, uint8_t tid,
+                  int64_t ms, bool repeat, const char *what)
+  {
+    bool got = bl_dejavu(seen,src,dst,tid,ms);
+    if (!got)
+      bl_dejavu_remember(seen,src,dst,tid,ms);   // processed
+
+    ok = ok && (got == repeat);
+    printf("%s %6d ms src:0x%04X dst:0x%04X tid:%3d %-9s %s\n",
+           got == repeat ? "  " : "!!", (int)ms, src, dst, tid,
+           got ? "ignored" : "processed", what);
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(void)
+  {
+    int64_t t = 1000;
+
+    set(gen_seen,0x0001,0xC000,7,t,      false,"first message");
+    set(gen_seen,0x0001,0xC000,7,t+50,   true, "repetition");
+    set(gen_seen,0x0001,0xC000,7,t+5900, true, "repetition (5.9 s)");
+    set(gen_seen,0x0001,0xC000,8,t+6000, false,"new tid");
+
+    t += 6000;
+    set(gen_seen,0x0001,0xC000,8,t+6001, false,"tid of expired window");
+    set(gen_seen,0x0001,0xC000,8,t+6002, true, "repetition");
+
+    t += 7000;
+    set(gen_seen,0x0002,0xC000,8,t,      false,"other source");
+    set(gen_seen,0x0001,0xC001,8,t,      false,"other destination");
+    set(vnd_seen,0x0001,0xC000,8,t,      false,"vendor model, same tid");
+    set(vnd_seen,0x0001,0xC000,8,t+10,   true, "vendor repetition");
+    set(gen_seen,0x0001,0xC000,9,t+20,   false,"generic model, new tid");
+    set(vnd_seen,0x0001,0xC000,9,t+30,   false,"vendor model, tid 9");
+
+    t += 100;
+    for (int i=0; i < CFG_DEJAVU_SLOTS/2; i++)     // interleaved clients
+      set(gen_seen,0x0100+i,0xC000,(uint8_t)i,t+i,false,"client");
+    for (int i=0; i < CFG_DEJAVU_SLOTS/2; i++)
+      set(gen_seen,0x0100+i,0xC000,(uint8_t)i,t+100+i,true,"client repeats");
+
+    printf("result: %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+  }
@@ -0,0 +1,90 @@
+//==============================================================================
+//  bl_gearbench.c
+//  host microbenchmark of up gear traversal (augmented class handling)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_gearbench_view [<messages>]   // CFG_GEAR_INPLACE 1 (in place)
+//        bl_gearbench_copy [<messages>]   // CFG_GEAR_INPLACE 0 (default)
+//
+// Posts messages through the up gear to the app, the typical path of a
+// driver event: bl_up -> bl_out -> bl_top -> bl_emit -> app. Two flavours:
+//
+//   [#BUTTON:PRESS] -> bl_up          // augmented at bl_up: one AUG flip
+//   [BUTTON:CLICK]  -> _bl_out(bl_up) // augmented view, then un-augmented
+//
+// The app checks the message and counts whether it received the poster's
+// object itself (pointer identity, zero-copy) or a copy.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+
+  #include "bluccino.h"
+
+  static long count = 0;               // messages received by app
+  static long same = 0;                // ... with the poster's object
+  static long bad = 0;                 // ... with a wrong class tag
+  static BL_ob *posted = NULL;         // object posted by main()
+
+//==============================================================================
+// app module: receives un-augmented [BUTTON:] messages
+//==============================================================================
+
+  static int app(BL_ob *o, int val)
+  {
+    if (o->cl == _SYS)
+      return 0;
+
+    count++;
+    same += (o == posted);
+    bad += (o->cl != _BUTTON);
+    return 0;
+  }
+
+//==============================================================================
+// helper: post <n> messages, return ns per message
+//==============================================================================
+
+  static double run(BL_ob *o, long n, bool aug_out)
+  {
+    posted = o;
+    uint64_t t0 = bl_nsec();
+    for (long i=0; i < n; i++)
+      if (aug_out)
+        _bl_out(o,(int)i,bl_up);       // augmented view to up gear
+      else
+        bl_up(o,(int)i);               // augmented message to up gear
+    return (double)(bl_nsec() - t0) / n;
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    long n = (argc > 1) ? atol(argv[1]) : 10000000;
+
+    bl_verbose(0);                     // no logging during benchmark
+    bl_init(bluccino,app);             // init gears, output to app
+
+    BL_ob press = {BL_AUG(_BUTTON),PRESS_,1,NULL};
+    BL_ob click = {_BUTTON,CLICK_,1,NULL};
+
+    double t1 = run(&press,n,false);
+    bool ok = (press.cl == BL_AUG(_BUTTON));     // view restored?
+    double t2 = run(&click,n,true);
+    ok = ok && (click.cl == _BUTTON);
+
+    ok = ok && !bad && count == 2*n;
+    printf("CFG_GEAR_INPLACE %d: [#BUTTON:PRESS] -> bl_up %5.1f ns,"
+           " [BUTTON:CLICK] -> _bl_out(bl_up) %5.1f ns\n",
+           CFG_GEAR_INPLACE, t1, t2);
+    printf("received: %ld messages, %ld poster's object (zero-copy), %ld bad\n",
+           count, same, bad);
+    printf("result: %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+  }
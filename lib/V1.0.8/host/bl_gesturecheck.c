@@ -0,0 +1,116 @@
+//==============================================================================
+//  bl_gesturecheck.c
+//  host test of the button gesture engine (bl_gesture) in virtual time
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_gesturecheck              // runs in virtual time (deterministic)
+//
+// Button edges of two buttons are fed into their gestures with bl_sleep()
+// pauses in between. The gestures recognized by the engine (timer driven,
+// no ticks) are compared against the expected sequence:
+//
+//   single, double and triple click of button @1
+//   click of button @1, followed by a hold (click posted at hold begin)
+//   hold of button @1 with hold repeat
+//   hold of button @1, followed by a click (one-button combo)
+//   double click of button @1 while button @2 is held (two-button combo)
+//
+//==============================================================================
+
+  #include <stdio.h>
+
+  #include "bluccino.h"
+
+  typedef struct Event { BL_op op; int id; int val; } Event;
+
+  static Event got[64];                // recognized gestures
+  static int n = 0;
+
+  static const Event expect[] =
+         {
+           {CLICK_,1,1},  {CLICK_,1,2},  {CLICK_,1,3},
+           {CLICK_,1,1},  {HOLD_,1,0},   {HOLD_,1,400},
+           {HOLD_,1,0},   {HOLD_,1,850}, {HOLD_,1,1200},
+           {HOLD_,1,0},   {HOLD_,1,400}, {COMBO_,1,1+256*1},
+           {HOLD_,2,0},   {HOLD_,2,850}, {HOLD_,2,900},  {COMBO_,1,2+256*2},
+         };
+
+//==============================================================================
+// gesture output: record recognized gestures
+//==============================================================================
+
+  static int out(BL_ob *o, int val)
+  {
+    if (n < (int)BL_LENGTH(got))
+      got[n++] = (Event){o->op,o->id,val};
+    return 0;
+  }
+
+  static BL_GESTURE(g1,1,out);         // gesture of button @1
+  static BL_GESTURE(g2,2,out);         // gesture of button @2
+
+//==============================================================================
+// helper: press/release button, then sleep
+//==============================================================================
+
+  static void press(BL_gesture *g, int ms)
+  {
+    BL_ob oo = {BL_AUG(_BUTTON),PRESS_,g->id,NULL};
+    bl_gesture(g,&oo,0);
+    bl_sleep(ms);
+  }
+
+  static void release(BL_gesture *g, int ms)
+  {
+    BL_ob oo = {BL_AUG(_BUTTON),RELEASE_,g->id,NULL};
+    bl_gesture(g,&oo,0);
+    bl_sleep(ms);
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(void)
+  {
+    bl_host_virtual(600*1000000LL);    // deterministic virtual time
+
+    press(&g1,100); release(&g1,400);                    // single click
+
+    press(&g1,100); release(&g1,100);                    // double click
+    press(&g1,100); release(&g1,400);
+
+    for (int i=0; i < 3; i++)                            // triple click
+    {
+      press(&g1,80); release(&g1,i < 2 ? 120 : 400);
+    }
+
+    press(&g1,100); release(&g1,100);                    // click + hold
+    press(&g1,400); release(&g1,400);
+
+    press(&g1,1200); release(&g1,400);                   // hold & repeat
+
+    press(&g1,400); release(&g1,100);                    // hold + click
+    press(&g1,100); release(&g1,400);
+
+    press(&g2,400);                                      // @2 held
+    press(&g1,100); release(&g1,100);                    // double click @1
+    press(&g1,100); release(&g1,200);
+    release(&g2,400);
+
+    bool ok = (n == (int)BL_LENGTH(expect));
+    for (int i=0; i < n; i++)
+    {
+      bool match = i < (int)BL_LENGTH(expect) && got[i].op == expect[i].op &&
+                   got[i].id == expect[i].id && got[i].val == expect[i].val;
+      ok = ok && match;
+      printf("%s [BUTTON:%s @%d,%d]\n", match ? "  " : "!!",
+             got[i].op == CLICK_ ? "CLICK" : got[i].op == HOLD_ ? "HOLD" :
+             got[i].op == COMBO_ ? "COMBO" : "???", got[i].id,got[i].val);
+    }
+
+    printf("result: %s (%d gestures)\n", ok ? "OK" : "FAILED", n);
+    return ok ? 0 : 1;
+  }
@@ -0,0 +1,583 @@
+//==============================================================================
+//  bl_gpioemu.c
+//  host (POSIX) GPIO emulator - input script player and waveform trace
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Backs the host shim of the Zephyr GPIO API (drivers/gpio.h) with one
+// emulated 32 pin port "GPIO_0". Inputs are driven by gpio_emul_input_set()
+// or by the input script (BL_GPIO_SCRIPT), outputs are recorded in the
+// waveform trace (BL_GPIO_TRACE). See drivers/gpio/gpio_emul.h for details.
+//
+// All port state is protected by the 'CPU' lock (irq_lock), interrupt
+// callbacks are called with the lock held (ISR context), like the callbacks
+// of k_timer expiry functions.
+//
+//==============================================================================
+
+  #include <stdlib.h>
+  #include <stdio.h>
+  #include <string.h>
+  #include <ctype.h>
+  #include <errno.h>
+
+  #include "bl_host.h"
+  #include "drivers/gpio.h"
+  #include "drivers/gpio/gpio_emul.h"
+
+//==============================================================================
+// emulated port
+//==============================================================================
+
+  typedef struct Port                  // state of an emulated GPIO port
+          {
+            uint32_t input;            // raw input levels
+            uint32_t output;           // raw output levels
+            uint32_t in;               // pins configured as input
+            uint32_t out;              // pins configured as output
+            uint32_t low;              // active low pins
+            uint32_t rise;             // pins interrupting on raw rising edge
+            uint32_t fall;             // pins interrupting on raw falling edge
+            struct gpio_callback *cbs; // interrupt callbacks
+          } Port;
+
+  static Port port0;
+
+  const struct device __device_gpio_0 = {"GPIO_0", &port0};
+
+  static bool once = false;            // board init done?
+  static void board(void);             // board init (environment)
+  static void trace(gpio_pin_t pin, int level, bool output);
+
+  static Port *data(const struct device *dev)
+  {
+    board();
+    return dev ? (Port*)dev->data : NULL;
+  }
+
+//==============================================================================
+// devices
+//==============================================================================
+
+  const struct device *device_get_binding(const char *name)
+  {
+    board();
+    if (name && strcmp(name,__device_gpio_0.name) == 0)
+      return &__device_gpio_0;
+    return NULL;
+  }
+
+  bool device_is_ready(const struct device *dev)
+  {
+    return data(dev) != NULL;
+  }
+
+//==============================================================================
+// helper: raw port value (input pins read input, output pins read output)
+//==============================================================================
+
+  static inline uint32_t raw(Port *p)
+  {
+    return (p->input & ~p->out) | (p->output & p->out);
+  }
+
+//==============================================================================
+// helper: set raw output levels of masked pins (caller holds CPU lock)
+//==============================================================================
+
+  static void drive(Port *p, uint32_t mask, uint32_t value)
+  {
+    uint32_t changed = (p->output ^ value) & mask;
+    p->output = (p->output & ~mask) | (value & mask);
+
+    for (int pin=0; changed; pin++, changed >>= 1)
+      if ((changed & 1) && (p->out & BIT(pin)))
+        trace(pin,((p->output >> pin) & 1) ^ ((p->low >> pin) & 1),true);
+  }
+
+//==============================================================================
+// pin configuration
+//==============================================================================
+
+  int gpio_pin_configure(const struct device *port, gpio_pin_t pin,
+                         gpio_flags_t flags)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    uint32_t bit = BIT(pin);
+
+    p->low = (flags & GPIO_ACTIVE_LOW) ? (p->low | bit) : (p->low & ~bit);
+    p->in = (flags & GPIO_INPUT) ? (p->in | bit) : (p->in & ~bit);
+
+    if (flags & GPIO_OUTPUT)
+    {
+      uint32_t level = p->output & bit;
+      if (flags & (GPIO_OUTPUT_INIT_LOW | GPIO_OUTPUT_INIT_HIGH))
+      {
+        level = (flags & GPIO_OUTPUT_INIT_HIGH) ? bit : 0;
+        if ((flags & GPIO_OUTPUT_INIT_LOGICAL) && (p->low & bit))
+          level ^= bit;
+      }
+      p->out |= bit;
+      drive(p,bit,level);
+    }
+    else
+      p->out &= ~bit;
+
+    irq_unlock(key);
+    return 0;
+  }
+
+  int gpio_pin_interrupt_configure(const struct device *port, gpio_pin_t pin,
+                                   gpio_flags_t flags)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    bool rise = (flags & GPIO_INT_ENABLE) && (flags & GPIO_INT_HIGH_1);
+    bool fall = (flags & GPIO_INT_ENABLE) && (flags & GPIO_INT_LOW_0);
+
+    unsigned key = irq_lock();
+    uint32_t bit = BIT(pin);
+
+    if ((flags & GPIO_INT_LEVELS_LOGICAL) && (p->low & bit))
+    {
+      bool swap = rise;  rise = fall;  fall = swap;   // logical => raw edges
+    }
+
+    p->rise = rise ? (p->rise | bit) : (p->rise & ~bit);
+    p->fall = fall ? (p->fall | bit) : (p->fall & ~bit);
+
+    irq_unlock(key);
+    return 0;
+  }
+
+//==============================================================================
+// interrupt callbacks
+//==============================================================================
+
+  int gpio_add_callback(const struct device *port, struct gpio_callback *cb)
+  {
+    Port *p = data(port);
+    if (!p || !cb)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    for (struct gpio_callback *c = p->cbs; c; c = c->next)
+      if (c == cb)
+      {
+        irq_unlock(key);
+        return 0;                      // already added
+      }
+    cb->next = p->cbs;
+    p->cbs = cb;
+    irq_unlock(key);
+    return 0;
+  }
+
+  int gpio_remove_callback(const struct device *port, struct gpio_callback *cb)
+  {
+    Port *p = data(port);
+    if (!p || !cb)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    for (struct gpio_callback **pp = &p->cbs; *pp; pp = &(*pp)->next)
+      if (*pp == cb)
+      {
+        *pp = cb->next;
+        irq_unlock(key);
+        return 0;
+      }
+    irq_unlock(key);
+    return -EINVAL;
+  }
+
+//==============================================================================
+// pin & port access
+//==============================================================================
+
+  int gpio_pin_get_raw(const struct device *port, gpio_pin_t pin)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    int level = (raw(p) >> pin) & 1;
+    irq_unlock(key);
+    return level;
+  }
+
+  int gpio_pin_get(const struct device *port, gpio_pin_t pin)
+  {
+    int level = gpio_pin_get_raw(port,pin);
+    if (level < 0)
+      return level;
+    return level ^ (int)((((Port*)port->data)->low >> pin) & 1);
+  }
+
+  int gpio_pin_set_raw(const struct device *port, gpio_pin_t pin, int value)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    drive(p,BIT(pin),value ? BIT(pin) : 0);
+    irq_unlock(key);
+    return 0;
+  }
+
+  int gpio_pin_set(const struct device *port, gpio_pin_t pin, int value)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    uint32_t level = ((value != 0) ^ ((p->low >> pin) & 1)) ? BIT(pin) : 0;
+    drive(p,BIT(pin),level);
+    irq_unlock(key);
+    return 0;
+  }
+
+  int gpio_pin_toggle(const struct device *port, gpio_pin_t pin)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    drive(p,BIT(pin),p->output ^ BIT(pin));
+    irq_unlock(key);
+    return 0;
+  }
+
+  int gpio_port_get_raw(const struct device *port, gpio_port_value_t *value)
+  {
+    Port *p = data(port);
+    if (!p || !value)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    *value = raw(p);
+    irq_unlock(key);
+    return 0;
+  }
+
+  int gpio_port_set_masked_raw(const struct device *port,
+                               gpio_port_pins_t mask, gpio_port_value_t value)
+  {
+    Port *p = data(port);
+    if (!p)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    drive(p,mask,value);
+    irq_unlock(key);
+    return 0;
+  }
+
+//==============================================================================
+// emulator back door
+//==============================================================================
+
+  int gpio_emul_input_set(const struct device *port, gpio_pin_t pin,
+                          int value)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    unsigned key = irq_lock();         // ISR context from here on
+    uint32_t bit = BIT(pin);
+
+    if (p->out & bit)
+    {
+      irq_unlock(key);
+      return -EINVAL;                  // can't drive an output pin
+    }
+
+    uint32_t old = p->input & bit;
+    uint32_t level = ((value != 0) ^ ((p->low & bit) != 0)) ? bit : 0;
+    p->input = (p->input & ~bit) | level;
+
+    if (old != level)
+    {
+      trace(pin,value != 0,false);
+      if ((level && (p->rise & bit)) || (!level && (p->fall & bit)))
+        for (struct gpio_callback *cb = p->cbs; cb; cb = cb->next)
+          if ((cb->pin_mask & bit) && cb->handler)
+            cb->handler(port,cb,bit);
+    }
+
+    irq_unlock(key);
+    return 0;
+  }
+
+  int gpio_emul_output_get(const struct device *port, gpio_pin_t pin)
+  {
+    Port *p = data(port);
+    if (!p || pin >= 32)
+      return -EINVAL;
+
+    unsigned key = irq_lock();
+    int level = ((p->output ^ p->low) >> pin) & 1;
+    irq_unlock(key);
+    return level;
+  }
+
+//==============================================================================
+// board pins (trace signals & script names)
+//==============================================================================
+
+  typedef struct Signal                // traced board pin
+          {
+            const char *name;          // board alias
+            gpio_pin_t pin;            // pin number
+          } Signal;
+
+  static const Signal signals[] =
+         {
+           {"sw0", DT_ALIAS(sw0)},   {"sw1", DT_ALIAS(sw1)},
+           {"sw2", DT_ALIAS(sw2)},   {"sw3", DT_ALIAS(sw3)},
+           {"led0",DT_ALIAS(led0)},  {"led1",DT_ALIAS(led1)},
+           {"led2",DT_ALIAS(led2)},  {"led3",DT_ALIAS(led3)},
+         };
+
+  #define NSIG  (int)(sizeof(signals)/sizeof(signals[0]))
+
+  static int sigidx(gpio_pin_t pin)    // signal index of pin (-1: none)
+  {
+    for (int i=0; i < NSIG; i++)
+      if (signals[i].pin == pin)
+        return i;
+    return -1;
+  }
+
+//==============================================================================
+// waveform trace (value change dump) and latency statistics
+//==============================================================================
+
+  static FILE *vcd = NULL;             // trace file
+  static int64_t stamp = -1;           // time stamp of last trace entry (us)
+
+  static struct Latency                // input -> output latency statistics
+         {
+           int64_t since;              // time of unanswered input edge (-1)
+           int from;                   // signal of unanswered input edge
+           long inputs, outputs;       // number of input/output edges
+           long n;                     // number of measured latencies
+           int64_t min, max, sum;      // latency statistics (us)
+         } lat = {-1};
+
+  static void trace(gpio_pin_t pin, int level, bool output)
+  {
+    int64_t now = bl_host_us();
+    int sig = sigidx(pin);
+
+    if (output)
+      lat.outputs++;
+    else
+      lat.inputs++;
+
+    if (output && lat.since >= 0)      // first output edge after input edge
+    {
+      int64_t us = now - lat.since;
+      lat.min = (lat.n == 0 || us < lat.min) ? us : lat.min;
+      lat.max = (lat.n == 0 || us > lat.max) ? us : lat.max;
+      lat.sum += us;  lat.n++;
+      lat.since = -1;
+
+      if (vcd && sig >= 0 && lat.from >= 0)
+        fprintf(vcd,"$comment %s -> %s: %lld us $end\n",
+                signals[lat.from].name,signals[sig].name,(long long)us);
+    }
+    else if (!output)
+    {
+      lat.since = now;
+      lat.from = sig;
+    }
+
+    if (!vcd || sig < 0)
+      return;
+
+    if (now != stamp)
+      fprintf(vcd,"#%lld\n",(long long)now);
+    stamp = now;
+    fprintf(vcd,"%d%c\n",level,'!'+sig);
+    fflush(vcd);
+  }
+
+  static void summary(void)            // at exit: print latency statistics
+  {
+    if (vcd)
+      fclose(vcd);
+    vcd = NULL;
+
+    printk("gpio: %ld input edges, %ld output edges",lat.inputs,lat.outputs);
+    if (lat.n)
+      printk(", latency (%ld): min %.3f ms, avg %.3f ms, max %.3f ms",lat.n,
+             lat.min/1000.0,lat.sum/1000.0/lat.n,lat.max/1000.0);
+    printk("\n");
+  }
+
+  static void report(void)             // print summary at exit (once)
+  {
+    static bool registered = false;
+    if (!__atomic_exchange_n(&registered,true,__ATOMIC_ACQ_REL))
+      atexit(summary);
+  }
+
+  int bl_host_gpio_trace(const char *path)
+  {
+    report();
+    unsigned key = irq_lock();
+    if (vcd)
+      fclose(vcd);
+
+    vcd = fopen(path,"w");
+    if (!vcd)
+    {
+      irq_unlock(key);
+      printk("gpio: cannot open trace file %s\n",path);
+      return -1;
+    }
+
+    fprintf(vcd,"$timescale 1us $end\n$scope module GPIO_0 $end\n");
+    for (int i=0; i < NSIG; i++)
+      fprintf(vcd,"$var wire 1 %c %s $end\n",'!'+i,signals[i].name);
+    fprintf(vcd,"$upscope $end\n$enddefinitions $end\n");
+
+    uint32_t levels = raw(&port0) ^ port0.low;
+    stamp = bl_host_us();
+    fprintf(vcd,"#%lld\n$dumpvars\n",(long long)stamp);
+    for (int i=0; i < NSIG; i++)
+      fprintf(vcd,"%d%c\n",(int)((levels >> signals[i].pin) & 1),'!'+i);
+    fprintf(vcd,"$end\n");
+
+    irq_unlock(key);
+    return 0;
+  }
+
+//==============================================================================
+// input script player
+//==============================================================================
+
+  typedef struct Step                  // input script step
+          {
+            int64_t us;                // due time (uptime in us)
+            gpio_pin_t pin;            // input pin
+            int level;                 // logical level
+          } Step;
+
+  static Step *steps = NULL;           // input script
+  static int nsteps = 0;               // number of script steps
+  static int next = 0;                 // next step to play
+
+  static void play(struct k_timer *timer)   // ISR context
+  {
+    int64_t now = bl_host_us();
+    for (; next < nsteps && steps[next].us <= now; next++)
+      gpio_emul_input_set(&__device_gpio_0,steps[next].pin,steps[next].level);
+
+    if (next < nsteps)
+      k_timer_start(timer,K_USEC(steps[next].us - now),K_NO_WAIT);
+  }
+
+  K_TIMER_DEFINE(player, play, NULL);
+
+  static int lookup(const char *name)     // pin number of alias/number (-1)
+  {
+    for (int i=0; i < NSIG; i++)
+      if (strcmp(name,signals[i].name) == 0)
+        return signals[i].pin;
+
+    char *end;
+    long n = strtol(name,&end,10);
+    return (*end || end == name || n < 0 || n > 31) ? -1 : (int)n;
+  }
+
+  int bl_host_gpio_script(const char *path)
+  {
+    report();
+    FILE *f = fopen(path,"r");
+    if (!f)
+    {
+      printk("gpio: cannot open input script %s\n",path);
+      return -1;
+    }
+
+    char buf[256], name[32];
+    int64_t ms = 0;
+    int cap = 0, lno = 0;
+
+    k_timer_stop(&player);
+    free(steps);
+    steps = NULL;  nsteps = next = 0;
+
+    while (fgets(buf,sizeof(buf),f))
+    {
+      lno++;
+      char *s = buf, *hash = strchr(buf,'#');
+      if (hash)
+        *hash = 0;                     // strip comment
+      while (isspace((unsigned char)*s))
+        s++;
+      if (!*s)
+        continue;                      // empty line
+
+      bool rel = (*s == '+');
+      long long t;
+      int level;
+      if (sscanf(s + rel,"%lld %31s %d",&t,name,&level) != 3 || lookup(name) < 0)
+      {
+        printk("gpio: %s:%d: bad line ignored\n",path,lno);
+        continue;
+      }
+
+      ms = rel ? ms + t : t;
+      if (nsteps == cap)
+        steps = realloc(steps,(cap = cap ? 2*cap : 64) * sizeof(Step));
+      steps[nsteps++] = (Step){ms*1000,(gpio_pin_t)lookup(name),level != 0};
+    }
+    fclose(f);
+
+    for (int i=1; i < nsteps; i++)     // stable sort by due time
+      for (int j=i; j > 0 && steps[j-1].us > steps[j].us; j--)
+      {
+        Step swap = steps[j];  steps[j] = steps[j-1];  steps[j-1] = swap;
+      }
+
+    if (nsteps)
+    {
+      int64_t now = bl_host_us();
+      k_timer_start(&player,K_USEC(steps[0].us > now ? steps[0].us - now : 0),
+                    K_NO_WAIT);
+    }
+    return 0;
+  }
+
+//==============================================================================
+// board init (at first GPIO usage): apply environment
+//==============================================================================
+
+  static void board(void)
+  {
+    if (__atomic_exchange_n(&once,true,__ATOMIC_ACQ_REL))
+      return;
+
+    const char *trc = getenv("BL_GPIO_TRACE");
+    const char *scr = getenv("BL_GPIO_SCRIPT");
+
+    if (trc)
+      bl_host_gpio_trace(trc);
+    if (scr)
+      bl_host_gpio_script(scr);
+  }
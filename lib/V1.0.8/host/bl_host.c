@@ -0,0 +1,545 @@
+//==============================================================================
+//  bl_host.c
+//  host (POSIX) port layer - Zephyr kernel subset on top of pthreads
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include <stdarg.h>
+  #include <stdlib.h>
+  #include <errno.h>
+  #include <time.h>
+  #include <pthread.h>
+
+  #include "bl_host.h"
+
+//==============================================================================
+// locals
+//==============================================================================
+
+  static pthread_mutex_t cpu;          // 'CPU' lock (recursive)
+  static pthread_mutex_t mtx;          // protects work queue & timer list
+  static pthread_cond_t wcv;           // work queue condition
+  static pthread_cond_t tcv;           // timer list condition
+  static pthread_cond_t scv;           // semaphore condition
+  static pthread_once_t once = PTHREAD_ONCE_INIT;
+
+  static struct k_work *head = NULL;   // work queue head
+  static struct k_work *tail = NULL;   // work queue tail
+  static struct k_timer *timers = NULL;// list of active timers (sorted by due)
+
+  static volatile bool virt = false;   // virtual time mode
+  static int64_t vnow = 1;             // virtual clock (us), never reads 0
+  static int64_t horizon = 0;          // virtual end time (us), 0: none
+
+  static void advance(int64_t due, struct k_sem *sem);  // virtual time
+
+//==============================================================================
+// console output
+//==============================================================================
+
+  void printk(const char *fmt, ...)
+  {
+    va_list args;
+    va_start(args,fmt);
+    vprintf(fmt,args);
+    va_end(args);
+    fflush(stdout);                    // keep log order with stderr/tools
+  }
+
+  void bl_rtl_write(const void *data, int len)  // raw output (binary RTL)
+  {
+    fwrite(data,1,len,stdout);
+    fflush(stdout);
+  }
+
+//==============================================================================
+// clock & sleep
+//==============================================================================
+
+  int64_t bl_host_ns(void)             // monotonic clock time in ns
+  {
+    if (virt)
+      return vnow * 1000;              // virtual clock
+
+    static int64_t t0 = -1;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    int64_t ns = (int64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+    if (t0 < 0)                        // uptime starts at first call, but
+      t0 = ns - 1000;                  // never reads 0 (bl_us() clock reset)
+    return ns - t0;
+  }
+
+  int64_t bl_host_us(void)             // monotonic clock time in us
+  {
+    return virt ? vnow : bl_host_ns() / 1000;
+  }
+
+  static void sleep_us(int64_t us)     // sleep for given microseconds
+  {
+    struct timespec ts = {us/1000000, (us%1000000)*1000};
+    while (nanosleep(&ts,&ts) != 0 && errno == EINTR)
+      ;                                // continue sleeping if interrupted
+  }
+
+  int32_t k_msleep(int32_t ms)
+  {
+    if (ms > 0 && virt)
+      advance(vnow + (int64_t)ms*1000,NULL);   // fast forward
+    else if (ms > 0)
+      sleep_us((int64_t)ms*1000);
+    return 0;
+  }
+
+  int64_t k_uptime_get(void)           { return bl_host_us() / 1000; }
+  uint32_t k_uptime_get_32(void)       { return (uint32_t)k_uptime_get(); }
+  int64_t k_uptime_ticks(void)         { return bl_host_us(); }
+  uint32_t k_cycle_get_32(void)        { return (uint32_t)bl_host_ns(); }
+  uint64_t k_cycle_get_64(void)        { return (uint64_t)bl_host_ns(); }
+  uint32_t sys_clock_hw_cycles_per_sec(void) { return 1000000000; }
+
+//==============================================================================
+// helper: absolute CLOCK_MONOTONIC timespec for pthread_cond_timedwait
+//==============================================================================
+
+  static struct timespec abstime(int64_t due)
+  {
+    struct timespec ts;
+    int64_t now = bl_host_us();
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    int64_t ns = ts.tv_nsec + (due - now)*1000;
+    ts.tv_sec += ns / 1000000000;
+    ts.tv_nsec = ns % 1000000000;
+    if (ts.tv_nsec < 0)
+    {
+      ts.tv_sec--;  ts.tv_nsec += 1000000000;
+    }
+    return ts;
+  }
+
+//==============================================================================
+// interrupt locking
+//==============================================================================
+
+  static __thread unsigned int locked = 0;   // 'CPU' lock depth of thread
+
+  unsigned int irq_lock(void)          // key: lock depth before locking
+  {
+    unsigned int key = locked;
+    pthread_mutex_lock(&cpu);
+    if (key)
+      pthread_mutex_unlock(&cpu);      // already locked: keep one count
+    locked = 1;
+    return key;
+  }
+
+  void irq_unlock(unsigned int key)    // like Zephyr: key restores state
+  {
+    if (key == 0 && locked)
+    {
+      locked = 0;
+      pthread_mutex_unlock(&cpu);
+    }
+  }
+
+//==============================================================================
+// work queue thread (emulates the system work queue)
+//==============================================================================
+
+  static void *workqueue(void *arg)
+  {
+    for (;;)
+    {
+      pthread_mutex_lock(&mtx);
+      while (head == NULL || virt)     // virtual time: run by advance()
+        pthread_cond_wait(&wcv,&mtx);
+
+      struct k_work *work = head;      // pop work item
+      head = work->next;
+      if (head == NULL)
+        tail = NULL;
+      work->next = NULL;
+      work->pending = false;
+      pthread_mutex_unlock(&mtx);
+
+      work->handler(work);             // run work handler (thread context)
+    }
+    return NULL;
+  }
+
+//==============================================================================
+// timer thread (emulates system clock interrupts)
+//==============================================================================
+
+  static void unlink(struct k_timer *timer)   // caller must hold mtx
+  {
+    for (struct k_timer **pp = &timers; *pp; pp = &(*pp)->next)
+      if (*pp == timer)
+      {
+        *pp = timer->next;
+        break;
+      }
+    timer->next = NULL;
+  }
+
+  static void link(struct k_timer *timer)     // caller must hold mtx
+  {
+    struct k_timer **pp = &timers;
+    while (*pp && (*pp)->due <= timer->due)
+      pp = &(*pp)->next;
+    timer->next = *pp;
+    *pp = timer;
+  }
+
+  static void *clock_isr(void *arg)
+  {
+    pthread_mutex_lock(&mtx);
+    for (;;)
+    {
+      if (timers == NULL || virt)      // virtual time: fired by advance()
+      {
+        pthread_cond_wait(&tcv,&mtx);
+        continue;
+      }
+
+      struct k_timer *timer = timers;
+      if (bl_host_us() < timer->due)
+      {
+        struct timespec ts = abstime(timer->due);
+        pthread_cond_timedwait(&tcv,&mtx,&ts);
+        continue;                      // re-evaluate (list may have changed)
+      }
+
+      unlink(timer);
+      timer->status++;
+      if (timer->period > 0)           // periodic timer => re-schedule
+      {
+        timer->due += timer->period;
+        link(timer);
+      }
+      else
+        timer->active = false;
+
+      k_timer_expiry_t expiry = timer->expiry_fn;
+      pthread_mutex_unlock(&mtx);
+
+      if (expiry)                      // call expiry function in 'ISR' context
+      {
+        pthread_mutex_lock(&cpu);
+        expiry(timer);
+        pthread_mutex_unlock(&cpu);
+      }
+
+      pthread_mutex_lock(&mtx);
+    }
+    return NULL;
+  }
+
+//==============================================================================
+// virtual time: run queued work items (caller's thread)
+//==============================================================================
+
+  static void run_work(void)
+  {
+    for (;;)
+    {
+      pthread_mutex_lock(&mtx);
+      struct k_work *work = head;      // pop work item
+      if (work)
+      {
+        head = work->next;
+        if (head == NULL)
+          tail = NULL;
+        work->next = NULL;
+        work->pending = false;
+      }
+      pthread_mutex_unlock(&mtx);
+
+      if (!work)
+        return;
+      work->handler(work);             // run work handler
+    }
+  }
+
+//==============================================================================
+// virtual time: fast forward to due time (or until semaphore is available)
+// - fires due timers in order of due time, the clock jumps from event to
+//   event, work items run after each event (deterministic, single thread)
+// - reaching the horizon ends the simulation with exit(0)
+//==============================================================================
+
+  static void advance(int64_t due, struct k_sem *sem)
+  {
+    int64_t limit = (horizon && due > horizon) ? horizon : due;
+
+    for (;;)
+    {
+      run_work();
+      if (sem && sem->count)
+        return;                        // semaphore given by timer or work
+
+      pthread_mutex_lock(&mtx);
+      struct k_timer *timer = timers;
+      if (!timer || timer->due > limit)
+      {
+        pthread_mutex_unlock(&mtx);
+        break;
+      }
+
+      unlink(timer);
+      if (timer->due > vnow)
+        vnow = timer->due;             // jump to next event
+      timer->status++;
+      if (timer->period > 0)           // periodic timer => re-schedule
+      {
+        timer->due += timer->period;
+        link(timer);
+      }
+      else
+        timer->active = false;
+
+      k_timer_expiry_t expiry = timer->expiry_fn;
+      pthread_mutex_unlock(&mtx);
+
+      if (expiry)                      // call expiry function in 'ISR' context
+      {
+        pthread_mutex_lock(&cpu);
+        expiry(timer);
+        pthread_mutex_unlock(&cpu);
+      }
+    }
+
+    if (limit > vnow && limit < INT64_MAX)
+      vnow = limit;
+
+    if (horizon && vnow >= horizon)
+    {
+      printk("*** virtual time horizon reached (%lld s)\n",
+             (long long)(horizon/1000000));
+      exit(0);
+    }
+
+    if (limit == INT64_MAX && !(sem && sem->count))
+    {
+      printk("*** virtual time: waiting forever without pending events\n");
+      exit(1);
+    }
+  }
+
+//==============================================================================
+// enable virtual time (before the first clock read), horizon in us (0: none)
+// - alternatively set environment variable BL_VIRTUAL=<seconds> (0: no end)
+//==============================================================================
+
+  void bl_host_virtual(int64_t horizon_us)
+  {
+    pthread_mutex_lock(&mtx);
+    virt = true;
+    horizon = horizon_us > 0 ? horizon_us : 0;
+    pthread_mutex_unlock(&mtx);
+  }
+
+//==============================================================================
+// port init (lazy, at first usage of a kernel object)
+//==============================================================================
+
+  static void init(void)
+  {
+    pthread_mutexattr_t ma;
+    pthread_mutexattr_init(&ma);
+    pthread_mutexattr_settype(&ma,PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cpu,&ma);
+    pthread_mutex_init(&mtx,NULL);
+
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca,CLOCK_MONOTONIC);
+    pthread_cond_init(&wcv,&ca);
+    pthread_cond_init(&tcv,&ca);
+    pthread_cond_init(&scv,&ca);
+
+    const char *env = getenv("BL_VIRTUAL");   // BL_VIRTUAL=<seconds>
+    if (env)
+    {
+      virt = true;
+      horizon = (int64_t)atoll(env) * 1000000;
+    }
+
+    pthread_t wq, isr;
+    pthread_create(&wq,NULL,workqueue,NULL);
+    pthread_create(&isr,NULL,clock_isr,NULL);
+    pthread_detach(wq);
+    pthread_detach(isr);
+  }
+
+  static inline void setup(void)
+  {
+    pthread_once(&once,init);
+  }
+
+    // make sure that the 'CPU' lock is initialized before main() runs
+
+  __attribute__((constructor)) static void startup(void)
+  {
+    setup();
+  }
+
+//==============================================================================
+// work items
+//==============================================================================
+
+  void k_work_init(struct k_work *work, k_work_handler_t handler)
+  {
+    setup();
+    work->handler = handler;
+    work->next = NULL;
+    work->pending = false;
+  }
+
+  int k_work_submit(struct k_work *work)
+  {
+    setup();
+    pthread_mutex_lock(&mtx);
+
+    if (work->pending)                 // already queued?
+    {
+      pthread_mutex_unlock(&mtx);
+      return 0;
+    }
+
+    work->pending = true;
+    work->next = NULL;
+    if (tail)
+      tail->next = work;
+    else
+      head = work;
+    tail = work;
+
+    pthread_cond_signal(&wcv);
+    pthread_mutex_unlock(&mtx);
+    return 1;
+  }
+
+//==============================================================================
+// semaphores
+//==============================================================================
+
+  int k_sem_init(struct k_sem *sem, unsigned int initial, unsigned int limit)
+  {
+    setup();
+    sem->count = initial;
+    sem->limit = limit;
+    return 0;
+  }
+
+  int k_sem_take(struct k_sem *sem, k_timeout_t timeout)
+  {
+    setup();
+    if (virt && sem->count == 0 && timeout.us != 0)
+    {
+      advance(timeout.us < 0 ? INT64_MAX : vnow + timeout.us,sem);
+      timeout.us = 0;                  // don't wait in real time
+    }
+
+    int64_t due = bl_host_us() + timeout.us;
+    struct timespec ts = abstime(due);
+    int err = 0;
+
+    pthread_mutex_lock(&mtx);
+    while (sem->count == 0 && err == 0)
+    {
+      if (timeout.us == 0)
+        err = -EAGAIN;
+      else if (timeout.us < 0)
+        pthread_cond_wait(&scv,&mtx);
+      else if (pthread_cond_timedwait(&scv,&mtx,&ts) == ETIMEDOUT)
+        err = -EAGAIN;
+    }
+
+    if (sem->count > 0)                // could have been given with timeout
+    {
+      sem->count--;
+      err = 0;
+    }
+    pthread_mutex_unlock(&mtx);
+    return err;
+  }
+
+  void k_sem_give(struct k_sem *sem)
+  {
+    setup();
+    pthread_mutex_lock(&mtx);
+    if (sem->count < sem->limit)
+      sem->count++;
+    pthread_cond_broadcast(&scv);      // waiters re-check their semaphore
+    pthread_mutex_unlock(&mtx);
+  }
+
+//==============================================================================
+// kernel timers
+//==============================================================================
+
+  void k_timer_init(struct k_timer *timer, k_timer_expiry_t expiry,
+                    k_timer_stop_t stop)
+  {
+    setup();
+    memset(timer,0,sizeof(*timer));
+    timer->expiry_fn = expiry;
+    timer->stop_fn = stop;
+  }
+
+  void k_timer_start(struct k_timer *timer, k_timeout_t duration,
+                     k_timeout_t period)
+  {
+    setup();
+    pthread_mutex_lock(&mtx);
+
+    if (timer->active)
+      unlink(timer);
+
+    timer->due = bl_host_us() + (duration.us > 0 ? duration.us : 0);
+    timer->period = (period.us > 0) ? period.us : 0;
+    timer->status = 0;
+    timer->active = true;
+    link(timer);
+
+    pthread_cond_signal(&tcv);
+    pthread_mutex_unlock(&mtx);
+  }
+
+  void k_timer_stop(struct k_timer *timer)
+  {
+    setup();
+    pthread_mutex_lock(&mtx);
+
+    bool active = timer->active;
+    if (active)
+    {
+      unlink(timer);
+      timer->active = false;
+    }
+    pthread_mutex_unlock(&mtx);
+
+    if (active && timer->stop_fn)
+      timer->stop_fn(timer);
+  }
+
+  uint32_t k_timer_status_get(struct k_timer *timer)
+  {
+    pthread_mutex_lock(&mtx);
+    uint32_t status = timer->status;
+    timer->status = 0;
+    pthread_mutex_unlock(&mtx);
+    return status;
+  }
+
+  int64_t k_timer_remaining_us(struct k_timer *timer)
+  {
+    pthread_mutex_lock(&mtx);
+    int64_t us = timer->active ? timer->due - bl_host_us() : 0;
+    pthread_mutex_unlock(&mtx);
+    return us > 0 ? us : 0;
+  }
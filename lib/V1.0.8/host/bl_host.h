@@ -0,0 +1,187 @@
+//==============================================================================
+//  bl_host.h
+//  host (POSIX) port layer - Zephyr kernel subset on top of pthreads
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// The host port allows to build the Bluccino core (bluccino.c) and Bluccino
+// apps as native Linux executables, e.g. for profiling the gear chain with
+// perf or valgrind. bl_rtos.h includes this header if __HOST__ is defined.
+//
+// Emulation model:
+// - one 'CPU' lock which is held by irq_lock() callers and by timer expiry
+//   functions (timer expiry functions emulate ISR context)
+// - one work queue thread (emulates Zephyr's system work queue)
+// - one timer thread (emulates system clock interrupts for k_timer's)
+// - all timeouts (k_timeout_t) are represented in microseconds
+// - one emulated GPIO port with the board's button/LED pins (bl_gpioemu.c),
+//   driven by an input script and traced to a waveform file, see
+//   drivers/gpio/gpio_emul.h
+//
+// Virtual time (bl_host_virtual() or environment BL_VIRTUAL=<seconds>):
+// - the clock is a variable which only advances when the main thread sleeps
+//   (k_msleep, k_sem_take with timeout); it then jumps from event to event,
+//   firing due timers and running queued work items in the sleeping thread
+// - runs are deterministic and an hour of tick/tock scheduling passes in
+//   seconds; the process exits when the horizon (<seconds>) is reached
+// - intended for the single threaded bl_run() engine, not for tools which
+//   produce from own pthreads (e.g. bl_ringbench)
+//
+//==============================================================================
+
+#ifndef __BL_HOST_H__
+#define __BL_HOST_H__
+
+  #include <stdint.h>
+  #include <stdbool.h>
+  #include <stddef.h>
+  #include <string.h>
+  #include <stdio.h>
+  #include <time.h>
+
+  #define __weak             __attribute__((weak))
+
+//==============================================================================
+// console output
+//==============================================================================
+
+  void printk(const char *fmt, ...);
+  void bl_rtl_write(const void *data, int len);  // raw output (binary RTL)
+
+//==============================================================================
+// clock & sleep
+// - usage: us = bl_host_us()          // monotonic clock time in us
+//          ns = bl_host_ns()          // monotonic clock time in ns (cycles)
+//          bl_host_virtual(3600*1000000LL) // virtual time, end after 1 hour
+//==============================================================================
+
+  typedef struct k_timeout_t           // timeout (host: us representation)
+          {
+            int64_t us;                // timeout in us (-1: forever)
+          } k_timeout_t;
+
+  #define K_NO_WAIT          ((k_timeout_t){0})
+  #define K_FOREVER          ((k_timeout_t){-1})
+  #define K_USEC(t)          ((k_timeout_t){(int64_t)(t)})
+  #define K_MSEC(t)          ((k_timeout_t){(int64_t)(t)*1000})
+  #define K_SECONDS(t)       ((k_timeout_t){(int64_t)(t)*1000000})
+
+  int64_t bl_host_us(void);            // monotonic clock time in us
+  int64_t bl_host_ns(void);            // monotonic clock time in ns
+  void bl_host_virtual(int64_t horizon_us);  // enable virtual time
+
+//==============================================================================
+// benchmark time stamp (real monotonic clock, also in virtual time mode)
+// - usage: t0 = bl_nsec();  ...;  dt = bl_nsec() - t0;  // elapsed ns
+//==============================================================================
+
+  static inline uint64_t bl_nsec(void)
+  {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (uint64_t)ts.tv_sec*1000000000u + ts.tv_nsec;
+  }
+
+  int32_t k_msleep(int32_t ms);        // sleep for given milliseconds
+  int64_t k_uptime_get(void);          // uptime in ms
+  uint32_t k_uptime_get_32(void);      // uptime in ms (32-bit)
+  int64_t k_uptime_ticks(void);        // uptime in ticks (host: 1 tick = 1 us)
+  uint32_t k_cycle_get_32(void);       // hardware cycles (host: 1 cycle = 1 ns)
+  uint64_t k_cycle_get_64(void);       // hardware cycles (64-bit)
+  uint32_t sys_clock_hw_cycles_per_sec(void);  // host: 1000000000 cycles/s
+
+//==============================================================================
+// interrupt locking
+// - usage: key = irq_lock();  ...  irq_unlock(key);
+// - nestable like Zephyr: key is the lock state before locking, only the
+//   outermost irq_unlock(key) releases the lock
+//==============================================================================
+
+  unsigned int irq_lock(void);         // lock 'CPU' (disable interrupts)
+  void irq_unlock(unsigned int key);   // unlock 'CPU' (enable interrupts)
+
+//==============================================================================
+// work items (system work queue)
+// - usage: K_WORK_DEFINE(work,handler);   k_work_submit(&work);
+//==============================================================================
+
+  struct k_work;
+  typedef void (*k_work_handler_t)(struct k_work *work);
+
+  struct k_work
+         {
+           k_work_handler_t handler;   // work handler
+           struct k_work *next;        // next work item in work queue
+           volatile bool pending;      // work item is queued
+         };
+
+  #define K_WORK_DEFINE(work,work_handler) \
+          struct k_work work = { .handler = work_handler }
+
+  void k_work_init(struct k_work *work, k_work_handler_t handler);
+  int k_work_submit(struct k_work *work);   // 1: queued, 0: already queued
+
+//==============================================================================
+// semaphores
+// - usage: K_SEM_DEFINE(sem,0,1);  k_sem_take(&sem,K_MSEC(10));
+//          k_sem_give(&sem);
+//==============================================================================
+
+  struct k_sem
+         {
+           volatile unsigned int count;// semaphore count
+           unsigned int limit;         // maximum count
+         };
+
+  #define K_SEM_DEFINE(name,initial,max) \
+          struct k_sem name = { .count = initial, .limit = max }
+
+  int k_sem_init(struct k_sem *sem, unsigned int initial, unsigned int limit);
+  int k_sem_take(struct k_sem *sem, k_timeout_t timeout); // 0:OK, -EAGAIN
+  void k_sem_give(struct k_sem *sem);
+
+//==============================================================================
+// kernel timers
+// - usage: K_TIMER_DEFINE(timer,expiry,stop);
+//          k_timer_start(&timer,K_MSEC(100),K_NO_WAIT)
+//==============================================================================
+
+  struct k_timer;
+  typedef void (*k_timer_expiry_t)(struct k_timer *timer);
+  typedef void (*k_timer_stop_t)(struct k_timer *timer);
+
+  struct k_timer
+         {
+           k_timer_expiry_t expiry_fn; // called on expiry (ISR context)
+           k_timer_stop_t stop_fn;     // called on k_timer_stop()
+           int64_t due;                // absolute due time (us)
+           int64_t period;             // period in us (0: one shot)
+           uint32_t status;            // number of expiries since status read
+           bool active;                // timer is running
+           struct k_timer *next;       // next active timer
+           void *user_data;            // user data
+         };
+
+  #define K_TIMER_DEFINE(name,expiry,stop) \
+          struct k_timer name = { .expiry_fn = expiry, .stop_fn = stop }
+
+  void k_timer_init(struct k_timer *timer, k_timer_expiry_t expiry,
+                    k_timer_stop_t stop);
+  void k_timer_start(struct k_timer *timer, k_timeout_t duration,
+                     k_timeout_t period);
+  void k_timer_stop(struct k_timer *timer);
+  uint32_t k_timer_status_get(struct k_timer *timer);
+  int64_t k_timer_remaining_us(struct k_timer *timer);
+
+  static inline void k_timer_user_data_set(struct k_timer *timer, void *data)
+  {
+    timer->user_data = data;
+  }
+
+  static inline void *k_timer_user_data_get(struct k_timer *timer)
+  {
+    return timer->user_data;
+  }
+
+#endif // __BL_HOST_H__
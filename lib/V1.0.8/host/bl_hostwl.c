@@ -0,0 +1,124 @@
+//==============================================================================
+//  bl_hostwl.c
+//  host (POSIX) stand-in of the wireless core (no mesh stack)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Provides the subset of the bl_wl interface which is used by the mesh node
+// house keeping (module/bl_node.c) at startup: the reset counter with its
+// due timer (like bl_reset.c, but not persistent) and the attention and
+// provision states. The node starts unprovisioned and without attention,
+// [MESH:PRV] and [MESH:ATT] messages posted to bl_wl change the states.
+//
+//==============================================================================
+
+  #include "bluccino.h"
+  #include "bl_reset.h"
+  #include "bl_wl.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO                     "bl_hostwl:"
+
+  #define LOG                     LOG_CORE
+  #define LOGO(lvl,col,o,val)     LOGO_CORE(lvl,col WHO,o,val)
+
+//==============================================================================
+// reset counter due timer (expiry posts [#RESET:DUE] from the work queue)
+//==============================================================================
+
+  static int count = 0;                // reset counter (not persistent)
+
+  static void due(struct k_work *work)
+  {
+    count = 0;
+    LOG(3,BL_M "reset counter set to zero");
+    _bl_post((bl_wl), _RESET_DUE_0_0_0, 0,NULL,0);
+  }
+
+  K_WORK_DEFINE(due_work, due);
+
+  static void fire(struct k_timer *timer)
+  {
+    k_work_submit(&due_work);          // ISR context: continue in work queue
+  }
+
+  K_TIMER_DEFINE(due_timer, fire, NULL);
+
+//==============================================================================
+// public module interface
+//==============================================================================
+//
+// (D) := (bl_down);  (U) := (bl_up);
+//
+//                  +--------------------+
+//                  |      bl_hostwl     | wireless core stand-in
+//                  +--------------------+
+//                  |        SYS:        | SYS: public interface
+// (D)->     INIT ->|       <out>        | init module, store <out> callback
+//                  +--------------------+
+//                  |       MESH:        | MESH interface
+// (D)->      PRV ->|        sts         | set provision state, notify (U)
+// (D)->      ATT ->|        sts         | set attention state, notify (U)
+//                  +--------------------+
+//                  |       RESET:       | RESET interface
+// (D)->      INC ->|         ms         | set due timer, return ++counter
+// (D)->      PRV ->|                    | unprovision node
+// (U)<-      DUE <-|                    | reset timer is due
+//                  +--------------------+
+//                  |        GET:        | GET interface
+// (D)->      ATT ->|                    | return attention state
+// (D)->      PRV ->|                    | return provision state
+//                  +--------------------+
+//
+//==============================================================================
+
+  int bl_wl(BL_ob *o, int val)
+  {
+    static bool att = false;           // attention
+    static bool prv = false;           // provision
+    static BL_oval U = bl_up;          // up gear
+
+    switch (bl_id(o))
+    {
+      case SYS_INIT_0_cb_0:            // [SYS:INIT <out>]
+        U = bl_cb(o,(U),WHO"(U)");     // store output callback
+        return 0;
+
+      case MESH_PRV_0_0_sts:           // [MESH:PRV sts] (provision)
+        prv = (val != 0);
+        return bl_out(o,val,(U));      // output to subscriber
+
+      case MESH_ATT_0_0_sts:           // [MESH:ATT sts] (attention)
+        att = (val != 0);
+        return bl_out(o,val,(U));      // output to subscriber
+
+      case RESET_INC_0_0_ms:           // cnt = [RESET:INC <ms>]
+        count++;
+        LOG(3,BL_M "reset counter: %d",count);
+        k_timer_start(&due_timer,K_MSEC(val < 1000 ? 1000 : val),K_NO_WAIT);
+        return count;                  // counter value after increment
+
+      case RESET_PRV_0_0_0:            // unprovision node
+        count = 0;
+        LOG(3,BL_B "unprovision node");
+        if (prv)
+          bl_msg((bl_wl),_MESH,PRV_, 0,NULL,0);
+        return 0;
+
+      case _RESET_DUE_0_0_0:           // reset timer is due
+        return bl_out(o,val,(U));      // output message (strip off aug bit)
+
+      case BL_ID(_GET,ATT_):
+        return att;                    // return attention state
+
+      case BL_ID(_GET,PRV_):
+        return prv;                    // return provision state
+
+      default:
+        return -1;                     // bad input
+    }
+  }
@@ -0,0 +1,118 @@
+//==============================================================================
+//  bl_ledbench.c
+//  host benchmark of RGB LED updates: three [LED:SET] versus one [LED:MASK]
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_ledbench [text|csv|json]    // default: text
+//
+// The standard LED driver (hwstd/bl_hwled.c) runs on the emulated GPIO port,
+// so both cases take the full path bl_down -> bl_core -> bl_hw -> bl_hwled
+// -> GPIO port:
+//
+//   rgb_set     rgb update by three bl_led() calls (three gear traversals,
+//               three pin writes)
+//   rgb_mask    rgb update by one bl_leds() call (one gear traversal, one
+//               port write for the three LEDs)
+//
+// Before the benchmark the resulting LED levels of [LED:MASK] are checked
+// against [LED:SET] (set, toggle and status LED @0 mapping).
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <string.h>
+
+  #include "bluccino.h"
+  #include "drivers/gpio/gpio_emul.h"
+
+  static const gpio_pin_t pin[5] =     // GPIO pins of LEDs @0..@4
+         {
+           DT_ALIAS(led0), DT_ALIAS(led0), DT_ALIAS(led1),
+           DT_ALIAS(led2), DT_ALIAS(led3),
+         };
+
+//==============================================================================
+// app module (ignores all messages)
+//==============================================================================
+
+  static int app(BL_ob *o, int val)
+  {
+    return 0;
+  }
+
+//==============================================================================
+// helper: LED levels as bit mask (bit i: LED @i, i = 1..4)
+//==============================================================================
+
+  static int levels(void)
+  {
+    int bits = 0;
+    for (int id=1; id <= 4; id++)
+      bits |= gpio_emul_output_get(&__device_gpio_0,pin[id]) << id;
+    return bits;
+  }
+
+//==============================================================================
+// helper: check one [LED:MASK] against the expected LED levels
+//==============================================================================
+
+  static bool check(const char *what, int mask, int bits, int expect)
+  {
+    bl_leds(mask,bits);
+    bool ok = (levels() == expect);
+    printf("%s %-22s [LED:MASK @0x%02X,%d] -> 0x%02X\n", ok ? "  " : "!!",
+           what, mask, bits, levels());
+    return ok;
+  }
+
+//==============================================================================
+// benchmark cases
+//==============================================================================
+
+  BL_BENCH(rgb_set,1000)
+  {
+    for (int i=0; i < n; i++)
+    {
+      bl_led(2,i&1);  bl_led(3,~i&1);  bl_led(4,i&1);
+    }
+  }
+
+  BL_BENCH(rgb_mask,1000)
+  {
+    for (int i=0; i < n; i++)
+      bl_leds(BL_RGB,(i&1) ? (BL_LED(2)|BL_LED(4)) : BL_LED(3));
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    BL_benchfmt fmt = BL_BENCH_TEXT;
+    if (argc > 1 && strcmp(argv[1],"csv") == 0)
+      fmt = BL_BENCH_CSV;
+    else if (argc > 1 && strcmp(argv[1],"json") == 0)
+      fmt = BL_BENCH_JSON;
+
+    bl_verbose(0);                     // no logging during benchmark
+    bl_init(bluccino,app);             // init gears and LED driver
+
+    bool ok = true;
+    ok &= check("all RGB on",BL_RGB,BL_RGB,0x1C);
+    ok &= check("green off",BL_LED(3),0,0x14);
+    ok &= check("toggle RGB",BL_RGB,-1,0x08);
+    ok &= check("status LED @0 on",BL_LED(0),BL_LED(0),0x0A);
+    ok &= check("all off",BL_LED(0)|BL_RGB,0,0x00);
+
+    bl_bench_add(&rgb_set_bench);
+    bl_bench_add(&rgb_mask_bench);
+    int n = bl_bench_run(fmt);
+
+    ok &= (n == 2);
+    if (fmt == BL_BENCH_TEXT)
+      printf("result: %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+  }
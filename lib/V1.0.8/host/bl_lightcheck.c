@@ -0,0 +1,191 @@
+//==============================================================================
+//  bl_lightcheck.c
+//  exhaustive host test of the integer lightness/temperature conversions
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_lightcheck               // default: CFG_LIGHTNESS_LUT 6, exact
+//        bl_lightcheck_lut0          // bitwise square root (no table)
+//        bl_lightcheck_lut4          // 49 entry table, exact
+//        bl_lightcheck_fast          // 193 entry table, no correction
+//
+// Checks bl_lightness.h for all 65536 inputs against the formulas of the Mesh
+// Model Specification evaluated in double precision (actual <-> linear for
+// all lightness values, level <-> CTL temperature for all levels and all
+// temperatures of several temperature ranges). The former float code of
+// state_binding.c is checked the same way for comparison, and the cost of a
+// conversion is measured for both. Exit code 1 if the integer code deviates
+// from the reference (only +/-1 LSB tolerated if CFG_LIGHTNESS_EXACT is 0).
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <stdint.h>
+  #include <math.h>
+
+  #include "bl_host.h"
+  #include "bl_lightness.h"
+
+  typedef struct STAT                  // deviation statistics
+          {
+            long count;                // number of inputs
+            long miss;                 // number of deviations
+            int max;                   // max deviation (LSB)
+          } STAT;
+
+  static volatile uint32_t sink;       // keeps benchmark loops alive
+
+//==============================================================================
+// reference formulas (double precision)
+//==============================================================================
+
+  static int ref_a2l(int a)  { return (int)ceil(65535.0 * (a/65535.0) * (a/65535.0) - 1e-9); }
+  static int ref_l2a(int l)  { return (int)floor(sqrt((double)l * 65535.0) + 1e-9); }
+
+  static int ref_lv2t(int lv, int tmin, int tmax)
+  {
+    return tmin + (int)floor((lv + 32768.0) * (tmax - tmin) / 65535.0 + 1e-9);
+  }
+
+  static int ref_t2lv(int t, int tmin, int tmax)
+  {
+    double x = (double)(t - tmin) * 65535.0 / (tmax - tmin) - 32768.0;
+    return (int)(x < 0 ? ceil(x - 1e-9) : floor(x + 1e-9));   // towards zero
+  }
+
+//==============================================================================
+// former float code of state_binding.c (libm sqrtf instead of the local
+// Newton iteration)
+//==============================================================================
+
+  static int flt_a2l(uint16_t val)
+  {
+    float tmp = ((float)val / UINT16_MAX);
+    float num = UINT16_MAX * tmp * tmp;
+    int32_t inum = (int32_t)num;
+    return (uint16_t)(num == (float)inum ? inum : inum + 1);
+  }
+
+  static int flt_l2a(uint16_t val)
+  {
+    return (uint16_t)(UINT16_MAX * sqrtf(((float)val / UINT16_MAX)));
+  }
+
+  static int flt_lv2t(int16_t level, uint16_t tmin, uint16_t tmax)
+  {
+    float diff = (float)(tmax - tmin) / UINT16_MAX;
+    uint16_t tmp = (uint16_t)((level - INT16_MIN) * diff);
+    return (uint16_t)(tmin + tmp);
+  }
+
+  static int flt_t2lv(uint16_t temp, uint16_t tmin, uint16_t tmax)
+  {
+    float tmp = (temp - tmin) * UINT16_MAX;
+    tmp = tmp / (tmax - tmin);
+    return (int16_t)(tmp + INT16_MIN);
+  }
+
+//==============================================================================
+// helper: account one result
+//==============================================================================
+
+  static void account(STAT *s, int val, int ref)
+  {
+    int dev = abs(val - ref);
+    s->count++;
+    if (dev)
+      s->miss++;
+    if (dev > s->max)
+      s->max = dev;
+  }
+
+//==============================================================================
+// helper: report a pair of statistics, return 1 if integer code failed
+//==============================================================================
+
+  static int report(const char *name, STAT *i, STAT *f)
+  {
+    int fail = CFG_LIGHTNESS_EXACT ? (i->miss != 0) : (i->max > 1);
+    printf("%-24s %7ld inputs | int: %5ld off (max %d) | float: %5ld off"
+           " (max %d)%s\n", name, i->count, i->miss, i->max, f->miss, f->max,
+           fail ? "  FAILED" : "");
+    return fail;
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(void)
+  {
+    static const uint16_t range[][2] =      // CTL temperature ranges
+    {
+      {0x0320,0x4E20},                 // TEMP_MIN .. TEMP_MAX (default)
+      {2700,6500},                     // typical tunable white
+      {0,65535},                       // full range
+      {1000,1001},                     // minimal range
+    };
+    int fail = 0;
+
+    printf("CFG_LIGHTNESS_LUT %d, CFG_LIGHTNESS_EXACT %d\n",
+           CFG_LIGHTNESS_LUT, CFG_LIGHTNESS_EXACT);
+
+    STAT i = {0}, f = {0};
+    for (int x=0; x <= 65535; x++)
+    {
+      account(&i,bl_actual2linear(x),ref_a2l(x));
+      account(&f,flt_a2l(x),ref_a2l(x));
+    }
+    fail |= report("actual -> linear",&i,&f);
+
+    i = f = (STAT){0};
+    for (int x=0; x <= 65535; x++)
+    {
+      account(&i,bl_linear2actual(x),ref_l2a(x));
+      account(&f,flt_l2a(x),ref_l2a(x));
+    }
+    fail |= report("linear -> actual",&i,&f);
+
+    for (unsigned r=0; r < sizeof(range)/sizeof(range[0]); r++)
+    {
+      int tmin = range[r][0], tmax = range[r][1];
+      char name[40];
+
+      i = f = (STAT){0};
+      for (int lv=-32768; lv <= 32767; lv++)
+      {
+        account(&i,bl_level2temp(lv,tmin,tmax),ref_lv2t(lv,tmin,tmax));
+        account(&f,flt_lv2t(lv,tmin,tmax),ref_lv2t(lv,tmin,tmax));
+      }
+      snprintf(name,sizeof(name),"level -> temp %d..%d",tmin,tmax);
+      fail |= report(name,&i,&f);
+
+      i = f = (STAT){0};
+      for (int t=tmin; t <= tmax; t++)
+      {
+        account(&i,bl_temp2level(t,tmin,tmax),ref_t2lv(t,tmin,tmax));
+        account(&f,flt_t2lv(t,tmin,tmax),ref_t2lv(t,tmin,tmax));
+      }
+      snprintf(name,sizeof(name),"temp -> level %d..%d",tmin,tmax);
+      fail |= report(name,&i,&f);
+    }
+
+      // benchmark: all 65536 lightness values, both directions
+
+    uint64_t t0 = bl_nsec();
+    for (int n=0; n < 100; n++)
+      for (int x=0; x <= 65535; x++)
+        sink += bl_linear2actual(x) + bl_actual2linear(x);
+    uint64_t t1 = bl_nsec();
+    for (int n=0; n < 100; n++)
+      for (int x=0; x <= 65535; x++)
+        sink += flt_l2a(x) + flt_a2l(x);
+    uint64_t t2 = bl_nsec();
+
+    printf("bench: int %.1f ns, float %.1f ns per actual/linear conversion pair\n",
+           (t1-t0)/6553600.0, (t2-t1)/6553600.0);
+    printf("result: %s\n", fail ? "FAILED" : "OK");
+    return fail;
+  }
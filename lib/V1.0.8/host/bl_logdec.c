@@ -0,0 +1,185 @@
+//==============================================================================
+//  bl_logdec.c
+//  host decoder for binary deferred log frames (CFG_RTL_BINARY)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_logdec <elf> [<log>]     // decode <log> (default: stdin)
+//
+//   picocom -q /dev/ttyACM0 | bl_logdec build/zephyr/zephyr.elf
+//   ./build/02-logging | bl_logdec ./build/02-logging
+//
+// Format strings and %s arguments are looked up in the ELF image of the
+// target (the same image which produced the log). A session frame carries
+// the run time address of the BL_DLOG_ANCHOR text, which gives the load
+// bias for position independent (host) executables. Bytes outside of frames
+// (e.g. printk() text) are passed through unchanged.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <stdint.h>
+  #include <string.h>
+  #include <elf.h>
+
+  #include "bl_dlog.h"
+
+//==============================================================================
+// ELF image (allocated sections with file contents)
+//==============================================================================
+
+  typedef struct SEC                   // section with file contents
+          {
+            uint64_t addr;             // virtual address
+            uint64_t size;             // section size
+            uint64_t offset;           // file offset
+          } SEC;
+
+  static uint8_t *image = NULL;        // ELF file contents
+  static long length = 0;              // ELF file length
+  static SEC sec[256];                 // allocated PROGBITS sections
+  static int nsec = 0;                 // number of sections
+  static int64_t bias = 0;             // load bias (run time - ELF address)
+
+//==============================================================================
+// helper: load ELF file and collect its allocated PROGBITS sections
+//==============================================================================
+
+  static int load(const char *path)
+  {
+    FILE *f = fopen(path,"rb");
+    if (!f)
+      return -1;
+
+    fseek(f,0,SEEK_END);
+    length = ftell(f);
+    fseek(f,0,SEEK_SET);
+    image = malloc(length+1);
+    if (!image || fread(image,1,length,f) != (size_t)length)
+    {
+      fclose(f);
+      return -1;
+    }
+    fclose(f);
+    image[length] = 0;                 // strings never run off the image
+
+    if (length < EI_NIDENT || memcmp(image,ELFMAG,SELFMAG) != 0)
+      return -1;
+
+    if (image[EI_CLASS] == ELFCLASS64)
+    {
+      Elf64_Ehdr *eh = (Elf64_Ehdr*)image;
+      Elf64_Shdr *sh = (Elf64_Shdr*)(image + eh->e_shoff);
+      for (int i=0; i < eh->e_shnum && nsec < 256; i++)
+        if ((sh[i].sh_flags & SHF_ALLOC) && sh[i].sh_type == SHT_PROGBITS)
+          sec[nsec++] = (SEC){sh[i].sh_addr,sh[i].sh_size,sh[i].sh_offset};
+    }
+    else
+    {
+      Elf32_Ehdr *eh = (Elf32_Ehdr*)image;
+      Elf32_Shdr *sh = (Elf32_Shdr*)(image + eh->e_shoff);
+      for (int i=0; i < eh->e_shnum && nsec < 256; i++)
+        if ((sh[i].sh_flags & SHF_ALLOC) && sh[i].sh_type == SHT_PROGBITS)
+          sec[nsec++] = (SEC){sh[i].sh_addr,sh[i].sh_size,sh[i].sh_offset};
+    }
+    return 0;
+  }
+
+//==============================================================================
+// helper: map target (run time) address to string in ELF image
+//==============================================================================
+
+  static const char *str(uint64_t addr)
+  {
+    uint64_t a = addr - bias;          // ELF address
+    for (int i=0; i < nsec; i++)
+      if (a >= sec[i].addr && a < sec[i].addr + sec[i].size)
+        return (const char*)image + sec[i].offset + (a - sec[i].addr);
+    return NULL;                       // not in image (e.g. RAM string)
+  }
+
+//==============================================================================
+// helper: ELF address of the anchor text
+//==============================================================================
+
+  static uint64_t anchor(void)
+  {
+    const char *text = BL_DLOG_ANCHOR;
+    int n = strlen(text) + 1;
+
+    for (int i=0; i < nsec; i++)
+      for (uint64_t k=0; k + n <= sec[i].size; k++)
+        if (memcmp(image + sec[i].offset + k,text,n) == 0)
+          return sec[i].addr + k;
+    return 0;
+  }
+
+//==============================================================================
+// helper: read n bytes (return 0 on EOF)
+//==============================================================================
+
+  static int get(FILE *in, void *p, int n)
+  {
+    return fread(p,1,n,in) == (size_t)n;
+  }
+
+//==============================================================================
+// main program: decode frames, pass through other bytes
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    if (argc < 2 || load(argv[1]))
+    {
+      fprintf(stderr,"usage: bl_logdec <elf> [<log>]\n");
+      return 1;
+    }
+
+    FILE *in = (argc > 2) ? fopen(argv[2],"rb") : stdin;
+    if (!in)
+      return 1;
+
+    uint64_t elf_anchor = anchor();
+    int ptrsize = (image[EI_CLASS] == ELFCLASS64) ? 8 : 4;
+    int c;
+
+    while ((c = fgetc(in)) != EOF)
+    {
+      uint8_t hdr[2];
+      uint64_t addr = 0;
+
+      if (c == BL_DLOG_SESSION)        // session frame: ptrsize, anchor
+      {
+        if (!get(in,hdr,1) || !get(in,&addr,hdr[0]))
+          break;
+        ptrsize = hdr[0];
+        bias = (int64_t)(addr - elf_anchor);
+      }
+      else if (c == BL_DLOG_RECORD)    // record frame: flags, words, fmt, args
+      {
+        BL_dlog r;
+        char buf[512];
+
+        if (!get(in,hdr,2) || !get(in,&addr,ptrsize))
+          break;
+        r.flags = hdr[0];
+        r.words = hdr[1] <= CFG_RTL_WORDS ? hdr[1] : CFG_RTL_WORDS;
+        if (!get(in,r.arg,r.words*4))
+          break;
+
+        r.fmt = addr ? str(addr) : NULL;
+        if (addr && !r.fmt)
+          r.fmt = "<bad format address>";
+
+        bl_dlog_format(buf,sizeof(buf),&r,ptrsize,str);
+        fputs(buf,stdout);
+      }
+      else
+        fputc(c,stdout);               // pass through (printk text)
+    }
+
+    fflush(stdout);
+    return 0;
+  }
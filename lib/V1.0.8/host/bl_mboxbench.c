@@ -0,0 +1,169 @@
+//==============================================================================
+//  bl_mboxbench.c
+//  host stress benchmark for asynchronous posting via mailboxes (bl_mbox)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_mboxbench [<producers> [<messages>]]   // default: 4 100000
+//
+// <producers> threads plus one periodic k_timer 'ISR' post sequence numbered
+// messages to the mailbox of a sink module, alternating between by-reference
+// posts (bl_post_async) and copied payloads (bl_post_copy). The main thread
+// drains the mailbox (like the bl_run() engine) and the sink module verifies
+// per producer order and payload integrity. Dropped messages (mailbox full)
+// show up as gaps in the sequence numbers and have to agree with the drop
+// statistics of the mailbox.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+  #include <pthread.h>
+  #include <sched.h>
+
+  #include "bluccino.h"
+
+  #define MAXPROD   16                 // max number of producer threads
+  #define ISR       MAXPROD            // producer index of timer 'ISR'
+  #define PING      BL_ID(_SYS,PING_)  // [SYS:PING] message ID
+
+  typedef struct PAY                   // copied payload
+          {
+            uint32_t who;              // producer index
+            uint32_t seq;              // sequence number
+            uint32_t check;            // who ^ seq
+          } PAY;
+
+  static int sink(BL_ob *o, int val);  // sink module (forward)
+  BL_MBOX(sink_mbox,sink,4096);        // 4096 byte mailbox (~160 messages)
+
+  static volatile int done = 0;        // number of finished producers
+  static int producers = 4;            // number of producer threads
+  static int messages = 100000;        // messages per producer thread
+  static uint32_t seq[MAXPROD+1];      // next sequence number per producer
+  static uint64_t ns[MAXPROD+1];       // posting time per producer
+
+  static uint32_t expect[MAXPROD+1];   // expected sequence number
+  static uint64_t got = 0, gaps = 0;   // received messages, sequence gaps
+  static int errors = 0;               // bad messages
+
+//==============================================================================
+// sink module: [SYS:PING @who,<PAY>,seq] (by reference: <data> is NULL)
+//==============================================================================
+
+  static int sink(BL_ob *o, int val)
+  {
+    const PAY *p = o->data;
+    uint32_t who = o->id, s = val;
+
+    bool ok = bl_is(o,_SYS,PING_) && who <= MAXPROD && s >= expect[who];
+    if (ok && p)
+      ok = (p->who == who && p->seq == s && p->check == (who ^ s));
+
+    if (!ok)
+      errors++;
+    else
+    {
+      gaps += s - expect[who];         // messages dropped in between
+      expect[who] = s + 1;
+      got++;
+    }
+    return 0;
+  }
+
+//==============================================================================
+// helper: post one message (even: by reference, odd: copied payload)
+//==============================================================================
+
+  static bool produce(uint32_t who)
+  {
+    uint32_t s = seq[who]++;
+    PAY pay = {who,s,who ^ s};
+    int err;
+
+    uint64_t t0 = bl_nsec();
+    if (s & 1)
+      err = bl_post_copy(&sink_mbox,PING, who,&pay,sizeof(pay),s);
+    else
+      err = bl_post_async(&sink_mbox,PING, who,NULL,s);
+    ns[who] += bl_nsec() - t0;
+    return err == 0;
+  }
+
+//==============================================================================
+// producers: threads and timer 'ISR'
+//==============================================================================
+
+  static void *thread(void *arg)
+  {
+    uint32_t who = (uint32_t)(uintptr_t)arg;
+    for (int i=0; i < messages; i++)
+      if (!produce(who))
+        sched_yield();                 // mailbox full: let the consumer run
+    __atomic_fetch_add(&done,1,__ATOMIC_RELEASE);
+    return NULL;
+  }
+
+  static void isr(struct k_timer *timer)
+  {
+    for (int i=0; i < 8; i++)          // a burst of posts per 'interrupt'
+      produce(ISR);
+  }
+
+  K_TIMER_DEFINE(tick,isr,NULL);
+
+//==============================================================================
+// main program: start producers, drain & verify
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    producers = (argc > 1) ? atoi(argv[1]) : producers;
+    messages = (argc > 2) ? atoi(argv[2]) : messages;
+    producers = (producers < 1) ? 1 : (producers > MAXPROD ? MAXPROD : producers);
+
+    pthread_t tid[MAXPROD];
+
+    uint64_t t0 = bl_nsec();
+    k_timer_start(&tick,K_MSEC(1),K_MSEC(1));
+    for (int i=0; i < producers; i++)
+      pthread_create(tid+i,NULL,thread,(void*)(uintptr_t)i);
+
+    while (__atomic_load_n(&done,__ATOMIC_ACQUIRE) < producers)
+      bl_mbox_drain();                 // single consumer (engine)
+
+    k_timer_stop(&tick);
+    while (bl_mbox_drain())            // drain what is left
+      ;
+    uint64_t t1 = bl_nsec();
+
+    for (int i=0; i < producers; i++)
+      pthread_join(tid[i],NULL);
+
+    uint64_t sent = 0, busy = 0;
+    for (int i=0; i <= MAXPROD; i++)
+    {
+      sent += seq[i];  busy += ns[i];
+      gaps += seq[i] - expect[i];      // trailing drops
+    }
+
+    int drops = bl_ring_drops(&sink_mbox.ring,false);
+    double sec = (t1-t0) / 1e9;
+
+    printf("producers:  %d threads + 1 timer ISR (%u messages)\n",
+           producers, seq[ISR]);
+    printf("messages:   %llu sent, %llu delivered, %d dropped (%llu gaps)\n",
+           (unsigned long long)sent, (unsigned long long)got, drops,
+           (unsigned long long)gaps);
+    printf("mailbox:    %u posts, %u delivered, peak %u pending\n",
+           sink_mbox.posts, sink_mbox.done, sink_mbox.peak);
+    printf("throughput: %.0f messages/s\n", got/sec);
+    printf("latency:    %.1f ns per bl_post_async/bl_post_copy\n",
+           (double)busy/sent);
+
+    bool fail = errors || gaps != (uint64_t)drops || sink_mbox.done != got;
+    printf("integrity:  %s (%d bad messages)\n", fail ? "FAILED" : "OK", errors);
+    return fail ? 1 : 0;
+  }
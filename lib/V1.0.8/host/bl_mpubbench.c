@@ -0,0 +1,133 @@
+//==============================================================================
+//  bl_mpubbench.c
+//  host benchmark for the bl_mpub message queue (array vs. timing wheel)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_mpubbench_array [<pending> [<seconds>]]  // default: 600 3
+//        bl_mpubbench_wheel [<pending> [<seconds>]]
+//
+// Like a gateway, the benchmark keeps about <pending> repeated [GOOCLI:LET]
+// messages scheduled in bl_mpub (repeat 2, interval 200 ms) and ticks the
+// module every millisecond. It reports the cost of an idle [SYS:TICK] (no
+// message due, pure queue overhead), the cost of ticks which post messages
+// (per posted message) and of the scheduling of a [GOOCLI:LET] message, and
+// checks after a drain phase that every scheduled message has been posted.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+
+  #include "bluccino.h"
+  #include "bl_mesh.h"
+  #include "bl_gonoff.h"
+  #include "bl_mpub.h"
+
+  #if (CFG_MPUB_WHEEL)
+    #define BACKEND  "timing wheel"
+  #else
+    #define BACKEND  "array"
+  #endif
+
+  #define REPEAT     2                 // 3 messages per [GOOCLI:LET]
+  #define INTERVAL   200               // repeat interval (ms)
+
+  static int delivered = 0;            // messages posted down by bl_mpub
+
+//==============================================================================
+// mesh conversion stubs (bl_mesh.c is not part of the host build)
+//==============================================================================
+
+  uint8_t bl_ms2mesh(BL_ms ms)   { return (uint8_t)(ms/100); }
+  int bl_mesh2ms(uint8_t mf)     { return mf*100; }
+  int bl_tick2ms(uint8_t ticks)  { return ticks*5; }
+
+  uint8_t bl_delay_ticks(uint8_t repeats, uint8_t i, BL_ms delay)
+  {
+    return (uint8_t)((repeats-i)*INTERVAL/5);
+  }
+
+//==============================================================================
+// down gear: count messages posted by bl_mpub (replaces weak bl_down)
+//==============================================================================
+
+  int bl_down(BL_ob *o, int val)
+  {
+    delivered++;
+    return 0;
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    int pending = (argc > 1) ? atoi(argv[1]) : 600;
+    int seconds = (argc > 2) ? atoi(argv[2]) : 3;
+
+    bl_verbose(0);                     // no logging during benchmark
+    bl_ms();                           // start clock (first call returns 0)
+    bl_sleep(10);                      // array backend: due == 0 means free
+    bl_post((bl_mpub),SYS_INIT_0_cb_0, 0,NULL,0);
+    bl_post((bl_mpub),SET_REPEAT_0_0_cnt, 0,NULL,REPEAT);
+    bl_post((bl_mpub),SET_INTERVAL_0_0_ms, 0,NULL,INTERVAL);
+
+    BL_goo goo = {.tt = 0, .delay = 0};
+    BL_pace pace = {1,0};
+    uint64_t idle_ns = 0, busy_ns = 0, post_ns = 0;
+    int ticks = 0, idle = 0, posts = 0;
+
+    BL_ms stop = bl_ms() + 1000*seconds;
+    for (BL_ms now = bl_ms(); now < stop; now = bl_ms())
+    {
+        // top up: keep <pending> messages scheduled
+
+      int scheduled = posts*(REPEAT+1) - delivered;
+      for (; scheduled + REPEAT+1 <= pending; scheduled += REPEAT+1, posts++)
+      {
+        uint64_t t0 = bl_nsec();
+        bl_post((bl_mpub),GOOCLI_LET_id_BL_goo_onoff, posts,&goo,1);
+        post_ns += bl_nsec() - t0;
+      }
+
+      pace.time = now;
+      int n = delivered;
+      uint64_t t0 = bl_nsec();
+      bl_post((bl_mpub),SYS_TICK_id_BL_pace_cnt, 0,&pace,ticks);
+      uint64_t dt = bl_nsec() - t0;
+      ticks++;
+
+      if (delivered == n)              // idle tick: pure queue overhead
+        idle_ns += dt, idle++;
+      else
+        busy_ns += dt;
+
+      bl_sleep(1);
+    }
+
+      // drain phase: all scheduled messages must be posted down
+
+    for (int i=0; i < 2*REPEAT*INTERVAL && delivered < posts*(REPEAT+1); i++)
+    {
+      pace.time = bl_ms();
+      bl_post((bl_mpub),SYS_TICK_id_BL_pace_cnt, 0,&pace,ticks);
+      bl_sleep(1);
+    }
+    bool ok = (delivered == posts*(REPEAT+1));
+
+    printf("backend:   %s (queue length %d)\n",
+           BACKEND, CFG_MPUB_QUEUE_LENGTH);
+    printf("load:      %d pending, %d [GOOCLI:LET] scheduled, %d posted down\n",
+           pending, posts, delivered);
+    printf("idle tick: %.0f ns per [SYS:TICK] w/o posting (%d ticks)\n",
+           (double)idle_ns/(idle ? idle : 1), idle);
+    printf("busy tick: %.0f ns per posted message (%d ticks)\n",
+           (double)busy_ns/(delivered ? delivered : 1), ticks-idle);
+    printf("schedule:  %.0f ns per [GOOCLI:LET] (%d repeats)\n",
+           (double)post_ns/(posts ? posts : 1), REPEAT);
+    printf("drain:     %s\n", ok ? "OK" : "FAILED (messages lost)");
+    return ok ? 0 : 1;
+  }
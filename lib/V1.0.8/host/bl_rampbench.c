@@ -0,0 +1,170 @@
+//==============================================================================
+//  bl_rampbench.c
+//  host benchmark and accuracy test for the integer transition ramps
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_rampbench [<stride>]      // default: 257 (value grid stride)
+//
+// Compares the integer ramps of transition.c (bl_ramp.h) with the former
+// float implementation (delta = (float)(current - target) / counter, stepped
+// by 'current -= delta' and snapped to the target at the end), for all pairs
+// (from,to) on a grid of the lightness range and of the delta UV range, and
+// for 1 .. 10 steps (DEVICE_SPECIFIC_RESOLUTION) as well as for long ramps.
+// Reports the max deviation from the ideal linear ramp, the max jump at the
+// final step, checks exact endpoints and monotony and measures the cost of
+// a ramp (init + steps).
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <stdint.h>
+  #include <stdbool.h>
+
+  #include "bl_host.h"
+  #include "bl_ramp.h"
+
+  typedef struct STAT                  // accuracy statistics
+          {
+            double dev;                // max deviation from ideal ramp
+            double jump;               // max excess jump at final step
+            long ramps;                // number of ramps checked
+            long errors;               // endpoint/monotony errors
+          } STAT;
+
+  static volatile int32_t sink;        // keeps benchmark loops alive
+
+//==============================================================================
+// former float implementation (transition.c, uint16_t current, int delta)
+// - returns value after step k (k = 1..steps, last step snaps to target)
+//==============================================================================
+
+  static void float_ramp(int32_t *val, int32_t from, int32_t to, int steps)
+  {
+    int delta = ((float)(from - to) / steps);   // truncated to int
+    int32_t cur = from;
+
+    for (int k=1; k < steps; k++)
+      val[k] = (cur -= delta);
+    val[steps] = to;                   // counter reached 0: snap to target
+  }
+
+//==============================================================================
+// integer ramp (bl_ramp.h), stepped like transition_work_handler()
+//==============================================================================
+
+  static void int_ramp(int32_t *val, int32_t from, int32_t to, int steps)
+  {
+    BL_ramp ramp;
+    bl_ramp_init(&ramp,from,to,steps);
+
+    for (int k=1; k < steps; k++)
+      val[k] = bl_ramp_step(&ramp);
+    val[steps] = bl_ramp_step(&ramp);  // must equal target without snapping
+  }
+
+//==============================================================================
+// helper: check one ramp against the ideal linear ramp
+//==============================================================================
+
+  static void check(STAT *s, int32_t *val, int32_t from, int32_t to,
+                    int steps, bool exact)
+  {
+    double step = (double)(to - from) / steps;
+    int32_t prev = from;
+
+    for (int k=1; k <= steps; k++)
+    {
+      double ideal = from + step*k;
+      double dev = val[k] > ideal ? val[k] - ideal : ideal - val[k];
+      if (dev > s->dev)
+        s->dev = dev;
+
+      if ((to > from && val[k] < prev) || (to < from && val[k] > prev))
+        s->errors++;                   // not monotonous
+      prev = val[k];
+    }
+
+    double jump = (double)(val[steps] - val[steps-1]) - step;
+    jump = (jump < 0) ? -jump : jump;
+    if (steps > 1 && jump > s->jump)
+      s->jump = jump;
+
+    if (exact && val[steps] != to)
+      s->errors++;                     // endpoint missed
+    s->ramps++;
+  }
+
+//==============================================================================
+// accuracy test over a value range
+//==============================================================================
+
+  static void accuracy(const char *name, int32_t lo, int32_t hi, int stride,
+                       int maxsteps)
+  {
+    static int32_t val[1024+1];
+    STAT f = {0}, i = {0};
+
+    for (int32_t from=lo; from <= hi; from += stride)
+      for (int32_t to=lo; to <= hi; to += stride)
+        for (int steps=1; steps <= maxsteps; steps = steps < 10 ? steps+1 : steps*4)
+        {
+          float_ramp(val,from,to,steps);
+          check(&f,val,from,to,steps,false);
+          int_ramp(val,from,to,steps);
+          check(&i,val,from,to,steps,true);
+        }
+
+    printf("%-9s %6ld ramps | float: dev %5.1f, jump %5.1f"
+           " | int: dev %4.2f, jump %4.2f, %ld errors\n",
+           name, i.ramps, f.dev, f.jump, i.dev, i.jump, i.errors);
+
+    if (i.errors || i.dev > 0.5 + 1e-6)
+      exit(1);
+  }
+
+//==============================================================================
+// benchmark: ns per ramp (init + <steps> steps)
+//==============================================================================
+
+  static void bench(int steps, int n)
+  {
+    static int32_t val[1024+1];
+    uint64_t t0 = bl_nsec();
+    for (int i=0; i < n; i++)
+    {
+      float_ramp(val,i & 0xFFFF,0xFFFF - (i & 0xFFFF),steps);
+      sink = val[steps/2];
+    }
+    uint64_t t1 = bl_nsec();
+    for (int i=0; i < n; i++)
+    {
+      int_ramp(val,i & 0xFFFF,0xFFFF - (i & 0xFFFF),steps);
+      sink = val[steps/2];
+    }
+    uint64_t t2 = bl_nsec();
+
+    printf("bench:     %4d steps | float: %6.1f ns/ramp | int: %6.1f ns/ramp\n",
+           steps, (double)(t1-t0)/n, (double)(t2-t1)/n);
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    int stride = (argc > 1) ? atoi(argv[1]) : 257;
+    stride = (stride < 1) ? 1 : stride;
+
+    accuracy("lightness",0,65535,stride,1024);
+    accuracy("delta UV",-32768,32767,stride,1024);
+
+    bench(10,1000000);                 // DEVICE_SPECIFIC_RESOLUTION
+    bench(1024,10000);
+
+    printf("accuracy: OK (integer ramps exact at endpoints, |dev| <= 0.5)\n");
+    return 0;
+  }
@@ -0,0 +1,193 @@
+//==============================================================================
+//  bl_recbench.c
+//  host test and benchmark of the message flow recorder/replayer (bl_rec)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_recbench [<messages> [<file>]]   // default: 1000000, temp file
+//
+// A recorder is spliced between up gear and top gear (bl_up -> rec -> bl_top)
+// and records a mix of [BUTTON:PRESS], [GOOCLI:SET <BL_goo>] and [NVM:SAVE
+// <BL_dac>] messages to a file and to its RAM ring. The file is then replayed
+// into the app at full speed, and the beginning of the trace once more at the
+// original pacing. The app computes a checksum over all message fields and
+// payloads, which has to be the same for original and replayed messages.
+// Some BL_dac payloads are bigger than CFG_REC_PAYLOAD, their replayed size
+// must not exceed the recorded bytes.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+
+  #include "bluccino.h"
+  #include "bl_gonoff.h"
+
+  BL_RECORDER(rec,65536);              // recorder module rec() with 64k ring
+
+  static uint64_t sum = 0;             // message checksum
+  static long count = 0;               // messages received by app
+  static size_t dac_max = 0;           // max BL_dac size received by app
+
+//==============================================================================
+// helper: stream writer (file)
+//==============================================================================
+
+  static void writer(void *ctx, const void *data, int len)
+  {
+    fwrite(data,1,len,(FILE*)ctx);
+  }
+
+//==============================================================================
+// helper: time stamp of a record (stream format, see bl_rec.h)
+//==============================================================================
+
+  static uint32_t stamp(const uint8_t *p)
+  {
+    return p[14] | p[15] << 8 | p[16] << 16 | (uint32_t)p[17] << 24;
+  }
+
+//==============================================================================
+// app module: checksum over message fields and payload
+//==============================================================================
+
+  static uint64_t mix(uint64_t h, uint64_t x)
+  {
+    return (h ^ x) * 0x100000001B3ull;
+  }
+
+  static int app(BL_ob *o, int val)
+  {
+    if (o->cl == _SYS)
+      return 0;
+
+    uint64_t h = mix(mix(mix(mix(sum,o->cl),o->op),o->id),(uint32_t)val);
+
+    if (bl_is(o,_GOOCLI,SET_))
+    {
+      const BL_goo *g = o->data;
+      h = mix(mix(mix(mix(h,g->trans.target),g->trans.begin),g->tt),g->tid);
+      h = mix(mix(h,g->delay),g->remain);
+    }
+    else if (bl_is(o,_NVM,SAVE_))
+    {
+      const BL_dac *d = o->data;
+      size_t n = d->size < CFG_REC_PAYLOAD ? d->size : CFG_REC_PAYLOAD;
+      for (const char *k = d->key; *k; k++)
+        h = mix(h,*k);
+      for (size_t i=0; i < n; i++)     // recorded (leading) bytes only
+        h = mix(h,((uint8_t*)d->data)[i]);
+      dac_max = d->size > dac_max ? d->size : dac_max;
+    }
+
+    sum = h;
+    count++;
+    return 0;
+  }
+
+//==============================================================================
+// helper: post message #i of the mix to up gear
+//==============================================================================
+
+  static void post(long i)
+  {
+    static uint8_t bytes[CFG_REC_PAYLOAD+36];
+    BL_goo goo = {{(int)i & 1,0,i*10,100},5,100,(BL_byte)i,(int)i % 7};
+    BL_dac dac = {"cfg",bytes,(i % 9 == 2) ? sizeof(bytes) : (i % 3)*5};
+    memset(bytes,(int)i,sizeof(bytes));
+
+    switch (i % 3)
+    {
+      case 0:  _bl_post(bl_up,BUTTON_PRESS_id_0_0, i%4+1,NULL,1);  break;
+      case 1:  _bl_post(bl_up,GOOCLI_SET_id_BL_goo_onoff, 1,&goo,i&1); break;
+      default: _bl_post(bl_up,NVM_SAVE_0_BL_dac_0, 0,&dac,0);        break;
+    }
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    long n = (argc > 1) ? atol(argv[1]) : 1000000;
+    const char *path = (argc > 2) ? argv[2] : "<tmpfile>";
+
+    bl_verbose(0);                     // no logging during benchmark
+    bl_init(bluccino,app);             // init gears, output to app
+    bl_init(rec,bl_top);               // splice recorder:
+    bl_init(bl_up,rec);                // bl_up -> rec -> bl_top -> app
+
+      // record to file (and RAM ring)
+
+    FILE *f = (argc > 2) ? fopen(path,"w+b") : tmpfile();
+    if (!f)
+      return (perror(path), 1);
+    rec_rec.write = writer;  rec_rec.ctx = f;
+
+    uint64_t t0 = bl_nsec();
+    for (long i=0; i < n; i++)
+      post(i);
+    uint64_t t1 = bl_nsec();
+
+    uint64_t sum0 = sum;  long count0 = count;
+    long bytes = 0;
+
+      // load file and replay at full speed
+
+    fseek(f,0,SEEK_END);  bytes = ftell(f);  rewind(f);
+    uint8_t *buf = malloc(bytes);
+    if (!buf || fread(buf,1,bytes,f) != (size_t)bytes)
+      return (perror(path), 1);
+    fclose(f);                         // (a tmpfile() is deleted)
+
+    sum = count = 0;  dac_max = 0;
+    uint64_t t2 = bl_nsec();
+    int replayed = bl_replay(buf,bytes,app,false);
+    uint64_t t3 = bl_nsec();
+    bool ok = (replayed == n && count == count0 && sum == sum0);
+    ok = ok && dac_max <= CFG_REC_PAYLOAD;   // replayed size <= recorded
+    ok = ok && rec_rec.records + rec_rec.ring->drops == (uint32_t)n;
+
+      // RAM ring holds records of the trace in order (others dropped, a
+      // big record may be dropped while smaller ones still fit)
+
+    static uint8_t ring[65536];
+    int len = bl_rec_read(&rec_rec,ring,sizeof(ring));
+    ok = ok && len > 0;
+    for (long a=0, b=0; ok && a < len; b += buf[b])
+    {
+      if (b >= bytes)
+      {
+        ok = false;                    // ring record not found in file
+        break;
+      }
+      if (ring[a] == buf[b] && memcmp(ring+a,buf+b,buf[b]) == 0)
+        a += ring[a];                  // next ring record
+    }
+
+      // paced replay of the first 2000 messages (original pacing)
+
+    int m = 0, plen = 0, at = 0;
+    for (; plen < bytes && m < 2000; m++)
+      plen += buf[at = plen];          // at: offset of last record
+    uint32_t span = stamp(buf+at) - stamp(buf);
+
+    uint64_t t4 = bl_nsec();
+    bl_replay(buf,plen,app,true);
+    uint64_t t5 = bl_nsec();
+
+    printf("record:  %ld messages, %.1f ns/message, %.1f bytes/message"
+           " (%ld bytes file, %d bytes RAM ring)\n",
+           n, (double)(t1-t0)/n, (double)bytes/n, bytes, len);
+    printf("replay:  %d messages, %.1f ns/message (%.1f M messages/s)\n",
+           replayed, (double)(t3-t2)/n, n*1e3/(t3-t2));
+    printf("paced:   %d messages in %.2f ms (recorded: %.2f ms)\n",
+           m, (t5-t4)/1e6, span/1e3);
+    printf("result:  %s\n", ok ? "OK (replayed checksum matches)" : "FAILED");
+
+    free(buf);
+    return ok ? 0 : 1;
+  }
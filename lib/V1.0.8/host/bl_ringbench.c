@@ -0,0 +1,167 @@
+//==============================================================================
+//  bl_ringbench.c
+//  host stress benchmark for the lock-free MPSC record ring (bl_ring)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_ringbench [<producers> [<records>]]    // default: 4 100000
+//
+// <producers> threads (work queues, main loop) plus one periodic k_timer
+// 'ISR' write sequence numbered records of variable length into one ring,
+// while a single consumer verifies per producer order and payload integrity.
+// A producer yields after a drop, so the ring runs mostly full and wraps
+// around many times. Dropped records (ring full) are counted by the ring and
+// show up as gaps in the sequence numbers; both numbers have to agree.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+  #include <pthread.h>
+  #include <sched.h>
+
+  #include "bl_host.h"
+  #include "bl_ring.h"
+
+  #define MAXPROD   16                 // max number of producer threads
+  #define ISR       MAXPROD            // producer index of timer 'ISR'
+
+  typedef struct REC                   // record header (payload follows)
+          {
+            uint32_t who;              // producer index
+            uint32_t seq;              // sequence number
+            uint32_t len;              // payload length
+          } REC;
+
+  BL_RING(ring,4096);                  // same size as the RTL log ring
+
+  static volatile int done = 0;        // number of finished producers
+  static int producers = 4;            // number of producer threads
+  static int records = 100000;         // records per producer thread
+  static uint32_t seq[MAXPROD+1];      // next sequence number per producer
+  static uint64_t ns[MAXPROD+1];       // reserve/commit time per producer
+
+//==============================================================================
+// helper: produce one record (payload bytes are derived from who & seq)
+//==============================================================================
+
+  static bool produce(uint32_t who)
+  {
+    uint32_t s = seq[who]++;
+    uint32_t len = sizeof(REC) + (s*7 + who) % 120;     // 12 .. 131 bytes
+
+    uint64_t t0 = bl_nsec();
+    uint8_t *p = bl_ring_reserve(&ring,len);
+    if (p)
+    {
+      REC r = {who,s,len};
+      memcpy(p,&r,sizeof(r));
+      for (uint32_t i=sizeof(r); i < len; i++)
+        p[i] = (uint8_t)(who + s + i);
+      bl_ring_commit(&ring,p);
+    }
+    ns[who] += bl_nsec() - t0;
+    return p != NULL;
+  }
+
+//==============================================================================
+// producers: threads and timer 'ISR'
+//==============================================================================
+
+  static void *thread(void *arg)
+  {
+    uint32_t who = (uint32_t)(uintptr_t)arg;
+    for (int i=0; i < records; i++)
+      if (!produce(who))
+        sched_yield();                 // ring full: let the consumer run
+    __atomic_fetch_add(&done,1,__ATOMIC_RELEASE);
+    return NULL;
+  }
+
+  static void isr(struct k_timer *timer)
+  {
+    for (int i=0; i < 8; i++)          // a burst of records per 'interrupt'
+      produce(ISR);
+  }
+
+  K_TIMER_DEFINE(tick,isr,NULL);
+
+//==============================================================================
+// main program: start producers, consume & verify
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    producers = (argc > 1) ? atoi(argv[1]) : producers;
+    records = (argc > 2) ? atoi(argv[2]) : records;
+    producers = (producers < 1) ? 1 : (producers > MAXPROD ? MAXPROD : producers);
+
+    uint32_t expect[MAXPROD+1] = {0};  // expected sequence number
+    uint64_t got = 0, gaps = 0, bytes = 0;
+    int errors = 0;
+    pthread_t tid[MAXPROD];
+
+    uint64_t t0 = bl_nsec();
+    k_timer_start(&tick,K_MSEC(1),K_MSEC(1));
+    for (int i=0; i < producers; i++)
+      pthread_create(tid+i,NULL,thread,(void*)(uintptr_t)i);
+
+    for (;;)                           // single consumer
+    {
+      int len;
+      uint8_t *p = bl_ring_peek(&ring,&len);
+      if (!p)
+      {
+        if (__atomic_load_n(&done,__ATOMIC_ACQUIRE) < producers)
+          continue;
+        k_timer_stop(&tick);           // drain what is left
+        if (!(p = bl_ring_peek(&ring,&len)))
+          break;
+      }
+
+      REC r;
+      memcpy(&r,p,sizeof(r));
+      bool ok = (r.who <= MAXPROD && r.len == (uint32_t)len && r.seq >= expect[r.who]);
+      for (uint32_t i=sizeof(r); ok && i < r.len; i++)
+        ok = (p[i] == (uint8_t)(r.who + r.seq + i));
+
+      if (!ok)
+        errors++;
+      else
+      {
+        gaps += r.seq - expect[r.who];     // records dropped in between
+        expect[r.who] = r.seq + 1;
+        bytes += len;
+        got++;
+      }
+      bl_ring_free(&ring);
+    }
+    uint64_t t1 = bl_nsec();
+
+    for (int i=0; i < producers; i++)
+      pthread_join(tid[i],NULL);
+
+    uint64_t sent = 0, busy = 0;
+    for (int i=0; i <= MAXPROD; i++)
+    {
+      sent += seq[i];  busy += ns[i];
+      gaps += seq[i] - expect[i];          // trailing drops
+    }
+
+    int drops = bl_ring_drops(&ring,true);
+    double sec = (t1-t0) / 1e9;
+
+    printf("producers:  %d threads + 1 timer ISR (%u records)\n",
+           producers, seq[ISR]);
+    printf("records:    %llu sent, %llu received, %d dropped (%llu gaps)\n",
+           (unsigned long long)sent, (unsigned long long)got, drops,
+           (unsigned long long)gaps);
+    printf("throughput: %.0f records/s, %.1f MB/s\n", got/sec, bytes/sec/1e6);
+    printf("latency:    %.1f ns per reserve/commit\n", (double)busy/sent);
+    printf("integrity:  %s (%d bad records)\n",
+           errors || gaps != (uint64_t)drops ? "FAILED" : "OK", errors);
+
+    return (errors || gaps != (uint64_t)drops) ? 1 : 0;
+  }
@@ -0,0 +1,130 @@
+//==============================================================================
+//  bl_routebench.c
+//  host test and benchmark for the publish/subscribe router (bl_route)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_routebench [<messages>]   // default: 10000000
+//
+// Eight listener modules with a typical switch(bl_id(o)) interface get a mix
+// of [BUTTON:], [SWITCH:], [LED:] and [NVM:] messages, once by a hand made
+// chain of bl_fwd() calls to all listeners (the current fan-out idiom) and
+// once via a router where each listener subscribed only to what it handles.
+// Both ways have to produce the same number of handled messages per listener;
+// the router additionally saves the calls of the not interested listeners.
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+
+  #include "bluccino.h"
+
+  #define LISTENERS  8
+
+  static long handled[2][LISTENERS];   // handled messages per listener
+  static int pass = 0;                 // 0: chained bl_fwd, 1: router
+
+//==============================================================================
+// listener modules (listener k handles what its switch lists)
+//==============================================================================
+
+  static int listener(int k, BL_ob *o, int val)
+  {
+    switch (bl_id(o))
+    {
+      case BUTTON_PRESS_id_0_0:
+      case BUTTON_RELEASE_id_0_ms:
+        if (k < 2)
+          return handled[pass][k]++, 0;     // listeners 0,1: press/release
+        return 0;
+
+      case BUTTON_CLICK_id_0_cnt:
+        if (k == 2)
+          return handled[pass][k]++, 0;     // listener 2: clicks
+        return 0;
+
+      case SWITCH_STS_id_0_sts:
+        if (k == 3)
+          return handled[pass][k]++, 0;     // listener 3: switch status
+        return 0;
+
+      case _NVM_READY_0_0_sts:
+      case NVM_READY_0_0_sts:
+        if (k == 4)
+          return handled[pass][k]++, 0;     // listener 4: NVM ready
+        return 0;
+
+      default:
+        return 0;                           // listeners 5..7: timers etc.
+    }
+  }
+
+  static int l0(BL_ob *o, int val) { return listener(0,o,val); }
+  static int l1(BL_ob *o, int val) { return listener(1,o,val); }
+  static int l2(BL_ob *o, int val) { return listener(2,o,val); }
+  static int l3(BL_ob *o, int val) { return listener(3,o,val); }
+  static int l4(BL_ob *o, int val) { return listener(4,o,val); }
+  static int l5(BL_ob *o, int val) { return listener(5,o,val); }
+  static int l6(BL_ob *o, int val) { return listener(6,o,val); }
+  static int l7(BL_ob *o, int val) { return listener(7,o,val); }
+
+  static BL_oval L[LISTENERS] = {l0,l1,l2,l3,l4,l5,l6,l7};
+
+//==============================================================================
+// fan-out by chained bl_fwd() calls
+//==============================================================================
+
+  static int chain(BL_ob *o, int val)
+  {
+    for (int k=0; k < LISTENERS; k++)
+      bl_fwd(o,val,L[k]);
+    return 0;
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    static BL_ob msg[] =
+    {
+      {_BUTTON,PRESS_,1,NULL},  {_BUTTON,RELEASE_,1,NULL},
+      {_BUTTON,CLICK_,1,NULL},  {_SWITCH,STS_,1,NULL},
+      {_LED,SET_,1,NULL},       {BL_AUG(_NVM),READY_,0,NULL},
+    };
+    long n = (argc > 1) ? atol(argv[1]) : 10000000;
+    int nmsg = BL_LEN(msg);
+
+    BL_ROUTER(router);
+    bl_subscribe(&router,l0,_BUTTON,BL_OPBIT(PRESS_)|BL_OPBIT(RELEASE_));
+    bl_subscribe(&router,l1,_BUTTON,BL_OPBIT(PRESS_)|BL_OPBIT(RELEASE_));
+    bl_subscribe(&router,l2,_BUTTON,BL_OPBIT(CLICK_));
+    bl_subscribe(&router,l3,_SWITCH,0);
+    bl_subscribe(&router,l4,_NVM,0);
+    bl_subscribe(&router,l5,_TIMER,0);
+
+    uint64_t t0 = bl_nsec();
+    for (long i=0; i < n; i++)
+      chain(msg + i%nmsg,0);
+    uint64_t t1 = bl_nsec();
+
+    pass = 1;
+    long deliveries = 0;
+    for (long i=0; i < n; i++)
+      deliveries += bl_route(&router,msg + i%nmsg,0);
+    uint64_t t2 = bl_nsec();
+
+    int fail = 0;
+    for (int k=0; k < LISTENERS; k++)
+      fail |= (handled[0][k] != handled[1][k]);
+
+    printf("chained bl_fwd: %5.1f ns/message (%d calls per message)\n",
+           (double)(t1-t0)/n, LISTENERS);
+    printf("bl_route:       %5.1f ns/message (%.2f calls per message)\n",
+           (double)(t2-t1)/n, (double)deliveries/n);
+    printf("result: %s\n", fail ? "FAILED (handled counts differ)" : "OK");
+    return fail;
+  }
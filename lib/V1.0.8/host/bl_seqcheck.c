@@ -0,0 +1,156 @@
+//==============================================================================
+//  bl_seqcheck.c
+//  host test of the LED pattern sequencer (bl_seq) in virtual time
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_seqcheck                  // runs in virtual time (deterministic)
+//
+// Blink patterns are started by [LED:SEQ] messages with bl_sleep() pauses in
+// between. The [LED:MASK] messages output by the sequencer (timer driven, no
+// ticks) are recorded with their time stamps and compared against the
+// expected LED changes:
+//
+//   SOS pattern on LED @1 (MARK/LOOP steps, AGAIN)
+//   RGB LEDs @2,@3,@4 started in a row (lock step, one [LED:MASK] per edge)
+//   stop of a running pattern (no more output)
+//   dimmed step (soft PWM duty) followed by END
+//
+//==============================================================================
+
+  #include <stdio.h>
+
+  #include "bluccino.h"
+  #include "bl_hw.h"
+
+  typedef struct Change { int ms; int mask; int bits; } Change;
+
+  static Change got[128];              // recorded LED changes
+  static int n = 0;
+  static BL_ms t0 = 0;                 // start time of current check
+
+  static const BL_seq sos[] =
+         {
+           BL_SEQ_MARK, BL_SEQ_ON(200), BL_SEQ_OFF(200), BL_SEQ_LOOP(3),
+           BL_SEQ_MARK, BL_SEQ_ON(600), BL_SEQ_OFF(200), BL_SEQ_LOOP(3),
+           BL_SEQ_MARK, BL_SEQ_ON(200), BL_SEQ_OFF(200), BL_SEQ_LOOP(3),
+           BL_SEQ_OFF(1200), BL_SEQ_AGAIN,
+         };
+
+  static const BL_seq blink[] =
+         {
+           BL_SEQ_ON(300), BL_SEQ_OFF(300), BL_SEQ_AGAIN,
+         };
+
+  static const BL_seq dim[] =
+         {
+           BL_SEQ_DIM(8,160), BL_SEQ_OFF(100), BL_SEQ_END,
+         };
+
+  static const Change expect_sos[] =
+         {
+           {0,2,2},    {200,2,0},  {400,2,2},  {600,2,0},  {800,2,2},
+           {1000,2,0}, {1200,2,2}, {1800,2,0}, {2000,2,2}, {2600,2,0},
+           {2800,2,2}, {3400,2,0}, {3600,2,2}, {3800,2,0}, {4000,2,2},
+           {4200,2,0}, {4400,2,2}, {4600,2,0}, {6000,2,2},
+         };
+
+  static const Change expect_rgb[] =
+         {
+           {0,0x1C,0x1C}, {300,0x1C,0}, {600,0x1C,0x1C}, {900,0x1C,0},
+         };
+
+//==============================================================================
+// sequencer output: record [LED:MASK @mask,bits] with time stamp
+//==============================================================================
+
+  static int out(BL_ob *o, int val)
+  {
+    if (bl_id(o) == LED_MASK_mask_0_bits && n < (int)BL_LENGTH(got))
+      got[n++] = (Change){(int)(bl_ms() - t0),o->id,val};
+    return 0;
+  }
+
+//==============================================================================
+// helper: start/stop pattern on LED @id
+//==============================================================================
+
+  static void seq(int id, const BL_seq *pattern)
+  {
+    BL_ob oo = {_LED,SEQ_,id,pattern};
+    bl_seq(&oo,0);
+  }
+
+//==============================================================================
+// helper: begin a check (reset recorder)
+//==============================================================================
+
+  static void begin(const char *what)
+  {
+    printf("%s\n",what);
+    n = 0;
+    t0 = bl_ms();
+  }
+
+//==============================================================================
+// helper: compare recorded LED changes with expected changes
+//==============================================================================
+
+  static bool check(const Change *expect, int len)
+  {
+    bool ok = (n == len);
+    for (int i=0; i < n; i++)
+    {
+      bool match = i < len && got[i].ms == expect[i].ms &&
+                   got[i].mask == expect[i].mask &&
+                   got[i].bits == expect[i].bits;
+      ok = ok && match;
+      printf("%s %5d ms [LED:MASK @0x%02X,0x%02X]\n", match ? "  " : "!!",
+             got[i].ms,got[i].mask,got[i].bits);
+    }
+    return ok;
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(void)
+  {
+    bool ok = true;
+
+    bl_host_virtual(600*1000000LL);    // deterministic virtual time
+    bl_verbose(1);                     // no sequencer logging
+    bl_init(bl_seq,out);               // record sequencer output
+
+    begin("SOS on LED @1:");
+    seq(1,sos);
+    bl_sleep(6100);
+    seq(1,NULL);
+    ok &= check(expect_sos,BL_LENGTH(expect_sos));
+
+    begin("lock step of RGB LEDs, stop:");
+    seq(2,blink);  seq(3,blink);  seq(4,blink);
+    bl_sleep(1000);
+    seq(2,NULL);  seq(3,NULL);  seq(4,NULL);
+    bl_sleep(1000);
+    ok &= check(expect_rgb,BL_LENGTH(expect_rgb));
+
+    begin("dimmed LED @0 (level 8/32):");
+    seq(0,dim);
+    bl_sleep(1000);
+
+    int on = 0;                        // on time of dimmed step
+    for (int i=0; i < n; i++)
+      if (got[i].bits)
+        on += (i+1 < n ? got[i+1].ms : 160) - got[i].ms;
+
+    bool pwm = (n == 2*160/CFG_SEQ_PWM && on == 160*8/32 &&
+                got[n-1].ms < 160 && got[n-1].bits == 0);
+    printf("%s %d edges, on time %d ms of 160 ms\n", pwm ? "  " : "!!", n, on);
+    ok &= pwm;
+
+    printf("result: %s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+  }
@@ -0,0 +1,124 @@
+//==============================================================================
+//  bl_stormbench.c
+//  host test and benchmark of RTL log storm protection (folding, rate limit)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// usage: bl_stormbench [<lines>]      // default: 20000 lines per storm
+//
+// The core is built with real time logging (CFG_BLUCCINO_RTL) and the log
+// output (stdout) is captured in a temporary file while three storms run:
+//
+//   repeat   <lines> identical LOG_MESH() lines (e.g. ISR reporting the
+//            same condition), every 1000th line interleaved with bl_err()
+//   flood    <lines>/4 distinct LOG_GEAR() lines, every 500th with bl_err()
+//   quiet    a single LOG_APP() line right after the flood
+//
+// Afterwards the captured lines are classified. All error lines and the
+// quiet line have to make it to the output. The raw variant (built with
+// CFG_RTL_FOLD=0 and CFG_RTL_RATE=0) shows the behaviour without protection
+// (log ring overflow, errors delayed or lost when the priority lane fills).
+//
+//==============================================================================
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+  #include <unistd.h>
+
+  #include "bluccino.h"
+
+//==============================================================================
+// app module (ignores all messages)
+//==============================================================================
+
+  static int app(BL_ob *o, int val)
+  {
+    return 0;
+  }
+
+//==============================================================================
+// helper: count captured lines containing a pattern
+//==============================================================================
+
+  static long lines(FILE *f, const char *pattern)
+  {
+    char buf[512];
+    long n = 0;
+
+    rewind(f);
+    while (fgets(buf,sizeof(buf),f))
+      n += (strstr(buf,pattern) != NULL);
+    return n;
+  }
+
+//==============================================================================
+// main program
+//==============================================================================
+
+  int main(int argc, char **argv)
+  {
+    long n = (argc > 1) ? atol(argv[1]) : 20000;
+    long errors = 0;
+
+    FILE *f = tmpfile();               // capture log output
+    if (!f)
+      return (perror("tmpfile"), 1);
+
+    fflush(stdout);
+    int saved = dup(1);
+    dup2(fileno(f),1);
+
+    bl_verbose(4);
+    bl_init(bluccino,app);
+
+    uint64_t t0 = bl_nsec();
+    for (long i=0; i < n; i++)         // repeat storm
+    {
+      LOG_MESH(1,"storm: link lost");
+      if (i % 1000 == 0)
+        errors++, bl_err(-1,"storm: repeat");
+    }
+
+    for (long i=0; i < n/4; i++)       // flood storm
+    {
+      LOG_GEAR(1,"flood: %ld",i);
+      if (i % 500 == 0)
+        errors++, bl_err(-2,"storm: flood");
+    }
+
+    LOG_APP(1,"quiet: still alive");   // other area, not limited
+    uint64_t t1 = bl_nsec();
+
+    bl_sleep(200);                     // let work horse drain the log rings
+    fflush(stdout);
+    dup2(saved,1);  close(saved);
+
+    long err = lines(f,"error -");
+    long repeat = lines(f,"storm: link lost");
+    long flood = lines(f,"flood: ");
+    long quiet = lines(f,"quiet: still alive");
+    long folds = lines(f,"repeated");
+    long limit = lines(f,"suppressed");
+    long drops = lines(f,"dropped");
+    fclose(f);
+
+    #if (CFG_RTL_FOLD || CFG_RTL_RATE > 0)
+      bool ok = (err == errors) && (quiet == 1);
+    #else
+      bool ok = true;                  // raw: no expectations, just report
+    #endif
+
+    printf("storm:   %ld lines in %.1f ns/line (producer)\n",
+           n + n/4 + errors + 1, (double)(t1-t0)/(n + n/4 + errors + 1));
+    printf("repeat:  %ld of %ld lines printed, %ld fold notes\n",
+           repeat, n, folds);
+    printf("flood:   %ld of %ld lines printed, %ld rate limit notes\n",
+           flood, n/4, limit);
+    printf("errors:  %ld of %ld printed, quiet line %s, %ld drop notes\n",
+           err, errors, quiet ? "printed" : "lost", drops);
+    printf("result:  %s\n", !ok ? "FAILED" : (err == errors && quiet == 1)
+           ? "OK (all errors printed)" : "OK (raw, lines lost)");
+    return ok ? 0 : 1;
+  }
@@ -0,0 +1,49 @@
+//==============================================================================
+//  bluetooth/mesh.h
+//  host (POSIX) shim of the Zephyr Bluetooth mesh header
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Provides just what bl_mesh.h and bl_gonoff.h need at compile time, so that
+// mesh related modules (e.g. module/bl_mpub.c) can be built and benchmarked
+// on the host. There is no mesh stack behind it.
+//
+//==============================================================================
+
+#ifndef __HOST_BLUETOOTH_MESH_H__
+#define __HOST_BLUETOOTH_MESH_H__
+
+  #include <stdint.h>
+
+  #define BT_MESH_ADDR_UNASSIGNED          0x0000
+  #define BT_MESH_KEY_UNUSED               0xffff
+
+  #define BT_MESH_MODEL_ID_GEN_ONOFF_SRV   0x1000
+  #define BT_MESH_MODEL_ID_GEN_ONOFF_CLI   0x1001
+
+  #define BT_MESH_MODEL_OP_1(b0)           (b0)
+  #define BT_MESH_MODEL_OP_2(b0,b1)        (((b0) << 8) | (b1))
+
+  struct net_buf_simple                // just the fields used by bl_mesh.h
+         {
+           uint8_t *data;
+           uint16_t len;
+           uint16_t size;
+           uint8_t *__buf;
+         };
+
+  struct bt_mesh_model;
+
+  struct bt_mesh_model_pub             // just the fields used by bl_mesh.h
+         {
+           int (*update)(struct bt_mesh_model *mod);
+           struct net_buf_simple *msg;
+         };
+
+  struct bt_mesh_msg_ctx;              // opaque on the host
+  struct bt_mesh_model_op;
+  struct bt_mesh_elem;
+  struct bt_mesh_comp;
+
+#endif // __HOST_BLUETOOTH_MESH_H__
@@ -0,0 +1,27 @@
+//==============================================================================
+//  device.h
+//  host (POSIX) shim of the Zephyr device model header
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// The only devices on the host are the emulated GPIO ports (bl_gpioemu.c).
+//
+//==============================================================================
+
+#ifndef __HOST_DEVICE_H__
+#define __HOST_DEVICE_H__
+
+  #include <stdbool.h>
+  #include "devicetree.h"
+
+  struct device                        // device instance
+         {
+           const char *name;           // device name (devicetree label)
+           void *data;                 // driver data
+         };
+
+  const struct device *device_get_binding(const char *name);  // NULL: none
+  bool device_is_ready(const struct device *dev);
+
+#endif // __HOST_DEVICE_H__
@@ -0,0 +1,35 @@
+//==============================================================================
+//  devicetree.h
+//  host (POSIX) shim of the Zephyr devicetree header (emulated board)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// The emulated board has one GPIO port "GPIO_0" (see drivers/gpio.h) with
+// the button and LED pins of the nRF52840 DK, so drivers which bind to the
+// devicetree aliases sw0..sw3 and led0..led3 build unchanged. A node is
+// represented by its pin number and all pins are active high.
+//
+//   alias:  sw0  sw1  sw2  sw3  led0 led1 led2 led3
+//   pin:    11   12   24   25   13   14   15   16
+//
+//==============================================================================
+
+#ifndef __HOST_DEVICETREE_H__
+#define __HOST_DEVICETREE_H__
+
+  #define DT_N_ALIAS_sw0                 11
+  #define DT_N_ALIAS_sw1                 12
+  #define DT_N_ALIAS_sw2                 24
+  #define DT_N_ALIAS_sw3                 25
+  #define DT_N_ALIAS_led0                13
+  #define DT_N_ALIAS_led1                14
+  #define DT_N_ALIAS_led2                15
+  #define DT_N_ALIAS_led3                16
+
+  #define DT_ALIAS(alias)                DT_N_ALIAS_##alias
+  #define DT_GPIO_LABEL(node,prop)       "GPIO_0"
+  #define DT_GPIO_PIN(node,prop)         (node)
+  #define DT_GPIO_FLAGS(node,prop)       0
+
+#endif // __HOST_DEVICETREE_H__
@@ -0,0 +1,169 @@
+//==============================================================================
+//  drivers/gpio.h
+//  host (POSIX) shim of the Zephyr GPIO driver API (emulated GPIO port)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Provides the subset of the Zephyr GPIO API which is used by the Bluccino
+// drivers (bl_gpio.h, hwstd/bl_hwbut.c, hwstd/bl_hwled.c), backed by one
+// emulated 32 pin port "GPIO_0" (bl_gpioemu.c). Input levels are driven by
+// the emulator API (drivers/gpio/gpio_emul.h) or by a time stamped input
+// script, interrupt callbacks are called in 'ISR' context (CPU lock held).
+//
+//==============================================================================
+
+#ifndef __HOST_DRIVERS_GPIO_H__
+#define __HOST_DRIVERS_GPIO_H__
+
+  #include <stdint.h>
+  #include <stddef.h>
+
+  #include "device.h"
+  #include "sys/util.h"
+
+//==============================================================================
+// types
+//==============================================================================
+
+  typedef uint8_t  gpio_pin_t;         // pin number (0..31)
+  typedef uint16_t gpio_dt_flags_t;    // devicetree flags of a pin
+  typedef uint32_t gpio_flags_t;       // configuration flags
+  typedef uint32_t gpio_port_pins_t;   // pin mask
+  typedef uint32_t gpio_port_value_t;  // port value
+
+//==============================================================================
+// configuration flags (same values as Zephyr)
+//==============================================================================
+
+  #define GPIO_ACTIVE_HIGH         (0)
+  #define GPIO_ACTIVE_LOW          (1U << 0)
+  #define GPIO_PULL_UP             (1U << 4)
+  #define GPIO_PULL_DOWN           (1U << 5)
+
+  #define GPIO_INPUT               (1U << 8)
+  #define GPIO_OUTPUT              (1U << 9)
+  #define GPIO_OUTPUT_INIT_LOW     (1U << 10)
+  #define GPIO_OUTPUT_INIT_HIGH    (1U << 11)
+  #define GPIO_OUTPUT_INIT_LOGICAL (1U << 12)
+
+  #define GPIO_OUTPUT_LOW          (GPIO_OUTPUT | GPIO_OUTPUT_INIT_LOW)
+  #define GPIO_OUTPUT_HIGH         (GPIO_OUTPUT | GPIO_OUTPUT_INIT_HIGH)
+  #define GPIO_OUTPUT_INACTIVE     (GPIO_OUTPUT | GPIO_OUTPUT_INIT_LOW  | \
+                                    GPIO_OUTPUT_INIT_LOGICAL)
+  #define GPIO_OUTPUT_ACTIVE       (GPIO_OUTPUT | GPIO_OUTPUT_INIT_HIGH | \
+                                    GPIO_OUTPUT_INIT_LOGICAL)
+
+  #define GPIO_INT_DISABLE         (1U << 13)
+  #define GPIO_INT_ENABLE          (1U << 14)
+  #define GPIO_INT_LEVELS_LOGICAL  (1U << 15)
+  #define GPIO_INT_EDGE            (1U << 16)
+  #define GPIO_INT_LOW_0           (1U << 17)
+  #define GPIO_INT_HIGH_1          (1U << 18)
+  #define GPIO_INT_DEBOUNCE        (1U << 19)  // ignored by the emulator
+
+  #define GPIO_INT_EDGE_RISING     (GPIO_INT_ENABLE | GPIO_INT_EDGE | \
+                                    GPIO_INT_HIGH_1)
+  #define GPIO_INT_EDGE_FALLING    (GPIO_INT_ENABLE | GPIO_INT_EDGE | \
+                                    GPIO_INT_LOW_0)
+  #define GPIO_INT_EDGE_BOTH       (GPIO_INT_ENABLE | GPIO_INT_EDGE | \
+                                    GPIO_INT_LOW_0 | GPIO_INT_HIGH_1)
+  #define GPIO_INT_EDGE_TO_ACTIVE  (GPIO_INT_EDGE_RISING | \
+                                    GPIO_INT_LEVELS_LOGICAL)
+  #define GPIO_INT_EDGE_TO_INACTIVE (GPIO_INT_EDGE_FALLING | \
+                                    GPIO_INT_LEVELS_LOGICAL)
+
+//==============================================================================
+// devicetree pin spec
+//==============================================================================
+
+  struct gpio_dt_spec                  // GPIO pin from devicetree
+         {
+           const struct device *port;  // GPIO port
+           gpio_pin_t pin;             // pin number
+           gpio_dt_flags_t dt_flags;   // devicetree flags
+         };
+
+  extern const struct device __device_gpio_0;   // THE emulated GPIO port
+
+  #define GPIO_DT_SPEC_GET_OR(node,prop,default)                            \
+          { .port = &__device_gpio_0, .pin = DT_GPIO_PIN(node,prop),        \
+            .dt_flags = DT_GPIO_FLAGS(node,prop) }
+
+  #define GPIO_DT_SPEC_GET(node,prop)  GPIO_DT_SPEC_GET_OR(node,prop,{0})
+
+//==============================================================================
+// interrupt callbacks
+//==============================================================================
+
+  struct gpio_callback;
+  typedef void (*gpio_callback_handler_t)(const struct device *port,
+                                          struct gpio_callback *cb,
+                                          gpio_port_pins_t pins);
+
+  struct gpio_callback                 // callback context
+         {
+           struct gpio_callback *next; // next callback of port
+           gpio_callback_handler_t handler;   // callback handler (ISR)
+           gpio_port_pins_t pin_mask;  // pins the handler is interested in
+         };
+
+  static inline void gpio_init_callback(struct gpio_callback *cb,
+                                        gpio_callback_handler_t handler,
+                                        gpio_port_pins_t pin_mask)
+  {
+    cb->next = NULL;
+    cb->handler = handler;
+    cb->pin_mask = pin_mask;
+  }
+
+  int gpio_add_callback(const struct device *port, struct gpio_callback *cb);
+  int gpio_remove_callback(const struct device *port, struct gpio_callback *cb);
+
+//==============================================================================
+// pin & port API (return 0 or negative error, get functions return level)
+//==============================================================================
+
+  int gpio_pin_configure(const struct device *port, gpio_pin_t pin,
+                         gpio_flags_t flags);
+  int gpio_pin_interrupt_configure(const struct device *port, gpio_pin_t pin,
+                                   gpio_flags_t flags);
+
+  int gpio_pin_get(const struct device *port, gpio_pin_t pin);   // logical
+  int gpio_pin_set(const struct device *port, gpio_pin_t pin, int value);
+  int gpio_pin_get_raw(const struct device *port, gpio_pin_t pin);
+  int gpio_pin_set_raw(const struct device *port, gpio_pin_t pin, int value);
+  int gpio_pin_toggle(const struct device *port, gpio_pin_t pin);
+
+  int gpio_port_get_raw(const struct device *port, gpio_port_value_t *value);
+  int gpio_port_set_masked_raw(const struct device *port,
+                               gpio_port_pins_t mask, gpio_port_value_t value);
+
+//==============================================================================
+// devicetree pin spec helpers
+//==============================================================================
+
+  static inline int gpio_pin_configure_dt(const struct gpio_dt_spec *spec,
+                                          gpio_flags_t extra_flags)
+  {
+    return gpio_pin_configure(spec->port,spec->pin,
+                              spec->dt_flags | extra_flags);
+  }
+
+  static inline int gpio_pin_interrupt_configure_dt(
+                      const struct gpio_dt_spec *spec, gpio_flags_t flags)
+  {
+    return gpio_pin_interrupt_configure(spec->port,spec->pin,flags);
+  }
+
+  static inline int gpio_pin_get_dt(const struct gpio_dt_spec *spec)
+  {
+    return gpio_pin_get(spec->port,spec->pin);
+  }
+
+  static inline int gpio_pin_set_dt(const struct gpio_dt_spec *spec, int value)
+  {
+    return gpio_pin_set(spec->port,spec->pin,value);
+  }
+
+#endif // __HOST_DRIVERS_GPIO_H__
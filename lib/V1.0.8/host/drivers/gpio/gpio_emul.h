@@ -0,0 +1,63 @@
+//==============================================================================
+//  drivers/gpio/gpio_emul.h
+//  host (POSIX) GPIO emulator back door (in the style of Zephyr's gpio_emul)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Test code drives input pins of the emulated port and reads back output
+// pins. Alternatively the emulator is controlled by environment variables:
+//
+//   BL_GPIO_SCRIPT=<file>   play back a time stamped input script
+//   BL_GPIO_TRACE=<file>    record a waveform trace (VCD) of the board pins
+//
+// Input script: one edge per line '<ms> <pin> <level>', where <ms> is the
+// uptime in ms (or '+<ms>' relative to the previous line), <pin> is a board
+// alias (sw0..sw3, led0..led3) or a pin number and <level> the logical level
+// (1: button pressed); '#' starts a comment:
+//
+//   # click sw0 (with contact bounce), then hold sw1 for 1s
+//     500  sw0  1
+//     +1   sw0  0
+//     +1   sw0  1
+//     620  sw0  0
+//     2000 sw1  1
+//     +1000 sw1 0
+//
+// The script is played back by a kernel timer (deterministic in virtual
+// time, BL_VIRTUAL). The trace is a value change dump (1 us resolution) of
+// the sw and led pins which can be viewed with gtkwave. Every output edge
+// which follows an input edge is annotated with its latency, and a latency
+// summary (count, min/avg/max) is printed at exit.
+//
+//==============================================================================
+
+#ifndef __HOST_DRIVERS_GPIO_GPIO_EMUL_H__
+#define __HOST_DRIVERS_GPIO_GPIO_EMUL_H__
+
+  #include "drivers/gpio.h"
+
+//==============================================================================
+// drive input pin (logical level), calls interrupt callbacks on edges
+// - usage: gpio_emul_input_set(&__device_gpio_0,11,1)  // press sw0
+//==============================================================================
+
+  int gpio_emul_input_set(const struct device *port, gpio_pin_t pin,
+                          int value);
+
+//==============================================================================
+// read back output pin (logical level)
+// - usage: on = gpio_emul_output_get(&__device_gpio_0,13)   // led0
+//==============================================================================
+
+  int gpio_emul_output_get(const struct device *port, gpio_pin_t pin);
+
+//==============================================================================
+// start input script / waveform trace (instead of environment variables)
+// - usage: bl_host_gpio_script("click.gpio");  bl_host_gpio_trace("led.vcd")
+//==============================================================================
+
+  int bl_host_gpio_script(const char *path);    // 0: OK, -1: file error
+  int bl_host_gpio_trace(const char *path);     // 0: OK, -1: file error
+
+#endif // __HOST_DRIVERS_GPIO_GPIO_EMUL_H__
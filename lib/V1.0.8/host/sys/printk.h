@@ -0,0 +1,13 @@
+//==============================================================================
+//  sys/printk.h
+//  host (POSIX) shim of the Zephyr printk header
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+#ifndef __HOST_SYS_PRINTK_H__
+#define __HOST_SYS_PRINTK_H__
+
+  #include "bl_host.h"                 // printk() of the host port layer
+
+#endif // __HOST_SYS_PRINTK_H__
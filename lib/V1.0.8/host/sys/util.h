@@ -0,0 +1,21 @@
+//==============================================================================
+//  sys/util.h
+//  host (POSIX) shim of the Zephyr utility header (just what drivers need)
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+#ifndef __HOST_SYS_UTIL_H__
+#define __HOST_SYS_UTIL_H__
+
+  #include <stdint.h>
+
+  #ifndef BIT
+    #define BIT(n)           (1UL << (n))
+  #endif
+
+  #ifndef ARRAY_SIZE
+    #define ARRAY_SIZE(a)    (sizeof(a) / sizeof((a)[0]))
+  #endif
+
+#endif // __HOST_SYS_UTIL_H__
@@ -0,0 +1,18 @@
+//==============================================================================
+//  zephyr.h
+//  host (POSIX) shim of the Zephyr kernel header
+//
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+//
+// Zephyr drivers (e.g. via bl_gpio.h) include <zephyr.h>. On the host the
+// kernel subset is provided by the host port layer (bl_host.h).
+//
+//==============================================================================
+
+#ifndef __HOST_ZEPHYR_H__
+#define __HOST_ZEPHYR_H__
+
+  #include "bl_host.h"
+
+#endif // __HOST_ZEPHYR_H__
@@ -39,6 +39,28 @@
     #define CFG_MPUB_INTERVAL      20  // 20 ms repeat interval by default
   #endif
 
+    // queue backend
+    // - CFG_MPUB_WHEEL 0: array queue, linear scan for alloc and on every tick
+    // - CFG_MPUB_WHEEL 1: hashed timing wheel with free-list allocator, O(1)
+    //   alloc/insert, a tick only visits the slots which elapsed
+
+  #ifndef CFG_MPUB_WHEEL
+    #define CFG_MPUB_WHEEL          0  // array queue by default
+  #endif
+
+  #ifndef CFG_MPUB_WHEEL_SLOTS
+    #define CFG_MPUB_WHEEL_SLOTS   64  // number of wheel slots (power of 2)
+  #endif
+
+  #ifndef CFG_MPUB_WHEEL_MS
+    #define CFG_MPUB_WHEEL_MS       5  // time span of a wheel slot (ms)
+  #endif
+
+  #if (CFG_MPUB_WHEEL_SLOTS > 64 || \
+       (CFG_MPUB_WHEEL_SLOTS & (CFG_MPUB_WHEEL_SLOTS-1)))
+    #error "CFG_MPUB_WHEEL_SLOTS must be a power of 2 (max 64)"
+  #endif
+
 //==============================================================================
 // locals
 //==============================================================================
@@ -63,10 +85,213 @@
     int val;                           // copy of value
     MQ_data data;                      // message queue data
     volatile BL_ms due;                // due (dispatch) time
+  #if (CFG_MPUB_WHEEL)
+    struct MQ_entry *next;             // next entry in slot list or free list
+  #endif
   } MQ_entry;
 
 //==============================================================================
-// message queue
+// helper: copy message data and due time to a queue entry
+//==============================================================================
+
+  static void fill(MQ_entry *q, BL_ob *o, int val, BL_ms due)
+  {
+    q->o.cl = o->cl;                   // copy message interface class
+    q->o.op = o->op;                   // copy opcode
+    q->o.id = o->id;                   // copy @id
+    q->o.data = &q->data;              // set <data> equal to NULL
+
+    q->val = val;                      // copy value
+    q->due = due;                      // set due time (for being published)
+  }
+
+//==============================================================================
+// timing wheel (CFG_MPUB_WHEEL)
+// - an entry is linked into slot (due/CFG_MPUB_WHEEL_MS) % SLOTS, entries due
+//   in later wheel rounds share the slot and are skipped until they are due
+// - each slot keeps its earliest due time, so a tick skips slots (and a
+//   tick with nothing due returns) without walking any slot list
+// - free entries are kept in a free list (pool)
+// - a bitmap of non-empty slots finds the next due slot for bl_wake()
+//==============================================================================
+#if (CFG_MPUB_WHEEL)
+
+  #define MQ_LEN   CFG_MPUB_QUEUE_LENGTH
+  #define SLOTS    CFG_MPUB_WHEEL_SLOTS
+  #define SLOT(t)  ((t) / CFG_MPUB_WHEEL_MS)   // absolute slot number
+  #define BIT(i)   ((uint64_t)1 << (i))
+  #define LATE     ((BL_ms)0x7FFFFFFFFFFFFFFF)  // later than any due time
+
+  static MQ_entry queue[MQ_LEN];
+
+  static MQ_entry *pool = NULL;        // free list
+  static MQ_entry *head[SLOTS];        // slot lists (FIFO)
+  static MQ_entry *tail[SLOTS];
+  static BL_ms early[SLOTS];           // earliest due time of slot entries
+  static uint64_t busy = 0;            // bitmap of non-empty slots
+  static BL_ms cursor = 0;             // absolute number of oldest slot
+
+//==============================================================================
+// helper: init message queue
+//==============================================================================
+
+  static void init_queue(void)
+  {
+    pool = NULL;
+    for (int i=BL_LEN(queue)-1; i >= 0; i--)
+    {
+      queue[i].due = 0;
+      queue[i].next = pool;            // push to free list
+      pool = queue + i;
+    }
+
+    for (int i=0; i < SLOTS; i++)
+      head[i] = tail[i] = NULL;
+
+    busy = 0;
+    cursor = SLOT(bl_ms());
+  }
+
+//==============================================================================
+// helper: append queue entry to the slot list of its due time
+//==============================================================================
+
+  static void link(MQ_entry *q)
+  {
+    BL_ms s = SLOT(q->due);
+    int i = (int)((s < cursor ? cursor : s) & (SLOTS-1));  // past due: oldest
+
+    q->next = NULL;
+    if (tail[i])
+      tail[i]->next = q;
+    else
+      head[i] = q;
+    tail[i] = q;
+
+    if ( !(busy & BIT(i)) || q->due < early[i] )
+      early[i] = q->due;
+    busy |= BIT(i);
+  }
+
+//==============================================================================
+// helper: allocate a free queue entry (return NULL if no entries free)
+// - usage: q = alloc(o,val,due)  // copy data of o,val and due to entry
+//==============================================================================
+
+  static MQ_entry *alloc(BL_ob *o, int val, BL_ms due)
+  {
+    MQ_entry *q = pool;
+    if (!q)
+      return NULL;                     // no more entries free
+
+    pool = q->next;                    // pop from free list
+    fill(q,o,val,due);                 // copy message data and due time
+    link(q);                           // schedule in wheel
+
+    scheduled++;                       // one more entry going to be scheduled
+    return q;                          // return pointer to queue entry
+  }
+
+//==============================================================================
+// helper: release (free-up) queue entry
+// - usage: release(q)
+//==============================================================================
+
+  static void release(MQ_entry *q)
+  {
+    scheduled--;
+    q->due = 0;                        // mark as free
+    q->next = pool;                    // push to free list
+    pool = q;
+  }
+
+//==============================================================================
+// helper: earliest due time of pending entries (return 0 if none)
+// - returns the earliest due time of the next non-empty slot, or the end of
+//   that slot if it only holds entries of later wheel rounds
+//==============================================================================
+
+  static BL_ms next_due(void)
+  {
+    if (!busy)
+      return 0;
+
+    int c = (int)(cursor & (SLOTS-1));
+    uint64_t mask = (SLOTS == 64) ? ~(uint64_t)0 : BIT(SLOTS % 64) - 1;
+    uint64_t rot = c ? ((busy >> c) | (busy << ((SLOTS-c) % 64))) & mask : busy;
+
+    BL_ms s = cursor + __builtin_ctzll(rot);   // next non-empty slot
+    BL_ms end = (s+1) * CFG_MPUB_WHEEL_MS;     // end of this slot
+    BL_ms next = early[s & (SLOTS-1)];
+
+    return (next < end) ? next : end;
+  }
+
+//==============================================================================
+// worker: system tick (visit elapsed slots only)
+//==============================================================================
+
+  static int sys_tick(BL_ob *o, int val)
+  {
+    if (scheduled > 0)                 // in case of scheduled messages
+    {
+      BL_ms now = bl_ms();
+      BL_ms last = SLOT(now);
+
+      for (BL_ms s = cursor; s <= last && s < cursor + SLOTS; s++)
+      {
+        int i = (int)(s & (SLOTS-1));
+        if ( !(busy & BIT(i)) || now < early[i] )
+          continue;                    // empty slot or nothing due yet
+
+        MQ_entry *prev = NULL;         // predecessor of q in slot list
+        early[i] = LATE;               // recalculated by walk and link()
+
+        for (MQ_entry *q = head[i]; q; )
+        {
+          MQ_entry *next = q->next;
+
+          if (now < q->due)            // later in slot or later wheel round
+          {
+            if (q->due < early[i])
+              early[i] = q->due;
+            prev = q;
+            q = next;
+            continue;
+          }
+
+            // unlink before posting, since _bl_out() might schedule new
+            // entries (appended to a slot list, picked up at the latest
+            // with the next tick)
+
+          if (prev)
+            prev->next = next;
+          else
+            head[i] = next;
+          if (tail[i] == q)
+            tail[i] = prev;
+
+          _bl_out(&q->o,q->val,(PMI)); // post scheduled message
+          release(q);                  // release (free-up) queue entry
+          q = next;
+        }
+
+        if (!head[i])
+          busy &= ~BIT(i);             // slot got empty
+      }
+
+      cursor = last;                   // current slot might get more due
+
+      if (scheduled > 0)
+        bl_wake(next_due());           // tickless: tick for next due message
+    }
+
+    return 0;
+  }
+
+#else // CFG_MPUB_WHEEL
+//==============================================================================
+// message queue (array)
 // - entry i is free iff queue[i].due == 0
 //==============================================================================
 
@@ -97,14 +322,7 @@
 
       if (q->due == 0)
       {
-        q->o.cl = o->cl;               // copy message interface class
-        q->o.op = o->op;               // copy opcode
-        q->o.id = o->id;               // copy @id
-        q->o.data = &q->data;          // set <data> equal to NULL
-
-        q->val = val;                  // copy value
-        q->due = due;                  // set due time (for being published)
-
+        fill(q,o,val,due);             // copy message data and due time
         scheduled++;                   // one more entry going to be scheduled
         return q;                      // return pointer to queue entry
       }
@@ -123,12 +341,47 @@
     q->due = 0;                        // release queue entry (mark as free)
   }
 
+//==============================================================================
+// worker: system tick (scan all queue entries)
+//==============================================================================
+
+  static int sys_tick(BL_ob *o, int val)
+  {
+    if (scheduled > 0)                 // in case of scheduled messages
+    {
+      BL_ms now = bl_ms();
+      BL_ms next = 0;                  // earliest due time of pending entries
+
+//    LOG(1,BL_Y"sys_tick: %d entries scheduled",scheduled);
+
+      for (int i=0; i < BL_LEN(queue); i++)
+      {
+        MQ_entry *q = queue + i;       // next message queue entry
+
+        if (q->due && now >= q->due)
+        {
+          _bl_out(&q->o,q->val,(PMI)); // post scheduled message
+          release(q);                  // release (free-up) queue entry
+        }
+        else if (q->due && (next == 0 || q->due < next))
+          next = q->due;
+      }
+
+      if (next)
+        bl_wake(next);                 // tickless: tick for next due message
+    }
+
+    return 0;
+  }
+
+#endif // CFG_MPUB_WHEEL
 //==============================================================================
 // worker: schedule generic on/off SET/LET/GET messages
 //==============================================================================
 
   static int goocli_any(BL_ob *o, int val)
   {
+    LOGO(2,"(#)",o,val);
     BL_ms now = bl_ms();
     BL_goo *g = bl_data(o);
 
@@ -171,48 +424,72 @@
           s->tid,s->tt,s->delay, (int)due);
     }
 
+    bl_wake(now);                      // tickless: tick for first message
     return 0;
   }
 
 //==============================================================================
-// worker: system tick
+// worker: system init
 //==============================================================================
 
-  static int sys_tick(BL_ob *o, int val)
+  static int sys_init(BL_ob *o, int val)
   {
-    if (scheduled > 0)                 // in case of scheduled messages
-    {
-      BL_ms now = bl_ms();
-
-//    LOG(1,BL_Y"sys_tick: %d entries scheduled",scheduled);
-
-      for (int i=0; i < BL_LEN(queue); i++)
-      {
-        MQ_entry *q = queue + i;       // next message queue entry
-
-        if (q->due && now >= q->due)
-        {
-          _bl_out(&q->o,q->val,(PMI)); // post scheduled message
-          release(q);                  // release (free-up) queue entry
-        }
-      }
-    }
+    LOG(2,BL_B "init mpub");
 
+    init_queue();
     return 0;
   }
 
 //==============================================================================
-// worker: system init
+// workers: output to down gear, config repeats & interval
 //==============================================================================
 
-  static int sys_init(BL_ob *o, int val)
+  static int out_down(BL_ob *o, int val)
   {
-    LOG(2,BL_B "init mpub");
+    static BL_oval D = bl_down;        // down gear shorthand
+    return bl_out(o,val,(D));          // output to down gear
+  }
 
-    init_queue();
+  static int set_repeat(BL_ob *o, int val)
+  {
+    repeat = val;
     return 0;
   }
 
+  static int set_interval(BL_ob *o, int val)
+  {
+    interval = val;
+    return 0;
+  }
+
+//==============================================================================
+// dispatch table
+//==============================================================================
+
+  BL_OPS(mpub_sys,_SYS,
+    BL_ON(SYS_INIT_0_cb_0,             sys_init),
+    BL_ON(SYS_TICK_id_BL_pace_cnt,     sys_tick));
+
+  BL_OPS(mpub_goocli,_GOOCLI,
+    BL_ON(GOOCLI_SET_id_BL_goo_onoff,  goocli_any),
+    BL_ON(GOOCLI_LET_id_BL_goo_onoff,  goocli_any),
+    BL_ON(GOOCLI_GET_id_0_0,           goocli_any));
+
+  BL_OPS(mpub_aug_goocli,BL_AUG(_GOOCLI),
+    BL_ON(_GOOCLI_SET_id_BL_goo_onoff, out_down),
+    BL_ON(_GOOCLI_LET_id_BL_goo_onoff, out_down),
+    BL_ON(_GOOCLI_GET_id_0_0,          out_down));
+
+  BL_OPS(mpub_set,_SET,
+    BL_ON(SET_REPEAT_0_0_cnt,          set_repeat),
+    BL_ON(SET_INTERVAL_0_0_ms,         set_interval));
+
+  BL_DISPATCH(bl_mpub_ifc,
+    BL_ROW(mpub_sys),
+    BL_ROW(mpub_goocli),
+    BL_ROW(mpub_aug_goocli),
+    BL_ROW(mpub_set));
+
 //==============================================================================
 // public module interface
 //==============================================================================
@@ -245,36 +522,5 @@
 
   int bl_mpub(BL_ob *o, int val)
   {
-    static BL_oval D = bl_down;        // down gear shorthand
-
-    switch (bl_id(o))
-    {
-      case SYS_INIT_0_cb_0:
-        return sys_init(o,val);        // delegate to sys_init() worker
-
-      case SYS_TICK_id_BL_pace_cnt:
-        return sys_tick(o,val);        // delegate to sys_tick() worker
-
-      case GOOCLI_SET_id_BL_goo_onoff:
-      case GOOCLI_LET_id_BL_goo_onoff:
-      case GOOCLI_GET_id_0_0:
-        LOGO(2,"(#)",o,val);
-        return goocli_any(o,val);      // delegate to gonoff_any() worker
-
-      case _GOOCLI_SET_id_BL_goo_onoff:
-      case _GOOCLI_LET_id_BL_goo_onoff:
-      case _GOOCLI_GET_id_0_0:
-        return bl_out(o,val,(D));      // output to down gear
-
-      case SET_REPEAT_0_0_cnt:
-        repeat = val;
-        return 0;
-
-      case SET_INTERVAL_0_0_ms:
-        interval = val;
-        return 0;
-
-      default:
-        return -1;                     // bad input
-    }
+    return bl_dispatch(&bl_mpub_ifc,o,val);  // -1: bad input
   }
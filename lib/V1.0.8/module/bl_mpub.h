@@ -18,8 +18,8 @@
   #endif
 
   #if (CFG_LOG_MPUB)
-    #define LOG_MPUB(l,f,...)    BL_LOG(CFG_LOG_MPUB-1+l,f,##__VA_ARGS__)
-    #define LOGO_MPUB(l,f,o,v)   bl_logo(CFG_LOG_MPUB-1+l,f,o,v)
+    #define LOG_MPUB(l,f,...)    BL_LOGA(BL_AREA_MPUB,CFG_LOG_MPUB-1+l,f,##__VA_ARGS__)
+    #define LOGO_MPUB(l,f,o,v)   BL_LOGO(BL_AREA_MPUB,CFG_LOG_MPUB-1+l,f,o,v)
   #else
     #define LOG_MPUB(l,f,...)    {}     // empty
     #define LOGO_MPUB(l,f,o,v)   {}     // empty
@@ -43,5 +43,6 @@
 //==============================================================================
 
   int bl_mpub(BL_ob *o, int val);
+  extern const BL_dispatch bl_mpub_ifc;     // dispatch table (introspection)
 
 #endif // __BL_MPUB_H__
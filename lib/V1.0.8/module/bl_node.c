@@ -28,19 +28,50 @@
 //==============================================================================
 
   static inline int led(int id,int val) { return _bl_led(id,val,(PMI)); }
-  static int rgb(int onf) { led(2,onf); led(3,onf); led(4,onf); return 0; }
+  static inline int rgb(int onf)       // onf: 0:off, 1:on, -1:toggle
+  {
+    return _bl_leds(BL_RGB,onf<0 ? -1 : onf ? BL_RGB : 0,(PMI));
+  }
+
+  static inline int seq(int id,const BL_seq *p)
+                                        { return _bl_ledseq(id,p,(PMI)); }
   static inline int get(BL_op op)       { return _bl_get(op,(PMI)); }
 
 //==============================================================================
 // defines (timing)
 //==============================================================================
 
-  #define T_TICK      10               // 10 ms ticks
   #define T_ATT      750               // 750 ms attention blink period
   #define T_PRV     2000               // 2000 ms provisioned blink period
   #define T_UNP      350               // 350 ms unprovisioned blink period
+  #define T_DUTY     100               // 100 ms status LED on time
+  #define T_BLINK   1000               // 1000 ms startup blink period
   #define T_STARTUP 5000               // 5000 ms startup reset interval
 
+//==============================================================================
+// blink patterns (LED pattern sequencer, see bl_seq.h)
+//==============================================================================
+
+  static const BL_seq blink_att[] =    // attention blinking
+         {
+           BL_SEQ_ON(T_ATT), BL_SEQ_OFF(T_ATT), BL_SEQ_AGAIN,
+         };
+
+  static const BL_seq blink_prv[] =    // provisioned status LED blinking
+         {
+           BL_SEQ_ON(T_DUTY), BL_SEQ_OFF(T_PRV-T_DUTY), BL_SEQ_AGAIN,
+         };
+
+  static const BL_seq blink_unp[] =    // unprovisioned status LED blinking
+         {
+           BL_SEQ_ON(T_DUTY), BL_SEQ_OFF(T_UNP-T_DUTY), BL_SEQ_AGAIN,
+         };
+
+  static const BL_seq blink_startup[] =   // startup LED mapping blinking
+         {
+           BL_SEQ_ON(T_BLINK/2), BL_SEQ_OFF(T_BLINK/2), BL_SEQ_AGAIN,
+         };
+
 //==============================================================================
 // locals
 //==============================================================================
@@ -55,7 +86,6 @@
 //                  +--------------------+
 //                  |        SYS:        | SYS: interface
 // (N)->     INIT ->|       <out>        | init module, store <out> callback
-// (N)->     TICK ->|       @id,cnt      | tick the module
 //                  +--------------------+
 //                  |        GET:        | GET:interface
 // (N)->     BUSY ->|                    | get startup busy status
@@ -91,9 +121,11 @@
         LOG(2,BL_R "[RESET:INC %d] -> count:%d",T_STARTUP,count);
 
         if (count <= 4)                     // <= 4 times resetted?
-          return led(map[count],1);         // indicate by turn on mapped LED
+          return seq(map[count],blink_startup);  // blink mapped LED
 
         LOG(1,BL_R "unprovision node");   // let us know
+        if (count < BL_LEN(map))
+          seq(map[count],NULL);           // stop blinking of LED @map
         count = 0;                        // clear counter
 
         led(1,1);                         // status LED on
@@ -102,16 +134,6 @@
         return _bl_post((S), RESET_PRV_0_0_0, 0,NULL,T_STARTUP);
       }
 
-      case SYS_TICK_id_BL_pace_cnt:         // receive [RESET<DUE] event
-        if (count>0 && count < BL_LEN(map)) // if startup in progress
-        {
-          if (bl_period(o,1000))
-            led(map[count],1);              // turn on LED @count+1
-          else if (bl_duty(o,500,1000))
-            led(map[count],0);              // turn off LED @count+1
-        }
-        return 0;                           // OK
-
       case BUTTON_HOLD_id_0_ms:             // button press during startup
         if ( !get(BUSY_) || !get(PRV_) || val || o->id != 1)
           return 0;                         // in this case ignore button hold
@@ -119,6 +141,8 @@
         if (count >= 4)
         {
           LOG(1,BL_R "unprovision node");   // let us know
+          if (count < BL_LEN(map))
+            seq(map[count],NULL);           // stop blinking of LED @map
           count = 0;                        // clear counter
 
           led(1,1);                         // status LED on
@@ -129,15 +153,22 @@
 
         if (count > 0)                      // if we are still in startup phase
         {
+          seq(map[count],NULL);             // stop blinking of LED @map
           led(map[count],0);                // turn off LED @map
           count = _bl_post((S), RESET_INC_0_0_ms, 0,NULL,T_STARTUP);
           LOG(2,BL_R "[RESET:INC %d] -> count:%d",T_STARTUP,count);
+          if (count < BL_LEN(map))
+            seq(map[count],blink_startup);  // blink next mapped LED
         }
         return 0;                           // OK
 
       case RESET_DUE_0_0_0:
         LOG(2,BL_B"clear reset counter");   // let us know
-        led(map[count],0);                  // turn off LED @count+1
+        if (count > 0 && count < BL_LEN(map))
+        {
+          seq(map[count],NULL);             // stop blinking of LED @map
+          led(map[count],0);                // turn off LED @map
+        }
         count = 0;                          // deactivate startup.busy state
         return 0;                           // OK
 
@@ -161,36 +192,27 @@
 //                  +--------------------+
 //                  |        SYS:        | SYS interface
 // (N)->     INIT ->|       <out>        | init module, store <out> callback
-// (N)->     TICK ->|       @id,cnt      | tick the module
 //                  +--------------------+
 //                  |        MESH:       | MESH interface
-// (N)->      ATT ->|        sts         | receive & store attention status
+// (N)->      ATT ->|        sts         | start/stop attention blinking
 //                  +--------------------+
 //
 //==============================================================================
 
   static int attention(BL_ob *o, int val)   // public attention interface
   {
-    static volatile bool att;               // attention state
+    static const int8_t leds[] = {0,2,3,4}; // status LED and RGB LEDs
 
     switch (bl_id(o))
     {
       case SYS_INIT_0_cb_0:                 // [SYS:INIT @id <cb>]
         return 0;                           // OK (nothing to init)
 
-      case SYS_TICK_id_BL_pace_cnt:
-        if (att && bl_period(o,T_ATT))      // attention state/period?
-        {
-LOG(2,BL_G "toggle");
-          rgb(-1);                          // toggle all RGB LEDs
-          led(0,-1);                        // toggle status LED @0
-        }
-        return 0;
-
       case BL_ID(_MESH,ATT_):
-        att = val;                          // store attention state
-        bl_led(0,0);                        // turn status LED off
-        rgb(0);                             // turn all RGB LEDs off
+        for (int i=0; i < BL_LEN(leds); i++)      // started in lock step
+          seq(leds[i],val ? blink_att : NULL);    // start/stop blinking
+        if (!val)
+          _bl_leds(BL_RGB|BL_LED(0),0,(PMI));     // status & RGB LEDs off
         return 0;
 
       default:
@@ -208,10 +230,16 @@ LOG(2,BL_G "toggle");
 //                  +--------------------+
 //                  |        SYS:        | SYS interface
 // (N)->     INIT ->|       <out>        | init module, store <out> callback
-// (N)->     TICK ->|       @id,cnt      | tick the module
 //                  +--------------------+
 //                  |        MESH:       | MESH interface
 // (N)->      PRV ->|       onoff        | receive and store provision status
+// (N)->      ATT ->|        sts         | attention changed (update blinking)
+//                  +--------------------+
+//                  |       RESET:       | RESET interface
+// (N)->      DUE ->|                    | startup done (update blinking)
+//                  +--------------------+
+//                  |       BUTTON:      | BUTTON interface
+// (N)->     HOLD ->|       @id,ms       | startup changed (update blinking)
 //                  +--------------------+
 //
 //==============================================================================
@@ -219,36 +247,47 @@ LOG(2,BL_G "toggle");
   static int provision(BL_ob *o, int val)   // public provision interface
   {
     static volatile bool state = 0;         // provision state
+    static const BL_seq *blink = NULL;      // current status LED pattern
 
     switch (bl_id(o))
     {
       case BL_ID(_SYS,INIT_):               // [SYS:INIT @id <cb>]
-        return 0;                           // OK (nothing to init)
-
-      case BL_ID(_SYS,TICK_):               // [SYS:TICK @id <val>]
-      {
-        if ( !get(ATT_) && !get(BUSY_) )
-        {
-	        int ms = (state ? T_PRV:T_UNP);   // 2000 ms versus 350 ms period
-	        int duty = 100;
-
-	        if (bl_period(o,ms))
-	          led(0,1);                       // status LED @0 on
-	        else if (bl_duty(o,duty,ms))
-	          led(0,0);                       // status LED @0 off
-        }
-        return 0;
-      }
+        break;                              // select status LED blinking
 
       case BL_ID(_MESH,PRV_):               // [MESH:PRV stat] change prov state
         state = val;                        // store provision state
+        blink = NULL;                       // restart status LED blinking
         bl_led(0,0);                        // turn status LED @1 off
         bl_led(id,0);                       // turn current LED @id off
-        return 0;
+        break;
+
+      case BL_ID(_MESH,ATT_):               // attention owns status LED
+        blink = NULL;                       // (restart blinking afterwards)
+        break;
+
+      case BL_ID(_RESET,DUE_):              // startup has finished
+      case BL_ID(_BUTTON,HOLD_):            // startup may have finished
+        break;
 
       default:
         return -1;                          // bad args
     }
+
+      // status LED blinks with 2000 ms (provisioned) or 350 ms period, unless
+      // attention blinking or startup sequence is in progress
+
+    const BL_seq *p = (state ? blink_prv : blink_unp);
+    if (get(ATT_))
+      return 0;                             // status LED is blinking anyway
+    if (get(BUSY_))
+      p = NULL;                             // no blinking during startup
+
+    if (p != blink)                         // only on change of pattern
+    {
+      blink = p;
+      seq(0,p);                             // start/stop status LED blinking
+    }
+    return 0;
   }
 
 //==============================================================================
@@ -262,7 +301,7 @@ LOG(2,BL_G "toggle");
 //                  +--------------------+
 //                  |        SYS:        | SYS interface
 // (T)->     INIT ->|       <out>        | init module, store <out> callback
-// (T)->     TICK ->|       @id,cnt      | tick the module
+// (T)->     TICK ->|       @id,cnt      | ignored (blinking by bl_seq)
 //                  +--------------------+
 //                  |        GET:        | GET input interface
 // (D)->      PRV ->|                    | get provision status
@@ -281,7 +320,10 @@ LOG(2,BL_G "toggle");
 // (T)->     HOLD ->|       @id,ms       | receive button hold messages
 //                  +--------------------+
 //                  |        #LED:       | LED output interface
-// (D)<-      SET <-|     @id,onoff      |
+// (D)<-      SET <-|     @id,onoff      | set LED @id on/off
+// (D)<-   TOGGLE <-|        @id         | toggle LED @id
+// (D)<-     MASK <-|     @mask,bits     | set several LEDs at once
+// (D)<-      SEQ <-|  @id,<BL_seq>,0    | start/stop blink pattern of LED @id
 //                  +--------------------+
 //                  |       RESET:       | RESET interface
 // (T)->      DUE ->|                    | reset counter is due
@@ -309,17 +351,20 @@ LOG(2,BL_G "toggle");
     switch (bl_id(o))                  // dispatch message ID
     {
       case BL_ID(_SYS,INIT_):          // [SYS:INIT state] - init system command
-      case BL_ID(_SYS,TICK_):          // [SYS:TICK @id,cnt] - tick module
         bl_fwd(o,val,(S));             // forward to startup() worker
         bl_fwd(o,val,(P));             // forward to provision() worker
         bl_fwd(o,val,(A));             // forward to attention() worker
         return 0;                      // OK
 
+      case BL_ID(_SYS,TICK_):          // [SYS:TICK @id,cnt] - tick module
+        return 0;                      // no ticks needed (bl_seq blinks LEDs)
+
       case BL_ID(_MESH,ATT_):          // [MESH,ATT sts] change attention state
         att = (val != 0);
         bl_decorate(att,prv);
         LOG(2,BL_G "bl_node: attention %s",val?"on":"off");
-        return bl_fwd(o,val,(A));      // set attention blinking on/off
+        bl_fwd(o,val,(A));             // set attention blinking on/off
+        return bl_fwd(o,val,(P));      // update status LED blinking
 
       case BL_ID(_MESH,PRV_):          // [MESH:PRV sts]
         prv = (val != 0);
@@ -342,6 +387,8 @@ LOG(2,BL_G "toggle");
         return prv;                    // return provision state
 
       case BL_ID(_BUTTON,HOLD_):       // button press increment reset counter
+        if (val)                       // hold repeat or release: ignore
+          return 0;
         LOGO(1,"@",o,val);
         if ( !_bl_get(PRV_,(PMI)) )    // if not provisioned
         {
@@ -350,14 +397,18 @@ LOG(2,BL_G "toggle");
           _bl_led(4,0,(PMI));          // turn off LED @4
           id = (id==0) ? 2 : (id+1)%5; // update THE LED id (=> 0 or 2,3,4)
         }
-        return bl_fwd(o,val,(S));      // fwd [BUTTON:HOLD] to startup
+        bl_fwd(o,val,(S));             // fwd [BUTTON:HOLD] to startup
+        return bl_fwd(o,val,(P));      // update status LED blinking
 
       case _BL_ID(_LED,SET_):
       case _BL_ID(_LED,TOGGLE_):
+      case _BL_ID(_LED,MASK_):
+      case _BL_ID(_LED,SEQ_):
         return bl_out(o,val,(D));
 
       case BL_ID(_RESET,DUE_):         // [RESET:DUE] - reset counter due
-        return bl_fwd(o,val,(S));      // forward to startup module
+        bl_fwd(o,val,(S));             // forward to startup module
+        return bl_fwd(o,val,(P));      // update status LED blinking
 
       case _RESET_INC_0_0_ms:
       case _RESET_PRV_0_0_0:
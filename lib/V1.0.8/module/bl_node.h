@@ -18,8 +18,8 @@
 #endif
 
 #if (CFG_LOG_NODE)
-    #define LOG_NODE(l,f,...)    BL_LOG(CFG_LOG_NODE-1+l,f,##__VA_ARGS__)
-    #define LOGO_NODE(l,f,o,v)   bl_logo(CFG_LOG_NODE-1+l,f,o,v)
+    #define LOG_NODE(l,f,...)    BL_LOGA(BL_AREA_NODE,CFG_LOG_NODE-1+l,f,##__VA_ARGS__)
+    #define LOGO_NODE(l,f,o,v)   BL_LOGO(BL_AREA_NODE,CFG_LOG_NODE-1+l,f,o,v)
 #else
     #define LOG_NODE(l,f,...)    {}     // empty
     #define LOGO_NODE(l,f,o,v)   {}     // empty
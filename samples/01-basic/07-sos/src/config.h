@@ -1,20 +0,0 @@
-//==============================================================================
-// config.h for 04-meshnode demo
-//==============================================================================
-
-#ifndef __CONFIG_H__
-#define __CONFIG_H__
-
-//==============================================================================
-// Bluccino Core Migration
-//==============================================================================
-
-  #define MIGRATION_STEP1         1    // introduce bl_core()
-  #define MIGRATION_STEP2         1    // provisioning and attention
-  #define MIGRATION_STEP3         1    // provisioning and attention
-
-//==============================================================================
-//
-//==============================================================================
-
-#endif